@@ -29,6 +29,7 @@ std::unique_ptr<ExampleLayer> ExampleLayer::Create(core::Application* app) {
         app->GetTextureManager(),
         app->GetMaterialManager(),
         app->GetMeshManager(),
+        app->GetJobSystem(),
     };
 
     loader::ShaderLoader shaderLoader{
@@ -36,25 +37,29 @@ std::unique_ptr<ExampleLayer> ExampleLayer::Create(core::Application* app) {
     };
 
     return std::unique_ptr<ExampleLayer>(
-        new ExampleLayer(app, device, gameCamera, loader, shaderLoader));
+        new ExampleLayer(app, device, gameCamera, std::move(loader), shaderLoader));
 }
 
 void ExampleLayer::OnAttach(core::Scene& scene) {
     auto shaderHandle = m_shaderLoader.LoadShader("assets/ForwardPass.shdr");
     auto shaderHandle1 = m_shaderLoader.LoadShader("assets/DeferredGBufferPass.shdr");
     auto shaderHandle0 = m_shaderLoader.LoadShader("assets/DeferredLightingPass.shdr");
-    auto modelOrError = m_loader.LoadModel("resources/microphone/scene.gltf");
-    if (!modelOrError.has_value()) {
-        std::println("failed to load");
-    }
-
-    m_modelHandle = modelOrError.value();
-    core::AssetView<core::render::Model> model = m_app->GetAssetManager()->GetModel(m_modelHandle);
-
-    scene.AddModel(model, glm::mat4x4(1.F));
+    // The scene renders without the model until it has been uploaded.
+    m_loader.LoadModelAsync("resources/microphone/scene.gltf",
+                            [this, &scene](const loader::ModelResult& modelOrError) {
+                                if (!modelOrError.has_value()) {
+                                    std::println("failed to load");
+                                    return;
+                                }
+                                m_modelHandle = modelOrError.value();
+                                core::AssetView<core::render::Model> model =
+                                    m_app->GetAssetManager()->GetModel(m_modelHandle);
+                                scene.AddModel(model, glm::mat4x4(1.F));
+                            });
 }
 
 void ExampleLayer::OnUpdate(core::Scene& scene) {
+    m_loader.Update(kModelUploadBudget);
     m_cameraController.UpdateCamera(m_gameCamera, 0.1);
     scene.cameraData = m_gameCamera.GetCameraUniformData();
 }
@@ -72,6 +77,13 @@ bool ExampleLayer::OnEvent(core::Event& event) {
                                            m_cameraController.OnMouseMove(event);
                                            return true;
                                        },
+                                       [&](core::event::WindowResizeEvent& event) {
+                                           if (event.width > 0 && event.height > 0) {
+                                               m_gameCamera.proj = common::Projection::Perspective(
+                                                   45, event.width, event.height, 0.1, 100.0);
+                                           }
+                                           return false;
+                                       },
                                        [](core::event::WindowCloseEvent& event) {
                                            exit(0);
                                            return true;
@@ -25,7 +25,7 @@ class ExampleLayer : public core::Layer {
         : m_app(app),
           m_device(device),
           m_gameCamera(camera),
-          m_loader(loader),
+          m_loader(std::move(loader)),
           m_shaderLoader(shaderLoader) {}
 
     core::Application* m_app;
@@ -38,4 +38,7 @@ class ExampleLayer : public core::Layer {
     loader::ShaderLoader m_shaderLoader;
 
     core::Handle m_modelHandle;
+
+    // Time per frame spent creating GPU resources of loaded models.
+    static constexpr std::chrono::microseconds kModelUploadBudget{2000};
 };
@@ -1,29 +1,164 @@
 #include "ModelLoader.h"
-#include <import/GLTFImporter.h>
+#include <algorithm>
+#include <thread>
+
+namespace {
+// Runs on a worker: parses the file and decodes its images.
+std::expected<core::importer::GLTFImportResult, core::Error> Import(const std::string& path) {
+    auto resultOrError = core::importer::GLTFImporter::ImportFromFile(path);
+    if (resultOrError.has_value()) {
+        for (auto& materialResult : resultOrError->materials) {
+            materialResult.materialAsset.shaderName.value =
+                std::string("assets/ForwardPass.shdr");
+        }
+    }
+    return resultOrError;
+}
+}  // namespace
 
 std::expected<core::Handle, core::Error> loader::GLTFLoader::LoadModel(const std::string& path) {
     if (m_modelCache.find(path) != m_modelCache.end()) {
         return m_modelCache[path];
     }
-    auto resultOrError = core::importer::GLTFImporter::ImportFromFile(path);
+    if (auto it = std::ranges::find(m_pendingLoads, path, &PendingLoad::path);
+        it != m_pendingLoads.end()) {
+        const std::shared_ptr<PendingLoad> load = *it;
+        // The import may still be queued behind others, so help out instead of only waiting.
+        while (!load->imported.load(std::memory_order_acquire)) {
+            if (!m_jobSystem->RunPendingJob()) {
+                std::this_thread::yield();
+            }
+        }
+        AdvanceLoad(*load, std::chrono::steady_clock::time_point::max());
+        std::erase(m_pendingLoads, load);
+        CompleteLoad(*load);
+        return *load->result;
+    }
+
+    auto resultOrError = Import(path);
     if (!resultOrError.has_value()) {
         return std::unexpected(resultOrError.error());
     }
     auto& result = resultOrError.value();
 
-    for (const core::importer::TextureResult& textureResult : result.textures) {
-        core::Handle _ = m_textureManger->LoadTexture(textureResult);
+    CreateProgress progress;
+    while (CreateNextResource(result, progress)) {
+    }
+
+    core::Handle modelHandle = CreateModel(result);
+    m_modelCache[path] = modelHandle;
+    return modelHandle;
+}
+
+std::shared_future<loader::ModelResult> loader::GLTFLoader::LoadModelAsync(
+    const std::string& path,
+    ModelCallback onLoaded) {
+    if (auto it = m_modelCache.find(path); it != m_modelCache.end()) {
+        const ModelResult result = it->second;
+        if (onLoaded) {
+            onLoaded(result);
+        }
+        std::promise<ModelResult> promise;
+        promise.set_value(result);
+        return promise.get_future().share();
+    }
+
+    auto pending = std::ranges::find(m_pendingLoads, path, &PendingLoad::path);
+    if (pending != m_pendingLoads.end()) {
+        if (onLoaded) {
+            (*pending)->callbacks.push_back(std::move(onLoaded));
+        }
+        return (*pending)->future;
+    }
+
+    auto load = std::make_shared<PendingLoad>();
+    load->path = path;
+    load->future = load->promise.get_future().share();
+    if (onLoaded) {
+        load->callbacks.push_back(std::move(onLoaded));
+    }
+    m_pendingLoads.push_back(load);
+
+    m_jobSystem->SubmitBackground([load] {
+        load->importResult = Import(load->path);
+        load->imported.store(true, std::memory_order_release);
+    });
+    return load->future;
+}
+
+void loader::GLTFLoader::Update(std::chrono::microseconds budget) {
+    const auto deadline = std::chrono::steady_clock::now() + budget;
+    for (const auto& load : m_pendingLoads) {
+        if (!load->imported.load(std::memory_order_acquire)) {
+            continue;
+        }
+        if (!AdvanceLoad(*load, deadline)) {
+            break;
+        }
     }
 
-    for (auto& materialResult : result.materials) {
-        materialResult.materialAsset.shaderName.value = std::string("assets/ForwardPass.shdr");
-        core::Handle _ = m_materialManager->LoadMaterial(materialResult);
+    // Callbacks may start new loads, so finished ones are taken out first.
+    std::vector<std::shared_ptr<PendingLoad>> finished;
+    std::erase_if(m_pendingLoads, [&](const std::shared_ptr<PendingLoad>& load) {
+        if (!load->result.has_value()) {
+            return false;
+        }
+        finished.push_back(load);
+        return true;
+    });
+    for (const auto& load : finished) {
+        CompleteLoad(*load);
     }
+}
 
-    for (const auto& meshResult : result.meshes) {
-        core::Handle _ = m_meshManager->LoadMesh(meshResult);
+bool loader::GLTFLoader::AdvanceLoad(PendingLoad& load,
+                                     std::chrono::steady_clock::time_point deadline) {
+    if (load.result.has_value()) {
+        return true;
+    }
+    auto& importResult = *load.importResult;
+    if (!importResult.has_value()) {
+        load.result = std::unexpected(importResult.error());
+        return true;
     }
 
+    while (CreateNextResource(*importResult, load.progress)) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+    }
+    load.result = CreateModel(*importResult);
+    m_modelCache[load.path] = **load.result;
+    // The decoded data was copied to the GPU.
+    load.importResult.reset();
+    return true;
+}
+
+void loader::GLTFLoader::CompleteLoad(PendingLoad& load) {
+    load.promise.set_value(*load.result);
+    for (const ModelCallback& callback : load.callbacks) {
+        callback(*load.result);
+    }
+}
+
+bool loader::GLTFLoader::CreateNextResource(core::importer::GLTFImportResult& result,
+                                            CreateProgress& progress) {
+    if (progress.textures < result.textures.size()) {
+        core::Handle _ = m_textureManger->LoadTexture(result.textures[progress.textures++]);
+        return true;
+    }
+    if (progress.materials < result.materials.size()) {
+        core::Handle _ = m_materialManager->LoadMaterial(result.materials[progress.materials++]);
+        return true;
+    }
+    if (progress.meshes < result.meshes.size()) {
+        core::Handle _ = m_meshManager->LoadMesh(result.meshes[progress.meshes++]);
+        return true;
+    }
+    return false;
+}
+
+core::Handle loader::GLTFLoader::CreateModel(const core::importer::GLTFImportResult& result) {
     core::render::Model model;
     for (const auto& node : result.modelAsset.nodes) {
         core::Handle meshHandle = m_meshManager->GetMeshHandle(node.meshId);
@@ -47,7 +182,5 @@ std::expected<core::Handle, core::Error> loader::GLTFLoader::LoadModel(const std
         }
     }
 
-    core::Handle modelHandle = m_assetManager->StoreModel(std::move(model));
-    m_modelCache[path] = modelHandle;
-    return modelHandle;
+    return m_assetManager->StoreModel(std::move(model));
 }
@@ -1,34 +1,100 @@
 #pragma once
+#include <atomic>
+#include <chrono>
 #include <expected>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <Common.h>
 #include <MeshAssetFormat.h>
 #include <ModelAssetFormat.h>
+#include <import/GLTFImporter.h>
 #include <render/resource/MaterialManager.h>
 #include <render/resource/MeshManager.h>
 #include <render/resource/Model.h>
 #include <render/resource/TextureManager.h>
+#include <util/JobSystem.h>
 
 namespace loader {
+using ModelResult = std::expected<core::Handle, core::Error>;
+using ModelCallback = std::function<void(const ModelResult&)>;
+
 class GLTFLoader {
   public:
     GLTFLoader(core::AssetManager* assetManager,
                core::render::TextureManager* textureManager,
                core::render::MaterialManager* materialManager,
-               core::render::MeshManager* meshManager)
+               core::render::MeshManager* meshManager,
+               core::util::JobSystem* jobSystem)
         : m_assetManager(assetManager),
           m_textureManger(textureManager),
           m_materialManager(materialManager),
-          m_meshManager(meshManager) {}
+          m_meshManager(meshManager),
+          m_jobSystem(jobSystem) {}
+
+    GLTFLoader(const GLTFLoader&) = delete;
+    GLTFLoader& operator=(const GLTFLoader&) = delete;
+    GLTFLoader(GLTFLoader&&) = default;
+    GLTFLoader& operator=(GLTFLoader&&) = default;
 
+    // Blocks until the model is loaded. A path that is already loading asynchronously is
+    // finished instead of being imported a second time; its future and callbacks complete too.
     std::expected<core::Handle, core::Error> LoadModel(const std::string& path);
 
+    // Returns right away. The file is parsed and its images decoded on a background job, and
+    // its GPU resources are created by Update, which also completes the future and runs
+    // onLoaded. Requests for a path that is already loading share that load; a model that was
+    // loaded before completes immediately.
+    std::shared_future<ModelResult> LoadModelAsync(const std::string& path,
+                                                   ModelCallback onLoaded = {});
+
+    // Creates GPU resources of imported models until budget is spent; call it once a frame on
+    // the render thread. Resources are created whole, and at least one per call, so a large
+    // texture or mesh may overrun the budget.
+    void Update(std::chrono::microseconds budget);
+    bool HasPendingLoads() const { return !m_pendingLoads.empty(); }
+
   private:
+    // Textures come first, since materials look theirs up while they are created.
+    struct CreateProgress {
+        size_t textures = 0;
+        size_t materials = 0;
+        size_t meshes = 0;
+    };
+
+    struct PendingLoad {
+        std::string path;
+        std::promise<ModelResult> promise;
+        std::shared_future<ModelResult> future;
+        std::vector<ModelCallback> callbacks;
+        // Written by the import job, then imported is set.
+        std::optional<std::expected<core::importer::GLTFImportResult, core::Error>> importResult;
+        std::atomic<bool> imported = false;
+        CreateProgress progress;
+        std::optional<ModelResult> result;
+    };
+
+    // Creates resources of an imported load until deadline; true once its result is set.
+    bool AdvanceLoad(PendingLoad& load, std::chrono::steady_clock::time_point deadline);
+    // Completes the future and runs the callbacks of a load taken out of m_pendingLoads.
+    static void CompleteLoad(PendingLoad& load);
+    // Creates the next GPU resource of result; false once all of them were created.
+    bool CreateNextResource(core::importer::GLTFImportResult& result, CreateProgress& progress);
+    core::Handle CreateModel(const core::importer::GLTFImportResult& result);
+
     core::AssetManager* m_assetManager = nullptr;
     core::render::TextureManager* m_textureManger = nullptr;
     core::render::MaterialManager* m_materialManager = nullptr;
     core::render::MeshManager* m_meshManager = nullptr;
+    core::util::JobSystem* m_jobSystem = nullptr;
 
     std::unordered_map<std::string, core::Handle> m_modelCache;
+    // In request order. Shared with the import jobs, which may outlive the loader.
+    std::vector<std::shared_ptr<PendingLoad>> m_pendingLoads;
 };
 }  // namespace loader
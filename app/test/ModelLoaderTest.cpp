@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <AssetManager.h>
+#include <render/render.h>
+#include <render/resource/VertexLayoutManager.h>
+
+#include "ModelLoader.h"
+
+// GLTFLoader's load states on a headless device: shared and cached requests, loads that fail,
+// Update with no time budget, and LoadModel on a path that is still loading asynchronously.
+
+namespace {
+using namespace core;
+using namespace core::render;
+using namespace std::chrono_literals;
+
+// One triangle without a material; the buffer holds three positions and three uint16 indices.
+constexpr const char* kTriangleGltf = R"({
+  "asset": {"version": "2.0"},
+  "buffers": [{"byteLength": 44, "uri": "data:application/octet-stream;base64,)"
+                                   "AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAAAAAAAAgD8AAAAAAAABAAIAAAA="
+                                   R"("}],
+  "bufferViews": [{"buffer": 0, "byteOffset": 0, "byteLength": 36},
+                  {"buffer": 0, "byteOffset": 36, "byteLength": 6}],
+  "accessors": [{"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3",
+                 "min": [0, 0, 0], "max": [1, 1, 0]},
+                {"bufferView": 1, "componentType": 5123, "count": 3, "type": "SCALAR"}],
+  "meshes": [{"primitives": [{"attributes": {"POSITION": 0}, "indices": 1}]}],
+  "nodes": [{"mesh": 0}],
+  "scenes": [{"nodes": [0]}],
+  "scene": 0
+})";
+}  // namespace
+
+class ModelLoaderTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        directory = std::filesystem::temp_directory_path() / "ModelLoaderTest";
+        std::filesystem::create_directories(directory);
+        trianglePath = (directory / "triangle.gltf").string();
+        std::ofstream(trianglePath) << kTriangleGltf;
+        missingPath = (directory / "missing.gltf").string();
+
+        device = Device::CreateHeadless(HeadlessSpec{.width = 64, .height = 64});
+        if (device == nullptr) {
+            GTEST_SKIP() << "No WebGPU adapter available";
+        }
+        textures = std::make_unique<TextureManager>(device.get(), &assets);
+        materials = std::make_unique<MaterialManager>(device.get(), &assets, textures.get());
+        meshes = std::make_unique<MeshManager>(device.get(), &assets, &layouts);
+        modelLoader = std::make_unique<loader::GLTFLoader>(&assets, textures.get(),
+                                                           materials.get(), meshes.get(), &jobs);
+    }
+
+    void TearDown() override {
+        modelLoader.reset();
+        std::filesystem::remove_all(directory);
+    }
+
+    // Pumps Update with no budget until nothing is pending.
+    void UpdateUntilIdle() {
+        for (int updates = 0; modelLoader->HasPendingLoads() && updates < 100000; ++updates) {
+            modelLoader->Update(0us);
+        }
+        EXPECT_FALSE(modelLoader->HasPendingLoads());
+    }
+
+    static bool IsReady(const std::shared_future<loader::ModelResult>& future) {
+        return future.wait_for(0s) == std::future_status::ready;
+    }
+
+    std::filesystem::path directory;
+    std::string trianglePath;
+    std::string missingPath;
+
+    AssetManager assets = AssetManager::Create();
+    VertexLayoutManager layouts;
+    core::util::JobSystem jobs{1};
+    std::unique_ptr<Device> device;
+    std::unique_ptr<TextureManager> textures;
+    std::unique_ptr<MaterialManager> materials;
+    std::unique_ptr<MeshManager> meshes;
+    std::unique_ptr<loader::GLTFLoader> modelLoader;
+};
+
+TEST_F(ModelLoaderTest, SharedRequestsCompleteTogether) {
+    std::vector<loader::ModelResult> results;
+    auto first = modelLoader->LoadModelAsync(
+        trianglePath, [&](const loader::ModelResult& result) { results.push_back(result); });
+    auto second = modelLoader->LoadModelAsync(
+        trianglePath, [&](const loader::ModelResult& result) { results.push_back(result); });
+    EXPECT_TRUE(modelLoader->HasPendingLoads());
+    EXPECT_TRUE(results.empty());
+
+    // A zero budget still creates one resource per call, so the load finishes.
+    UpdateUntilIdle();
+    ASSERT_TRUE(IsReady(first));
+    ASSERT_TRUE(IsReady(second));
+    ASSERT_TRUE(first.get().has_value());
+    EXPECT_EQ(first.get().value(), second.get().value());
+
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0].value(), first.get().value());
+    EXPECT_EQ(results[1].value(), first.get().value());
+    EXPECT_EQ(assets.GetModel(first.get().value())->renderUnits.size(), 1u);
+}
+
+TEST_F(ModelLoaderTest, CachedPathCompletesImmediately) {
+    auto loaded = modelLoader->LoadModelAsync(trianglePath);
+    UpdateUntilIdle();
+    ASSERT_TRUE(loaded.get().has_value());
+
+    int callbacks = 0;
+    auto cached =
+        modelLoader->LoadModelAsync(trianglePath, [&](const loader::ModelResult&) { ++callbacks; });
+    EXPECT_FALSE(modelLoader->HasPendingLoads());
+    EXPECT_EQ(callbacks, 1);
+    ASSERT_TRUE(IsReady(cached));
+    EXPECT_EQ(cached.get().value(), loaded.get().value());
+
+    const auto sync = modelLoader->LoadModel(trianglePath);
+    ASSERT_TRUE(sync.has_value());
+    EXPECT_EQ(sync.value(), loaded.get().value());
+}
+
+TEST_F(ModelLoaderTest, MissingFileFails) {
+    int callbacks = 0;
+    auto missing = modelLoader->LoadModelAsync(missingPath, [&](const loader::ModelResult& result) {
+        EXPECT_FALSE(result.has_value());
+        ++callbacks;
+    });
+    UpdateUntilIdle();
+    ASSERT_TRUE(IsReady(missing));
+    EXPECT_FALSE(missing.get().has_value());
+    EXPECT_EQ(callbacks, 1);
+
+    // Failures aren't cached, so a later request tries again.
+    auto retry = modelLoader->LoadModelAsync(missingPath);
+    EXPECT_TRUE(modelLoader->HasPendingLoads());
+    UpdateUntilIdle();
+    EXPECT_FALSE(retry.get().has_value());
+
+    EXPECT_FALSE(modelLoader->LoadModel(missingPath).has_value());
+}
+
+TEST_F(ModelLoaderTest, LoadModelFinishesPendingLoad) {
+    int callbacks = 0;
+    auto pending =
+        modelLoader->LoadModelAsync(trianglePath, [&](const loader::ModelResult&) { ++callbacks; });
+    ASSERT_TRUE(modelLoader->HasPendingLoads());
+
+    const auto sync = modelLoader->LoadModel(trianglePath);
+    ASSERT_TRUE(sync.has_value());
+    EXPECT_FALSE(modelLoader->HasPendingLoads());
+    EXPECT_EQ(callbacks, 1);
+    ASSERT_TRUE(IsReady(pending));
+    EXPECT_EQ(pending.get().value(), sync.value());
+
+    // Nothing is left for Update to finish a second time.
+    modelLoader->Update(1s);
+    EXPECT_EQ(callbacks, 1);
+}
+
+TEST_F(ModelLoaderTest, LoadModelFinishesPendingFailure) {
+    auto pending = modelLoader->LoadModelAsync(missingPath);
+    EXPECT_FALSE(modelLoader->LoadModel(missingPath).has_value());
+    EXPECT_FALSE(modelLoader->HasPendingLoads());
+    ASSERT_TRUE(IsReady(pending));
+    EXPECT_FALSE(pending.get().has_value());
+}
@@ -0,0 +1,103 @@
+#include <filesystem>
+#include <format>
+#include <print>
+#include <string>
+#include <unordered_map>
+#include "import/GLTFImporter.h"
+#include "util.h"
+
+namespace fs = std::filesystem;
+
+void PrintUsage() {
+    std::println("Usage: assetBaker -i <model.gltf|model.glb> -o <output_dir>");
+    std::println("Writes <model>_<index>.mesh per glTF mesh and <model>_<index>.tex per image.");
+}
+
+int main(int argc, char** argv) {
+    fs::path inputPath;
+    fs::path outputDir;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "-i" && i + 1 < argc) {
+            inputPath = argv[++i];
+        } else if (arg == "-o" && i + 1 < argc) {
+            outputDir = argv[++i];
+        }
+    }
+
+    if (inputPath.empty() || outputDir.empty()) {
+        std::println(stderr, "Error: Missing required arguments (-i and -o are mandatory).");
+        PrintUsage();
+        return 1;
+    }
+
+    std::println("Baking Model: {} ...", inputPath.string());
+    auto resultOrError = core::importer::GLTFImporter::ImportFromFile(inputPath.string());
+    if (!resultOrError.has_value()) {
+        std::println(stderr, "Error! Import failed for {}: {}", inputPath.string(),
+                     resultOrError.error().message);
+        return 1;
+    }
+
+    std::error_code error;
+    fs::create_directories(outputDir, error);
+    if (error) {
+        std::println(stderr, "Error: Failed to create output directory {}: {}",
+                     outputDir.string(), error.message());
+        return 1;
+    }
+
+    // Assets are named after the model and their glTF index.
+    const std::string stem = inputPath.stem().string();
+    const auto& meshes = resultOrError->meshes;
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        const fs::path outputPath = outputDir / std::format("{}_{}.mesh", stem, i);
+        if (!WriteMeshAssetToFile(outputPath, meshes[i].meshAsset)) {
+            std::println(stderr, "Error: Failed to serialize baked mesh to disk: {}",
+                         outputPath.string());
+            return 1;
+        }
+        std::println("Successfully baked mesh asset: {}", outputPath.string());
+    }
+
+    // Color textures are filtered in linear light and normal maps as vectors; everything else,
+    // like metallic-roughness or occlusion, is plain data.
+    std::unordered_map<core::AssetPath, MipFilter> filters;
+    for (const auto& material : resultOrError->materials) {
+        for (const auto& [slot, texturePath] : material.materialAsset.textures) {
+            if (slot == "baseColorTexture" || slot == "emissiveTexture") {
+                filters[texturePath] = MipFilter::Srgb;
+            } else if (slot == "normalTexture") {
+                filters[texturePath] = MipFilter::Normal;
+            }
+        }
+    }
+
+    const auto& textures = resultOrError->textures;
+    for (size_t i = 0; i < textures.size(); ++i) {
+        const core::TextureAssetFormat& texture = textures[i].textureAsset;
+        if (texture.width == 0 || texture.height == 0 ||
+            texture.pixelData.size() < texture.GetPixelDataSize()) {
+            std::println(stderr, "Warning: Skipping texture {} that failed to import", i);
+            continue;
+        }
+        // Mips are filtered and .tex files are read as RGBA8 only.
+        if (texture.channel != 4 || texture.format != core::TextureFormat::RGBA8Unorm) {
+            std::println(stderr, "Warning: Skipping texture {} with {} channels, not RGBA8", i,
+                         texture.channel);
+            continue;
+        }
+        const auto it = filters.find(textures[i].assetPath);
+        const MipFilter filter = it != filters.end() ? it->second : MipFilter::Linear;
+
+        const fs::path outputPath = outputDir / std::format("{}_{}.tex", stem, i);
+        if (!WriteTextureAssetToFile(outputPath, BuildMipChain(texture, filter))) {
+            std::println(stderr, "Error: Failed to serialize baked texture to disk: {}",
+                         outputPath.string());
+            return 1;
+        }
+        std::println("Successfully baked texture asset: {}", outputPath.string());
+    }
+    return 0;
+}
@@ -0,0 +1,303 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <iterator>
+#include <vector>
+
+#include "MeshAssetFormat.h"
+#include "util.h"
+
+// A mesh baked by WriteMeshAssetToFile and read back by MappedMeshAsset::LoadFromMemory, then
+// the same file with one field broken at a time, which LoadFromMemory has to reject.
+
+namespace {
+using namespace core;
+using ma = MeshAssetFormat;
+
+ma::MeshBufferSlot MakeSlot(ma::StepMode stepMode,
+                            uint32_t stride,
+                            std::initializer_list<ma::MeshAttribute> attributes) {
+    ma::MeshBufferSlot slot{.stepMode = stepMode, .stride = stride};
+    for (const ma::MeshAttribute& attribute : attributes) {
+        slot.attributes[slot.attributeCount++] = attribute;
+    }
+    return slot;
+}
+
+// Two submeshes with different vertex states over one vertex buffer.
+ma MakeMesh() {
+    ma mesh;
+    ma::MeshVertexState positionOnly;
+    positionOnly.bufferSlots[positionOnly.slotCount++] = MakeSlot(
+        ma::StepMode::Vertex, 12, {{ma::VertexFormat::Float32x3, Semantic::Position, 0}});
+    ma::MeshVertexState surface = positionOnly;
+    surface.bufferSlots[surface.slotCount++] =
+        MakeSlot(ma::StepMode::Vertex, 36,
+                 {{ma::VertexFormat::Float32x3, Semantic::Normal, 0},
+                  {ma::VertexFormat::Float32x2, Semantic::TexCoord0, 12},
+                  {ma::VertexFormat::Float32x4, Semantic::Tangent, 20}});
+    surface.bufferSlots[surface.slotCount++] = MakeSlot(
+        ma::StepMode::Instance, 4, {{ma::VertexFormat::Float32, Semantic::Color0, 0}});
+    mesh.states = {positionOnly, surface};
+
+    // 4 positions, then 4 surface vertices, then 4 colors.
+    mesh.bufferRanges = {{0, 48}, {48, 144}, {192, 16}, {0, 48}};
+    mesh.subMeshes = {
+        {.indexCount = 6, .indexStart = 0, .stateIndex = 1, .bufferRangeStart = 0,
+         .bufferRangeCount = 3},
+        {.indexCount = 3, .indexStart = 6, .stateIndex = 0, .bufferRangeStart = 3,
+         .bufferRangeCount = 1},
+    };
+    mesh.subMeshBounds = {
+        {glm::vec3(-1.0f), glm::vec3(1.0f), glm::vec3(0.0f), 1.5f},
+        {glm::vec3(0.0f), glm::vec3(1.0f), glm::vec3(0.5f), 0.9f},
+    };
+    mesh.indexData = {0, 1, 2, 0, 2, 3, 0, 1, 3};
+    mesh.vertexData.resize(208);
+    for (size_t i = 0; i < mesh.vertexData.size(); ++i) {
+        mesh.vertexData[i] = std::byte(i * 7);
+    }
+    return mesh;
+}
+
+std::vector<uint8_t> ReadFile(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), {});
+}
+
+ma::Header ReadHeader(const std::vector<uint8_t>& bytes) {
+    ma::Header header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    return header;
+}
+
+template <typename T>
+T ReadAt(const std::vector<uint8_t>& bytes, uint64_t offset) {
+    T value;
+    std::memcpy(&value, bytes.data() + offset, sizeof(T));
+    return value;
+}
+
+// Copies of the states whose padding bytes all hold fill.
+std::vector<ma::MeshVertexState> WithPadding(const std::vector<ma::MeshVertexState>& states,
+                                             uint8_t fill) {
+    std::vector<ma::MeshVertexState> padded(states.size());
+    std::memset(static_cast<void*>(padded.data()), fill,
+                sizeof(ma::MeshVertexState) * padded.size());
+    for (size_t i = 0; i < states.size(); ++i) {
+        padded[i].slotCount = states[i].slotCount;
+        for (size_t s = 0; s < states[i].bufferSlots.size(); ++s) {
+            const ma::MeshBufferSlot& slot = states[i].bufferSlots[s];
+            ma::MeshBufferSlot& paddedSlot = padded[i].bufferSlots[s];
+            paddedSlot.stepMode = slot.stepMode;
+            paddedSlot.stride = slot.stride;
+            paddedSlot.attributeCount = slot.attributeCount;
+            for (size_t a = 0; a < slot.attributes.size(); ++a) {
+                paddedSlot.attributes[a].format = slot.attributes[a].format;
+                paddedSlot.attributes[a].semantic = slot.attributes[a].semantic;
+                paddedSlot.attributes[a].offset = slot.attributes[a].offset;
+            }
+        }
+    }
+    return padded;
+}
+
+template <typename T>
+void WriteAt(std::vector<uint8_t>& bytes, uint64_t offset, const T& value) {
+    std::memcpy(bytes.data() + offset, &value, sizeof(T));
+}
+}  // namespace
+
+class MeshAssetTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        path = std::filesystem::temp_directory_path() / "MeshAssetTest.mesh";
+        ASSERT_TRUE(WriteMeshAssetToFile(path, mesh));
+        bytes = ReadFile(path);
+        ASSERT_GE(bytes.size(), sizeof(ma::Header));
+        header = ReadHeader(bytes);
+    }
+
+    void TearDown() override { std::filesystem::remove(path); }
+
+    // Rewrites the vertex state at stateIndex in the file bytes.
+    template <typename Mutate>
+    void MutateState(size_t stateIndex, Mutate mutate) {
+        const uint64_t offset = header.stateOffset + stateIndex * sizeof(ma::MeshVertexState);
+        auto state = ReadAt<ma::MeshVertexState>(bytes, offset);
+        mutate(state);
+        WriteAt(bytes, offset, state);
+    }
+
+    bool Loads() const { return MappedMeshAsset::LoadFromMemory(bytes).has_value(); }
+
+    const ma mesh = MakeMesh();
+    std::filesystem::path path;
+    std::vector<uint8_t> bytes;
+    ma::Header header;
+};
+
+TEST_F(MeshAssetTest, RoundTrip) {
+    auto meshOrError = MappedMeshAsset::LoadFromMemory(bytes);
+    ASSERT_TRUE(meshOrError.has_value()) << meshOrError.error().message;
+    const MappedMeshAsset& loaded = meshOrError.value();
+
+    EXPECT_EQ(loaded.format.states, mesh.states);
+    ASSERT_EQ(loaded.format.bufferRanges.size(), mesh.bufferRanges.size());
+    for (size_t i = 0; i < mesh.bufferRanges.size(); ++i) {
+        EXPECT_EQ(loaded.format.bufferRanges[i].offset, mesh.bufferRanges[i].offset);
+        EXPECT_EQ(loaded.format.bufferRanges[i].size, mesh.bufferRanges[i].size);
+    }
+    ASSERT_EQ(loaded.format.subMeshes.size(), mesh.subMeshes.size());
+    for (size_t i = 0; i < mesh.subMeshes.size(); ++i) {
+        EXPECT_EQ(loaded.format.subMeshes[i].indexCount, mesh.subMeshes[i].indexCount);
+        EXPECT_EQ(loaded.format.subMeshes[i].indexStart, mesh.subMeshes[i].indexStart);
+        EXPECT_EQ(loaded.format.subMeshes[i].stateIndex, mesh.subMeshes[i].stateIndex);
+        EXPECT_EQ(loaded.format.subMeshes[i].bufferRangeStart,
+                  mesh.subMeshes[i].bufferRangeStart);
+        EXPECT_EQ(loaded.format.subMeshes[i].bufferRangeCount,
+                  mesh.subMeshes[i].bufferRangeCount);
+    }
+    ASSERT_EQ(loaded.format.subMeshBounds.size(), mesh.subMeshBounds.size());
+    for (size_t i = 0; i < mesh.subMeshBounds.size(); ++i) {
+        EXPECT_EQ(loaded.format.subMeshBounds[i].aabbMin, mesh.subMeshBounds[i].aabbMin);
+        EXPECT_EQ(loaded.format.subMeshBounds[i].aabbMax, mesh.subMeshBounds[i].aabbMax);
+        EXPECT_EQ(loaded.format.subMeshBounds[i].sphereCenter,
+                  mesh.subMeshBounds[i].sphereCenter);
+        EXPECT_EQ(loaded.format.subMeshBounds[i].sphereRadius,
+                  mesh.subMeshBounds[i].sphereRadius);
+    }
+
+    // Index and vertex data stay in the file bytes.
+    EXPECT_TRUE(loaded.format.indexData.empty());
+    EXPECT_TRUE(loaded.format.vertexData.empty());
+    EXPECT_EQ(std::vector<uint32_t>(loaded.indexData.begin(), loaded.indexData.end()),
+              mesh.indexData);
+    EXPECT_EQ(std::vector<std::byte>(loaded.vertexData.begin(), loaded.vertexData.end()),
+              mesh.vertexData);
+    EXPECT_EQ(reinterpret_cast<const uint8_t*>(loaded.indexData.data()),
+              bytes.data() + header.indexOffset);
+}
+
+TEST_F(MeshAssetTest, EverySectionIsAligned) {
+    for (uint64_t offset : {header.stateOffset, header.bufferRangeOffset, header.subMeshOffset,
+                            header.subMeshBoundsOffset, header.indexOffset, header.vertexOffset}) {
+        EXPECT_EQ(offset % ma::kSectionAlignment, 0u);
+    }
+}
+
+TEST_F(MeshAssetTest, BakingIsDeterministic) {
+    // Whatever the padding of the vertex states holds, the file is the same.
+    for (uint8_t fill : {uint8_t{0xAA}, uint8_t{0x55}}) {
+        ma dirty = MakeMesh();
+        dirty.states = WithPadding(dirty.states, fill);
+        ASSERT_TRUE(WriteMeshAssetToFile(path, dirty));
+        EXPECT_EQ(ReadFile(path), bytes) << "padding filled with " << int{fill};
+    }
+}
+
+TEST_F(MeshAssetTest, RejectsTruncatedFiles) {
+    const std::vector<uint8_t> full = bytes;
+    for (size_t size : {size_t{0}, sizeof(ma::Header) - 1, sizeof(ma::Header),
+                        size_t(header.indexOffset), full.size() - 1}) {
+        bytes.assign(full.begin(), full.begin() + std::ptrdiff_t(size));
+        EXPECT_FALSE(Loads()) << "truncated to " << size << " of " << full.size();
+    }
+}
+
+TEST_F(MeshAssetTest, RejectsBadHeader) {
+    ma::Header broken = header;
+    broken.magicNumber = 0;
+    WriteAt(bytes, 0, broken);
+    EXPECT_FALSE(Loads());
+
+    broken = header;
+    broken.version = ma::MESH_ASSET_VERSION + 1;
+    WriteAt(bytes, 0, broken);
+    EXPECT_FALSE(Loads());
+}
+
+TEST_F(MeshAssetTest, RejectsMisalignedSections) {
+    for (uint64_t ma::Header::*offset :
+         {&ma::Header::stateOffset, &ma::Header::bufferRangeOffset, &ma::Header::subMeshOffset,
+          &ma::Header::subMeshBoundsOffset, &ma::Header::indexOffset, &ma::Header::vertexOffset}) {
+        ma::Header broken = header;
+        broken.*offset += 4;
+        WriteAt(bytes, 0, broken);
+        EXPECT_FALSE(Loads());
+    }
+}
+
+TEST_F(MeshAssetTest, RejectsSectionsPastTheEnd) {
+    ma::Header broken = header;
+    broken.vertexDataSize += 1;
+    WriteAt(bytes, 0, broken);
+    EXPECT_FALSE(Loads());
+
+    broken = header;
+    broken.indexOffset = bytes.size() + ma::kSectionAlignment;
+    WriteAt(bytes, 0, broken);
+    EXPECT_FALSE(Loads());
+}
+
+TEST_F(MeshAssetTest, RejectsSubMeshesOutOfRange) {
+    const uint64_t first = header.subMeshOffset;
+    const auto subMesh = ReadAt<ma::SubMeshInfo>(bytes, first);
+
+    ma::SubMeshInfo broken = subMesh;
+    broken.stateIndex = 2;
+    WriteAt(bytes, first, broken);
+    EXPECT_FALSE(Loads());
+
+    broken = subMesh;
+    broken.indexStart = 4;  // 4 + 6 indices runs past the 9 in the file.
+    WriteAt(bytes, first, broken);
+    EXPECT_FALSE(Loads());
+
+    broken = subMesh;
+    broken.bufferRangeStart = 2;
+    WriteAt(bytes, first, broken);
+    EXPECT_FALSE(Loads());
+
+    WriteAt(bytes, first, subMesh);
+    auto range = ReadAt<ma::BufferRange>(bytes, header.bufferRangeOffset);
+    range.offset = 200;  // 200 + 48 runs past the 208 bytes of vertex data.
+    WriteAt(bytes, header.bufferRangeOffset, range);
+    EXPECT_FALSE(Loads());
+}
+
+TEST_F(MeshAssetTest, RejectsVertexStatesOutOfRange) {
+    const std::vector<uint8_t> valid = bytes;
+    const auto expectRejected = [&](auto mutate) {
+        bytes = valid;
+        MutateState(1, mutate);
+        EXPECT_FALSE(Loads());
+    };
+
+    expectRejected([](ma::MeshVertexState& state) { state.slotCount = 5; });
+    expectRejected([](ma::MeshVertexState& state) { state.bufferSlots[1].attributeCount = 9; });
+    expectRejected([](ma::MeshVertexState& state) {
+        state.bufferSlots[2].stepMode = ma::StepMode::Undefined;
+    });
+    expectRejected([](ma::MeshVertexState& state) {
+        state.bufferSlots[2].stepMode = static_cast<ma::StepMode>(2);
+    });
+    expectRejected([](ma::MeshVertexState& state) {
+        state.bufferSlots[1].attributes[2].format = ma::VertexFormat::Undefined;
+    });
+    expectRejected([](ma::MeshVertexState& state) {
+        state.bufferSlots[0].attributes[0].format = static_cast<ma::VertexFormat>(4);
+    });
+
+    // Slots and attributes past the counts are never read, so garbage there is fine.
+    bytes = valid;
+    MutateState(0, [](ma::MeshVertexState& state) {
+        state.bufferSlots[3].stepMode = ma::StepMode::Undefined;
+        state.bufferSlots[0].attributes[7].format = ma::VertexFormat::Undefined;
+    });
+    EXPECT_TRUE(Loads());
+}
@@ -0,0 +1,290 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "TextureAssetFormat.h"
+#include "util.h"
+
+// The mip layout of TextureAssetFormat, BuildMipChain's box filter, and .tex files written by
+// WriteTextureAssetToFile and read back by MappedTextureAsset::LoadFromMemory.
+
+namespace {
+using namespace core;
+using ta = TextureAssetFormat;
+using Texel = std::array<uint8_t, 4>;
+
+ta MakeTexture(uint32_t width, uint32_t height, const std::vector<Texel>& texels) {
+    ta texture{.width = width, .height = height, .channel = 4};
+    for (const Texel& texel : texels) {
+        texture.pixelData.insert(texture.pixelData.end(), texel.begin(), texel.end());
+    }
+    return texture;
+}
+
+ta MakeUniform(uint32_t width, uint32_t height, Texel texel) {
+    return MakeTexture(width, height, std::vector<Texel>(size_t{width} * height, texel));
+}
+
+Texel TexelAt(const ta& texture, uint32_t mip, uint32_t x, uint32_t y) {
+    const ta::MipLevel level = texture.GetMipLevel(mip);
+    const uint8_t* texel =
+        &texture.pixelData[level.offset + size_t{y} * level.bytesPerRow + size_t{x} * 4];
+    return {texel[0], texel[1], texel[2], texel[3]};
+}
+
+std::vector<uint8_t> ReadFile(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), {});
+}
+}  // namespace
+
+TEST(TextureAssetFormatTest, MaxMipCount) {
+    EXPECT_EQ(ta::GetMaxMipCount(1, 1), 1u);
+    EXPECT_EQ(ta::GetMaxMipCount(2, 2), 2u);
+    EXPECT_EQ(ta::GetMaxMipCount(5, 3), 3u);
+    EXPECT_EQ(ta::GetMaxMipCount(1, 8), 4u);
+    EXPECT_EQ(ta::GetMaxMipCount(1024, 512), 11u);
+}
+
+TEST(TextureAssetFormatTest, TightlyPackedMipLevels) {
+    const ta texture{.width = 5, .height = 3, .mips = 3, .channel = 4};
+
+    const ta::MipLevel level0 = texture.GetMipLevel(0);
+    EXPECT_EQ(level0.width, 5u);
+    EXPECT_EQ(level0.height, 3u);
+    EXPECT_EQ(level0.bytesPerRow, 20u);
+    EXPECT_EQ(level0.offset, 0u);
+    EXPECT_EQ(level0.size, 60u);
+
+    const ta::MipLevel level1 = texture.GetMipLevel(1);
+    EXPECT_EQ(level1.width, 2u);
+    EXPECT_EQ(level1.height, 1u);
+    EXPECT_EQ(level1.bytesPerRow, 8u);
+    EXPECT_EQ(level1.offset, 60u);
+    EXPECT_EQ(level1.size, 8u);
+
+    const ta::MipLevel level2 = texture.GetMipLevel(2);
+    EXPECT_EQ(level2.width, 1u);
+    EXPECT_EQ(level2.height, 1u);
+    EXPECT_EQ(level2.offset, 68u);
+    EXPECT_EQ(level2.size, 4u);
+    EXPECT_EQ(texture.GetPixelDataSize(), 72u);
+}
+
+TEST(TextureAssetFormatTest, PaddedMipLevels) {
+    const ta texture{.width = 100,
+                     .height = 2,
+                     .mips = 7,
+                     .channel = 4,
+                     .rowAlignment = ta::kRowPitchAlignment};
+
+    // 400 bytes of texels round up to two pitches; every smaller level fits in one.
+    const ta::MipLevel level0 = texture.GetMipLevel(0);
+    EXPECT_EQ(level0.bytesPerRow, 512u);
+    EXPECT_EQ(level0.size, 1024u);
+    uint64_t offset = level0.size;
+    for (uint32_t mip = 1; mip < texture.mips; ++mip) {
+        const ta::MipLevel level = texture.GetMipLevel(mip);
+        EXPECT_EQ(level.width, 100u >> mip);
+        EXPECT_EQ(level.height, 1u);
+        EXPECT_EQ(level.bytesPerRow, 256u);
+        EXPECT_EQ(level.offset, offset);
+        EXPECT_EQ(level.offset % ta::kSectionAlignment, 0u);
+        offset += level.size;
+    }
+    EXPECT_EQ(texture.GetPixelDataSize(), offset);
+}
+
+TEST(BuildMipChainTest, FullChainWithPaddedRows) {
+    const ta baked = BuildMipChain(MakeUniform(7, 5, {10, 20, 30, 40}), MipFilter::Linear);
+    EXPECT_EQ(baked.mips, 3u);
+    EXPECT_EQ(baked.rowAlignment, ta::kRowPitchAlignment);
+    ASSERT_EQ(baked.pixelData.size(), baked.GetPixelDataSize());
+
+    for (uint32_t mip = 0; mip < baked.mips; ++mip) {
+        const ta::MipLevel level = baked.GetMipLevel(mip);
+        for (uint32_t y = 0; y < level.height; ++y) {
+            for (uint32_t x = 0; x < level.width; ++x) {
+                EXPECT_EQ(TexelAt(baked, mip, x, y), (Texel{10, 20, 30, 40}))
+                    << "mip " << mip << " at " << x << ", " << y;
+            }
+            // Row padding stays zero.
+            const size_t rowEnd = level.offset + size_t{y} * level.bytesPerRow + level.width * 4;
+            for (size_t i = rowEnd; i < level.offset + size_t{y + 1} * level.bytesPerRow; ++i) {
+                ASSERT_EQ(baked.pixelData[i], 0u);
+            }
+        }
+    }
+}
+
+TEST(BuildMipChainTest, BoxFilterOnEvenLevels) {
+    const ta baked = BuildMipChain(
+        MakeTexture(2, 2, {{0, 0, 0, 0}, {40, 80, 120, 160}, {40, 80, 120, 160}, {80, 0, 0, 255}}),
+        MipFilter::Linear);
+    ASSERT_EQ(baked.mips, 2u);
+    // (0 + 40 + 40 + 80) / 4 and so on; alpha is 575 / 4 = 143.75, which rounds up.
+    EXPECT_EQ(TexelAt(baked, 1, 0, 0), (Texel{40, 40, 60, 144}));
+}
+
+TEST(BuildMipChainTest, BoxFilterOnOddLevels) {
+    // An odd last column has no partner and is dropped; a level one texel wide or tall reuses
+    // its only column or row.
+    const ta wide = BuildMipChain(
+        MakeTexture(3, 1, {{0, 0, 0, 0}, {100, 100, 100, 100}, {255, 255, 255, 255}}),
+        MipFilter::Linear);
+    ASSERT_EQ(wide.mips, 2u);
+    EXPECT_EQ(TexelAt(wide, 1, 0, 0), (Texel{50, 50, 50, 50}));
+
+    const ta tall = BuildMipChain(
+        MakeTexture(1, 3, {{0, 0, 0, 0}, {100, 100, 100, 100}, {255, 255, 255, 255}}),
+        MipFilter::Linear);
+    ASSERT_EQ(tall.mips, 2u);
+    EXPECT_EQ(TexelAt(tall, 1, 0, 0), (Texel{50, 50, 50, 50}));
+
+    // 5x3 -> 2x1 -> 1x1, with each texel holding its x in red and y in green.
+    std::vector<Texel> texels;
+    for (uint8_t y = 0; y < 3; ++y) {
+        for (uint8_t x = 0; x < 5; ++x) {
+            texels.push_back({uint8_t(x * 40), uint8_t(y * 100), 0, 255});
+        }
+    }
+    const ta odd = BuildMipChain(MakeTexture(5, 3, texels), MipFilter::Linear);
+    ASSERT_EQ(odd.mips, 3u);
+    EXPECT_EQ(TexelAt(odd, 1, 0, 0), (Texel{20, 50, 0, 255}));
+    EXPECT_EQ(TexelAt(odd, 1, 1, 0), (Texel{100, 50, 0, 255}));
+    EXPECT_EQ(TexelAt(odd, 2, 0, 0), (Texel{60, 50, 0, 255}));
+}
+
+TEST(BuildMipChainTest, SrgbRoundTripsEveryValue) {
+    // Level 0 is decoded and encoded again, which must give back the input bytes.
+    std::vector<Texel> texels;
+    for (uint32_t value = 0; value < 256; ++value) {
+        texels.push_back({uint8_t(value), uint8_t(value), uint8_t(255 - value), uint8_t(value)});
+    }
+    const ta source = MakeTexture(256, 1, texels);
+    for (MipFilter filter : {MipFilter::Srgb, MipFilter::Linear}) {
+        const ta baked = BuildMipChain(source, filter);
+        for (uint32_t x = 0; x < 256; ++x) {
+            ASSERT_EQ(TexelAt(baked, 0, x, 0), texels[x]) << "value " << x;
+        }
+    }
+
+    // A uniform color stays the same on every level.
+    const ta uniform = BuildMipChain(MakeUniform(16, 16, {200, 30, 90, 77}), MipFilter::Srgb);
+    for (uint32_t mip = 0; mip < uniform.mips; ++mip) {
+        EXPECT_EQ(TexelAt(uniform, mip, 0, 0), (Texel{200, 30, 90, 77})) << "mip " << mip;
+    }
+}
+
+TEST(BuildMipChainTest, SrgbAveragesInLinearLight) {
+    const ta source = MakeTexture(2, 1, {{0, 0, 0, 0}, {255, 255, 255, 255}});
+    // Half of linear white is 188 in sRGB; alpha is linear either way.
+    EXPECT_EQ(TexelAt(BuildMipChain(source, MipFilter::Srgb), 1, 0, 0),
+              (Texel{188, 188, 188, 128}));
+    EXPECT_EQ(TexelAt(BuildMipChain(source, MipFilter::Linear), 1, 0, 0),
+              (Texel{128, 128, 128, 128}));
+}
+
+TEST(BuildMipChainTest, NormalsAreRenormalized) {
+    // +X and +Y average to a vector of length 0.707, which is scaled back to unit length.
+    const ta source = MakeTexture(2, 1, {{255, 128, 128, 255}, {128, 255, 128, 255}});
+    const Texel averaged = TexelAt(BuildMipChain(source, MipFilter::Normal), 1, 0, 0);
+    EXPECT_NEAR(averaged[0], 218, 1);
+    EXPECT_NEAR(averaged[1], 218, 1);
+    EXPECT_NEAR(averaged[2], 128, 1);
+    EXPECT_EQ(averaged[3], 255);
+}
+
+class TextureAssetTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        std::vector<Texel> texels;
+        for (uint32_t i = 0; i < 9 * 6; ++i) {
+            texels.push_back({uint8_t(i), uint8_t(i * 3), uint8_t(i * 5), 255});
+        }
+        texture = BuildMipChain(MakeTexture(9, 6, texels), MipFilter::Srgb);
+        path = std::filesystem::temp_directory_path() / "TextureAssetTest.tex";
+        ASSERT_TRUE(WriteTextureAssetToFile(path, texture));
+        bytes = ReadFile(path);
+        ASSERT_GE(bytes.size(), sizeof(ta::Header));
+        std::memcpy(&header, bytes.data(), sizeof(header));
+    }
+
+    void TearDown() override { std::filesystem::remove(path); }
+
+    // Loads bytes with a modified copy of the header.
+    template <typename Mutate>
+    bool LoadsWith(Mutate mutate) {
+        ta::Header broken = header;
+        mutate(broken);
+        std::vector<uint8_t> modified = bytes;
+        std::memcpy(modified.data(), &broken, sizeof(broken));
+        return MappedTextureAsset::LoadFromMemory(modified).has_value();
+    }
+
+    ta texture;
+    std::filesystem::path path;
+    std::vector<uint8_t> bytes;
+    ta::Header header;
+};
+
+TEST_F(TextureAssetTest, RoundTrip) {
+    auto textureOrError = MappedTextureAsset::LoadFromMemory(bytes);
+    ASSERT_TRUE(textureOrError.has_value()) << textureOrError.error().message;
+    const MappedTextureAsset& loaded = textureOrError.value();
+
+    EXPECT_EQ(loaded.format.width, 9u);
+    EXPECT_EQ(loaded.format.height, 6u);
+    EXPECT_EQ(loaded.format.mips, 4u);
+    EXPECT_EQ(loaded.format.channel, 4u);
+    EXPECT_EQ(loaded.format.rowAlignment, ta::kRowPitchAlignment);
+    EXPECT_TRUE(loaded.format.pixelData.empty());
+    EXPECT_EQ(std::vector<uint8_t>(loaded.pixelData.begin(), loaded.pixelData.end()),
+              texture.pixelData);
+    EXPECT_EQ(loaded.pixelData.data(), bytes.data() + header.pixelDataOffset);
+    for (uint32_t mip = 0; mip < loaded.format.mips; ++mip) {
+        const ta::MipLevel expected = texture.GetMipLevel(mip);
+        const ta::MipLevel actual = loaded.format.GetMipLevel(mip);
+        EXPECT_EQ(actual.offset, expected.offset);
+        EXPECT_EQ(actual.bytesPerRow, expected.bytesPerRow);
+    }
+}
+
+TEST_F(TextureAssetTest, RejectsTruncatedFiles) {
+    for (size_t size : {size_t{0}, sizeof(ta::Header) - 1, sizeof(ta::Header),
+                        bytes.size() - 1}) {
+        const std::vector<uint8_t> truncated(bytes.begin(), bytes.begin() + std::ptrdiff_t(size));
+        EXPECT_FALSE(MappedTextureAsset::LoadFromMemory(truncated).has_value())
+            << "truncated to " << size << " of " << bytes.size();
+    }
+}
+
+TEST_F(TextureAssetTest, RejectsBadHeaders) {
+    EXPECT_TRUE(LoadsWith([](ta::Header&) {}));
+    EXPECT_FALSE(LoadsWith([](ta::Header& h) { h.magicNumber = 0; }));
+    EXPECT_FALSE(LoadsWith([](ta::Header& h) { h.version += 1; }));
+    EXPECT_FALSE(LoadsWith([](ta::Header& h) { h.format = TextureFormat::Unknown; }));
+    EXPECT_FALSE(LoadsWith([](ta::Header& h) { h.dimension = TextureDimension::Unknown; }));
+    EXPECT_FALSE(LoadsWith([](ta::Header& h) { h.channel = 3; }));
+    EXPECT_FALSE(LoadsWith([](ta::Header& h) { h.depth = 2; }));
+    EXPECT_FALSE(LoadsWith([](ta::Header& h) { h.width = 0; }));
+    EXPECT_FALSE(LoadsWith([](ta::Header& h) { h.height = 1u << 20; }));
+    EXPECT_FALSE(LoadsWith([](ta::Header& h) { h.mips = 0; }));
+    EXPECT_FALSE(LoadsWith([](ta::Header& h) { h.mips = 5; }));
+    EXPECT_FALSE(LoadsWith([](ta::Header& h) { h.rowAlignment = 0; }));
+    EXPECT_FALSE(LoadsWith([](ta::Header& h) { h.rowAlignment = 128; }));
+}
+
+TEST_F(TextureAssetTest, RejectsPixelDataThatDoesNotMatch) {
+    // Fewer mips describe less data than the file holds.
+    EXPECT_FALSE(LoadsWith([](ta::Header& h) { h.mips = 3; }));
+    EXPECT_FALSE(LoadsWith([](ta::Header& h) { h.pixelDataSize -= 1; }));
+    EXPECT_FALSE(LoadsWith([](ta::Header& h) { h.pixelDataOffset += 4; }));
+    EXPECT_FALSE(LoadsWith([](ta::Header& h) { h.pixelDataOffset += ta::kSectionAlignment; }));
+    EXPECT_FALSE(LoadsWith([](ta::Header& h) { h.pixelDataOffset = ~uint64_t{0} << 4; }));
+}
@@ -0,0 +1,207 @@
+#include "util.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <glm/glm.hpp>
+#include <print>
+
+namespace fs = std::filesystem;
+using ma = core::MeshAssetFormat;
+using ta = core::TextureAssetFormat;
+
+namespace {
+// Pads the file to the next section boundary and returns the offset the section starts at.
+uint64_t BeginSection(std::ofstream& file) {
+    static constexpr char kZeros[ma::kSectionAlignment] = {};
+    const auto offset = static_cast<uint64_t>(file.tellp());
+    const uint64_t padding = (ma::kSectionAlignment - offset % ma::kSectionAlignment) %
+                             ma::kSectionAlignment;
+    file.write(kZeros, static_cast<std::streamsize>(padding));
+    return offset + padding;
+}
+
+float SrgbToLinear(float value) {
+    return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+float LinearToSrgb(float value) {
+    return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+}
+
+glm::vec4 Decode(const uint8_t* texel, MipFilter filter) {
+    glm::vec4 value = glm::vec4(texel[0], texel[1], texel[2], texel[3]) / 255.0f;
+    switch (filter) {
+        case MipFilter::Srgb:
+            return {SrgbToLinear(value.r), SrgbToLinear(value.g), SrgbToLinear(value.b), value.a};
+        case MipFilter::Normal:
+            return {glm::vec3(value) * 2.0f - 1.0f, value.a};
+        case MipFilter::Linear:
+            break;
+    }
+    return value;
+}
+
+void Encode(glm::vec4 value, MipFilter filter, uint8_t* texel) {
+    switch (filter) {
+        case MipFilter::Srgb:
+            value = {LinearToSrgb(value.r), LinearToSrgb(value.g), LinearToSrgb(value.b), value.a};
+            break;
+        case MipFilter::Normal: {
+            const glm::vec3 normal = glm::vec3(value);
+            const float length = glm::length(normal);
+            value = {(length > 0.0f ? normal / length : glm::vec3(0, 0, 1)) * 0.5f + 0.5f,
+                     value.a};
+            break;
+        }
+        case MipFilter::Linear:
+            break;
+    }
+    for (int i = 0; i < 4; ++i) {
+        texel[i] = static_cast<uint8_t>(std::lround(std::clamp(value[i], 0.0f, 1.0f) * 255.0f));
+    }
+}
+
+template <typename T>
+uint64_t WriteSection(std::ofstream& file, const std::vector<T>& section) {
+    const uint64_t offset = BeginSection(file);
+    file.write(reinterpret_cast<const char*>(section.data()),
+               static_cast<std::streamsize>(sizeof(T) * section.size()));
+    return offset;
+}
+
+// Vertex states have padding between their fields, so they are copied field by field into zeroed
+// bytes. Dumping the structs would write whatever the padding held, and the same mesh could bake
+// to different files.
+uint64_t WriteStates(std::ofstream& file, const std::vector<ma::MeshVertexState>& states) {
+    std::vector<std::byte> bytes(sizeof(ma::MeshVertexState) * states.size());
+    const auto put = [&bytes](size_t offset, const auto& field) {
+        std::memcpy(bytes.data() + offset, &field, sizeof(field));
+    };
+    for (size_t i = 0; i < states.size(); ++i) {
+        const ma::MeshVertexState& state = states[i];
+        const size_t stateBase = i * sizeof(ma::MeshVertexState);
+        put(stateBase + offsetof(ma::MeshVertexState, slotCount), state.slotCount);
+        for (size_t s = 0; s < state.bufferSlots.size(); ++s) {
+            const ma::MeshBufferSlot& slot = state.bufferSlots[s];
+            const size_t slotBase = stateBase + offsetof(ma::MeshVertexState, bufferSlots) +
+                                    s * sizeof(ma::MeshBufferSlot);
+            put(slotBase + offsetof(ma::MeshBufferSlot, stepMode), slot.stepMode);
+            put(slotBase + offsetof(ma::MeshBufferSlot, stride), slot.stride);
+            put(slotBase + offsetof(ma::MeshBufferSlot, attributeCount), slot.attributeCount);
+            for (size_t a = 0; a < slot.attributes.size(); ++a) {
+                const ma::MeshAttribute& attribute = slot.attributes[a];
+                const size_t attributeBase = slotBase + offsetof(ma::MeshBufferSlot, attributes) +
+                                             a * sizeof(ma::MeshAttribute);
+                put(attributeBase + offsetof(ma::MeshAttribute, format), attribute.format);
+                put(attributeBase + offsetof(ma::MeshAttribute, semantic), attribute.semantic);
+                put(attributeBase + offsetof(ma::MeshAttribute, offset), attribute.offset);
+            }
+        }
+    }
+    return WriteSection(file, bytes);
+}
+}  // namespace
+
+bool WriteMeshAssetToFile(const fs::path& outputPath, const ma& mesh) {
+    std::ofstream file(outputPath, std::ios::binary);
+    if (!file.is_open()) {
+        std::println(stderr, "Error: Failed to open output file: {}", outputPath.string());
+        return false;
+    }
+
+    ma::Header header;
+    header.stateCount = static_cast<uint16_t>(mesh.states.size());
+    header.bufferRangeCount = static_cast<uint32_t>(mesh.bufferRanges.size());
+    header.subMeshCount = static_cast<uint32_t>(mesh.subMeshes.size());
+    header.subMeshBoundsCount = static_cast<uint32_t>(mesh.subMeshBounds.size());
+    header.indexCount = static_cast<uint32_t>(mesh.indexData.size());
+    header.vertexDataSize = mesh.vertexData.size();
+
+    // First, write a dummy header to reserve space
+    file.write(reinterpret_cast<const char*>(&header), sizeof(ma::Header));
+
+    header.stateOffset = WriteStates(file, mesh.states);
+    header.bufferRangeOffset = WriteSection(file, mesh.bufferRanges);
+    header.subMeshOffset = WriteSection(file, mesh.subMeshes);
+    header.subMeshBoundsOffset = WriteSection(file, mesh.subMeshBounds);
+    header.indexOffset = WriteSection(file, mesh.indexData);
+    header.vertexOffset = WriteSection(file, mesh.vertexData);
+
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(ma::Header));
+    return file.good();
+}
+
+ta BuildMipChain(const ta& texture, MipFilter filter) {
+    assert(texture.channel == 4 && texture.format == core::TextureFormat::RGBA8Unorm &&
+           "BuildMipChain only filters RGBA8 textures");
+    ta baked = texture;
+    baked.mips = ta::GetMaxMipCount(texture.width, texture.height);
+    baked.rowAlignment = ta::kRowPitchAlignment;
+    baked.pixelData.assign(baked.GetPixelDataSize(), 0);
+
+    // Levels are filtered from the unquantized level above, so rounding doesn't accumulate.
+    std::vector<glm::vec4> level(size_t{texture.width} * texture.height);
+    for (size_t i = 0; i < level.size(); ++i) {
+        level[i] = Decode(&texture.pixelData[i * texture.channel], filter);
+    }
+    uint32_t levelWidth = texture.width;
+    for (uint32_t mip = 0; mip < baked.mips; ++mip) {
+        const ta::MipLevel layout = baked.GetMipLevel(mip);
+        if (mip > 0) {
+            // 2x2 box filter; the last row or column of an odd level is reused.
+            std::vector<glm::vec4> next(size_t{layout.width} * layout.height);
+            const uint32_t levelHeight = static_cast<uint32_t>(level.size() / levelWidth);
+            const auto at = [&](uint32_t x, uint32_t y) {
+                return level[size_t{std::min(y, levelHeight - 1)} * levelWidth +
+                             std::min(x, levelWidth - 1)];
+            };
+            for (uint32_t y = 0; y < layout.height; ++y) {
+                for (uint32_t x = 0; x < layout.width; ++x) {
+                    next[size_t{y} * layout.width + x] = (at(x * 2, y * 2) + at(x * 2 + 1, y * 2) +
+                                                          at(x * 2, y * 2 + 1) +
+                                                          at(x * 2 + 1, y * 2 + 1)) *
+                                                         0.25f;
+                }
+            }
+            level = std::move(next);
+            levelWidth = layout.width;
+        }
+        for (uint32_t y = 0; y < layout.height; ++y) {
+            uint8_t* row = &baked.pixelData[layout.offset + size_t{y} * layout.bytesPerRow];
+            for (uint32_t x = 0; x < layout.width; ++x) {
+                Encode(level[size_t{y} * layout.width + x], filter, row + x * baked.channel);
+            }
+        }
+    }
+    return baked;
+}
+
+bool WriteTextureAssetToFile(const fs::path& outputPath, const ta& texture) {
+    std::ofstream file(outputPath, std::ios::binary);
+    if (!file.is_open()) {
+        std::println(stderr, "Error: Failed to open output file: {}", outputPath.string());
+        return false;
+    }
+
+    ta::Header header;
+    header.format = texture.format;
+    header.dimension = texture.dimension;
+    header.width = texture.width;
+    header.height = texture.height;
+    header.depth = texture.depth;
+    header.mips = texture.mips;
+    header.channel = texture.channel;
+    header.rowAlignment = texture.rowAlignment;
+    header.pixelDataOffset = sizeof(ta::Header);
+    header.pixelDataSize = texture.pixelData.size();
+    static_assert(sizeof(ta::Header) % ta::kSectionAlignment == 0);
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(ta::Header));
+    file.write(reinterpret_cast<const char*>(texture.pixelData.data()),
+               static_cast<std::streamsize>(texture.pixelData.size()));
+    return file.good();
+}
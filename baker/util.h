@@ -0,0 +1,24 @@
+#pragma once
+#include <filesystem>
+#include "MeshAssetFormat.h"
+#include "TextureAssetFormat.h"
+
+// How texels are averaged into the next mip level.
+enum class MipFilter {
+    Linear,
+    // Color data; averaged in linear light so mips don't darken.
+    Srgb,
+    // Tangent-space normals; averaged vectors are renormalized.
+    Normal,
+};
+
+// Writes mesh as a .mesh file MappedMeshAsset::LoadFromMemory can read.
+bool WriteMeshAssetToFile(const std::filesystem::path& outputPath,
+                          const core::MeshAssetFormat& mesh);
+
+// Builds the full mip chain of a tightly packed RGBA8 texture, with rows padded to
+// TextureAssetFormat::kRowPitchAlignment. Other channel counts are a programming error.
+core::TextureAssetFormat BuildMipChain(const core::TextureAssetFormat& texture, MipFilter filter);
+// Writes texture as a .tex file MappedTextureAsset::LoadFromMemory can read.
+bool WriteTextureAssetToFile(const std::filesystem::path& outputPath,
+                             const core::TextureAssetFormat& texture);
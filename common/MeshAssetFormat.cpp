@@ -0,0 +1,127 @@
+#include "MeshAssetFormat.h"
+#include <cstring>
+#include <format>
+
+namespace {
+// True if count elements of T starting at offset fit in memory and offset is section aligned.
+template <typename T>
+bool IsSectionValid(std::span<const uint8_t> memory, uint64_t offset, uint64_t count) {
+    if (offset % core::MeshAssetFormat::kSectionAlignment != 0 || offset > memory.size()) {
+        return false;
+    }
+    return count <= (memory.size() - offset) / sizeof(T);
+}
+
+// True if state only uses slots, attributes and enum values a pipeline can be built from.
+bool IsVertexStateValid(const core::MeshAssetFormat::MeshVertexState& state) {
+    using VertexFormat = core::MeshAssetFormat::VertexFormat;
+    using StepMode = core::MeshAssetFormat::StepMode;
+    if (state.slotCount > state.bufferSlots.size()) {
+        return false;
+    }
+    for (uint8_t i = 0; i < state.slotCount; ++i) {
+        const core::MeshAssetFormat::MeshBufferSlot& slot = state.bufferSlots[i];
+        if ((slot.stepMode != StepMode::Vertex && slot.stepMode != StepMode::Instance) ||
+            slot.attributeCount > slot.attributes.size()) {
+            return false;
+        }
+        for (uint8_t j = 0; j < slot.attributeCount; ++j) {
+            if (slot.attributes[j].format > VertexFormat::Float32x4) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <typename T>
+std::vector<T> ReadSection(std::span<const uint8_t> memory, uint64_t offset, uint64_t count) {
+    std::vector<T> section(count);
+    if (count > 0) {
+        std::memcpy(section.data(), memory.data() + offset, sizeof(T) * count);
+    }
+    return section;
+}
+}  // namespace
+
+std::expected<core::MappedMeshAsset, core::Error> core::MappedMeshAsset::LoadFromMemory(
+    std::span<const uint8_t> memory) {
+    using Header = MeshAssetFormat::Header;
+    using MeshVertexState = MeshAssetFormat::MeshVertexState;
+    using BufferRange = MeshAssetFormat::BufferRange;
+    using SubMeshInfo = MeshAssetFormat::SubMeshInfo;
+    using SubMeshBounds = MeshAssetFormat::SubMeshBounds;
+
+    if (memory.size() < sizeof(Header)) {
+        return std::unexpected(Error::Parse("Buffer too small for header"));
+    }
+    Header header;
+    std::memcpy(&header, memory.data(), sizeof(Header));
+
+    if (header.magicNumber != MeshAssetFormat::MESH_ASSET_MAGIC) {
+        return std::unexpected(Error::AssetParsing(
+            std::format("Invalid Magic Number: expected {:#x}, but got {:#x}",
+                        MeshAssetFormat::MESH_ASSET_MAGIC, header.magicNumber)));
+    }
+    if (header.version != MeshAssetFormat::MESH_ASSET_VERSION) {
+        return std::unexpected(Error::AssetParsing(
+            std::format("Unsupported Version: version {} is not supported (current: {}).",
+                        header.version, MeshAssetFormat::MESH_ASSET_VERSION)));
+    }
+
+    const bool sectionsValid =
+        IsSectionValid<MeshVertexState>(memory, header.stateOffset, header.stateCount) &&
+        IsSectionValid<BufferRange>(memory, header.bufferRangeOffset, header.bufferRangeCount) &&
+        IsSectionValid<SubMeshInfo>(memory, header.subMeshOffset, header.subMeshCount) &&
+        IsSectionValid<SubMeshBounds>(memory, header.subMeshBoundsOffset,
+                                      header.subMeshBoundsCount) &&
+        IsSectionValid<uint32_t>(memory, header.indexOffset, header.indexCount) &&
+        IsSectionValid<std::byte>(memory, header.vertexOffset, header.vertexDataSize);
+    if (!sectionsValid) {
+        return std::unexpected(Error::AssetParsing(
+            "Corrupted Asset: actual data size does not match header description"));
+    }
+
+    MappedMeshAsset mesh;
+    MeshAssetFormat& format = mesh.format;
+    format.states = ReadSection<MeshVertexState>(memory, header.stateOffset, header.stateCount);
+    format.bufferRanges =
+        ReadSection<BufferRange>(memory, header.bufferRangeOffset, header.bufferRangeCount);
+    format.subMeshes =
+        ReadSection<SubMeshInfo>(memory, header.subMeshOffset, header.subMeshCount);
+    format.subMeshBounds = ReadSection<SubMeshBounds>(memory, header.subMeshBoundsOffset,
+                                                      header.subMeshBoundsCount);
+    mesh.indexData = std::span(
+        reinterpret_cast<const uint32_t*>(memory.data() + header.indexOffset), header.indexCount);
+    mesh.vertexData = std::span(
+        reinterpret_cast<const std::byte*>(memory.data() + header.vertexOffset),
+        header.vertexDataSize);
+
+    for (const MeshVertexState& state : format.states) {
+        if (!IsVertexStateValid(state)) {
+            return std::unexpected(
+                Error::AssetParsing("Corrupted Asset: vertex state is out of range"));
+        }
+    }
+    // Submeshes index into the other sections; reject files that would make a draw read past
+    // them.
+    for (const SubMeshInfo& subMesh : format.subMeshes) {
+        const bool inRange =
+            subMesh.stateIndex < format.states.size() &&
+            uint64_t{subMesh.indexStart} + subMesh.indexCount <= header.indexCount &&
+            uint64_t{subMesh.bufferRangeStart} + subMesh.bufferRangeCount <=
+                format.bufferRanges.size();
+        if (!inRange) {
+            return std::unexpected(
+                Error::AssetParsing("Corrupted Asset: submesh references data out of range"));
+        }
+    }
+    for (const BufferRange& range : format.bufferRanges) {
+        if (range.offset > header.vertexDataSize ||
+            range.size > header.vertexDataSize - range.offset) {
+            return std::unexpected(
+                Error::AssetParsing("Corrupted Asset: buffer range exceeds vertex data"));
+        }
+    }
+    return mesh;
+}
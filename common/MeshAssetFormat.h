@@ -1,6 +1,12 @@
 #pragma once
 
 #include <array>
+#include <cassert>
+#include <cstddef>
+#include <expected>
+#include <span>
+#include <type_traits>
+#include <vector>
 #include <glm/glm.hpp>
 
 #include "Common.h"
@@ -10,6 +16,11 @@ namespace core {
 struct MeshAssetFormat {
     inline constexpr static uint32_t kInvalidIndex = -1;
 
+    static constexpr uint32_t MESH_ASSET_MAGIC = 0x4853454D;  // "MESH"
+    static constexpr uint16_t MESH_ASSET_VERSION = 1;
+    // Every section of a baked file starts at a multiple of this.
+    static constexpr uint64_t kSectionAlignment = 16;
+
     enum class VertexFormat : uint8_t { Float32, Float32x2, Float32x3, Float32x4, Undefined = 255 };
 
     enum class StepMode : uint8_t { Vertex, Instance, Undefined = 255 };
@@ -63,6 +74,14 @@ struct MeshAssetFormat {
         uint32_t bufferRangeCount;
     };
 
+    // Object-space bounds of the vertices a submesh references.
+    struct SubMeshBounds {
+        glm::vec3 aabbMin;
+        glm::vec3 aabbMax;
+        glm::vec3 sphereCenter;
+        float sphereRadius;
+    };
+
     static constexpr size_t GetVertexFormatSize(VertexFormat format) {
         switch (format) {
             case VertexFormat::Float32x2:
@@ -77,10 +96,45 @@ struct MeshAssetFormat {
         }
     }
 
+    // Header of a baked .mesh file. Each section is a plain array of the matching member below,
+    // so index and vertex data can be uploaded straight from a mapping of the file.
+    struct alignas(16) Header {
+        uint32_t magicNumber = MESH_ASSET_MAGIC;
+        uint16_t version = MESH_ASSET_VERSION;
+        uint16_t stateCount = 0;
+        uint32_t bufferRangeCount = 0;
+        uint32_t subMeshCount = 0;
+        uint32_t subMeshBoundsCount = 0;
+        uint32_t indexCount = 0;
+        uint64_t vertexDataSize = 0;
+        uint64_t stateOffset = 0;
+        uint64_t bufferRangeOffset = 0;
+        uint64_t subMeshOffset = 0;
+        uint64_t subMeshBoundsOffset = 0;
+        uint64_t indexOffset = 0;
+        uint64_t vertexOffset = 0;
+    };
+    static_assert(sizeof(Header) == 80);
+    static_assert(std::is_trivially_copyable_v<MeshVertexState> &&
+                  std::is_trivially_copyable_v<SubMeshBounds>);
+
     std::vector<MeshVertexState> states;
     std::vector<BufferRange> bufferRanges;
     std::vector<SubMeshInfo> subMeshes;
+    // Parallel to subMeshes.
+    std::vector<SubMeshBounds> subMeshBounds;
     std::vector<uint32_t> indexData;
     std::vector<std::byte> vertexData;
 };
+
+// A baked mesh read from memory without copying its index and vertex data. indexData and
+// vertexData of format stay empty; the spans point into the memory instead, which has to
+// outlive them.
+struct MappedMeshAsset {
+    MeshAssetFormat format;
+    std::span<const uint32_t> indexData;
+    std::span<const std::byte> vertexData;
+
+    static std::expected<MappedMeshAsset, Error> LoadFromMemory(std::span<const uint8_t> memory);
+};
 }  // namespace core
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include "TextureAssetFormat.h"
+#include <cstring>
+#include <format>
+
+namespace {
+// Keeps row and level sizes far from overflowing; well above any WebGPU texture limit.
+constexpr uint32_t kMaxExtent = 1u << 16;
+}  // namespace
+
+std::expected<core::MappedTextureAsset, core::Error> core::MappedTextureAsset::LoadFromMemory(
+    std::span<const uint8_t> memory) {
+    using Header = TextureAssetFormat::Header;
+
+    if (memory.size() < sizeof(Header)) {
+        return std::unexpected(Error::Parse("Buffer too small for header"));
+    }
+    Header header;
+    std::memcpy(&header, memory.data(), sizeof(Header));
+
+    if (header.magicNumber != TextureAssetFormat::TEXTURE_ASSET_MAGIC) {
+        return std::unexpected(Error::AssetParsing(
+            std::format("Invalid Magic Number: expected {:#x}, but got {:#x}",
+                        TextureAssetFormat::TEXTURE_ASSET_MAGIC, header.magicNumber)));
+    }
+    if (header.version != TextureAssetFormat::TEXTURE_ASSET_VERSION) {
+        return std::unexpected(Error::AssetParsing(
+            std::format("Unsupported Version: version {} is not supported (current: {}).",
+                        header.version, TextureAssetFormat::TEXTURE_ASSET_VERSION)));
+    }
+    if (header.format != TextureFormat::RGBA8Unorm || header.channel != 4 ||
+        header.dimension != TextureDimension::e2D || header.depth != 1) {
+        return std::unexpected(Error::AssetParsing("Unsupported texture layout"));
+    }
+    if (header.width == 0 || header.height == 0 || header.width > kMaxExtent ||
+        header.height > kMaxExtent || header.mips == 0 ||
+        header.mips > TextureAssetFormat::GetMaxMipCount(header.width, header.height) ||
+        header.rowAlignment == 0 ||
+        header.rowAlignment % TextureAssetFormat::kRowPitchAlignment != 0) {
+        return std::unexpected(Error::AssetParsing("Corrupted Asset: invalid texture extent"));
+    }
+
+    MappedTextureAsset texture;
+    texture.format = TextureAssetFormat{
+        .width = header.width,
+        .height = header.height,
+        .depth = header.depth,
+        .mips = header.mips,
+        .channel = header.channel,
+        .rowAlignment = header.rowAlignment,
+        .format = header.format,
+        .dimension = header.dimension,
+        .pixelData = {},
+    };
+
+    const uint64_t offset = header.pixelDataOffset;
+    if (header.pixelDataSize != texture.format.GetPixelDataSize() ||
+        offset % TextureAssetFormat::kSectionAlignment != 0 || offset > memory.size() ||
+        header.pixelDataSize > memory.size() - offset) {
+        return std::unexpected(Error::AssetParsing(
+            "Corrupted Asset: actual data size does not match header description"));
+    }
+    texture.pixelData = memory.subspan(offset, header.pixelDataSize);
+    return texture;
+}
@@ -1,6 +1,12 @@
 #pragma once
+#include <algorithm>
+#include <cstdint>
+#include <expected>
+#include <span>
 #include <vector>
 
+#include "Common.h"
+
 namespace core {
 
 enum class TextureFormat : uint8_t {
@@ -11,15 +17,91 @@ enum class TextureFormat : uint8_t {
 enum class TextureDimension : uint8_t { e2D, Unknown };
 
 struct TextureAssetFormat {
+    static constexpr uint32_t TEXTURE_ASSET_MAGIC = 0x52584554;  // "TEXR"
+    static constexpr uint16_t TEXTURE_ASSET_VERSION = 1;
+    // Row pitch buffer-to-texture copies require; baked textures pad every row to it.
+    static constexpr uint32_t kRowPitchAlignment = 256;
+    // Pixel data of a baked file starts at a multiple of this.
+    static constexpr uint64_t kSectionAlignment = 16;
+
     uint32_t width = 0;
     uint32_t height = 0;
     uint32_t depth = 1;
     uint32_t mips = 1;
     uint32_t channel;
+    // Every row of pixelData starts at a multiple of this. Imported textures are tightly packed.
+    uint32_t rowAlignment = 1;
 
     TextureFormat format = TextureFormat::RGBA8Unorm;
     TextureDimension dimension = TextureDimension::e2D;
 
+    // All mip levels, largest first, each directly after the previous one.
     std::vector<uint8_t> pixelData;
+
+    struct MipLevel {
+        uint32_t width;
+        uint32_t height;
+        uint32_t bytesPerRow;
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    static constexpr uint32_t GetMipExtent(uint32_t extent, uint32_t level) {
+        return std::max(extent >> level, 1u);
+    }
+    // Length of the full mip chain for a width x height texture.
+    static constexpr uint32_t GetMaxMipCount(uint32_t width, uint32_t height) {
+        uint32_t count = 1;
+        while ((std::max(width, height) >> count) > 0) {
+            ++count;
+        }
+        return count;
+    }
+
+    MipLevel GetMipLevel(uint32_t level) const {
+        uint64_t offset = 0;
+        for (uint32_t i = 0;; ++i) {
+            const uint32_t levelWidth = GetMipExtent(width, i);
+            const uint32_t levelHeight = GetMipExtent(height, i);
+            const uint32_t rowSize = levelWidth * channel;
+            const uint32_t bytesPerRow = (rowSize + rowAlignment - 1) / rowAlignment * rowAlignment;
+            const uint64_t size = uint64_t{bytesPerRow} * levelHeight * depth;
+            if (i == level) {
+                return MipLevel{levelWidth, levelHeight, bytesPerRow, offset, size};
+            }
+            offset += size;
+        }
+    }
+    uint64_t GetPixelDataSize() const {
+        const MipLevel last = GetMipLevel(mips - 1);
+        return last.offset + last.size;
+    }
+
+    // Header of a baked .tex file; the pixel data follows at pixelDataOffset.
+    struct alignas(16) Header {
+        uint32_t magicNumber = TEXTURE_ASSET_MAGIC;
+        uint16_t version = TEXTURE_ASSET_VERSION;
+        TextureFormat format = TextureFormat::RGBA8Unorm;
+        TextureDimension dimension = TextureDimension::e2D;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t depth = 1;
+        uint32_t mips = 1;
+        uint32_t channel = 4;
+        uint32_t rowAlignment = kRowPitchAlignment;
+        uint64_t pixelDataOffset = 0;
+        uint64_t pixelDataSize = 0;
+    };
+    static_assert(sizeof(Header) == 48);
+};
+
+// A baked texture read from memory without copying its pixels. pixelData of format stays empty;
+// the span points into the memory instead, which has to outlive it.
+struct MappedTextureAsset {
+    TextureAssetFormat format;
+    std::span<const uint8_t> pixelData;
+
+    static std::expected<MappedTextureAsset, Error> LoadFromMemory(
+        std::span<const uint8_t> memory);
 };
 }  // namespace core
@@ -1,5 +1,12 @@
 #include "Application.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <print>
 #include <ranges>
+#include <string_view>
+#include <thread>
+#include "util/CpuProfiler.h"
 
 namespace core {
 
@@ -53,14 +60,22 @@ std::expected<Application, int> core::Application::Create(ApplicationSpec& spec)
 
     Window window = std::move(re.value());
     std::unique_ptr<render::Device> device = render::Device::Create(window);
+    if (device == nullptr) {
+        std::cerr << "Failed to create a WebGPU device" << '\n';
+        return std::unexpected(-1);
+    }
     auto assetManager = std::make_unique<AssetManager>(AssetManager::Create());
     auto globalBindGroupLayout = GetGlobalLayouDesc();
 
-    auto sceneRenderer = std::make_unique<render::SceneRenderer>(device.get(), assetManager.get(),
-                                                                 globalBindGroupLayout);
+    // The main thread takes part in every parallel loop, so it needs no worker of its own.
+    auto jobSystem = std::make_unique<util::JobSystem>(
+        std::max(1u, std::thread::hardware_concurrency()) - 1);
+
+    auto sceneRenderer = std::make_unique<render::SceneRenderer>(
+        device.get(), assetManager.get(), jobSystem.get(), globalBindGroupLayout);
 
     return Application(std::move(window), std::move(device), std::move(assetManager),
-                       std::move(eventDispatcher), std::move(sceneRenderer));
+                       std::move(eventDispatcher), std::move(jobSystem), std::move(sceneRenderer));
 }
 
 core::Application::~Application() {}
@@ -74,16 +89,39 @@ void core::Application::Run() {
 
     m_sceneRenderer->Setup(passIDs);
 
+    if (const char* env = std::getenv("ENGINE_CAPTURE_FRAMES")) {
+        const std::string_view value(env);
+        uint32_t frames = 0;
+        if (std::from_chars(value.data(), value.data() + value.size(), frames).ec == std::errc{} &&
+            frames > 0) {
+            m_captureFrames = frames;
+            BeginProfileCapture();
+        }
+    }
+
     while (!m_souldColose) {
+        ENGINE_PROFILE_SCOPE("Frame");
         m_window.PollEvent();
         m_eventDispatcher->ProcessEvent([this](auto&& event) -> void { this->RaiseEvent(event); });
 
         for (auto& layer : m_Layers) {
+            ENGINE_PROFILE_SCOPE("Layer::OnUpdate");
             layer->OnUpdate(m_scene);
         }
 
-        m_sceneRenderer->Render(m_scene, passIDs);
-        m_device->Present();
+        ApplyPendingResize();
+
+        // A skipped frame keeps the dirty range so the next frame still uploads it.
+        if (m_sceneRenderer->Render(m_scene)) {
+            m_scene.ClearDirtyTransforms();
+            m_device->Present();
+        } else if (m_pendingResize.has_value()) {
+            // Nothing renders until the resize settles, so sleep until then or the next event
+            // instead of spinning through skipped frames.
+            m_window.WaitEvent(kResizeSettleTime -
+                               (std::chrono::steady_clock::now() - m_lastResizeTime));
+        }
+        UpdateProfileCapture();
     }
 
     glfwTerminate();
@@ -94,7 +132,77 @@ void core::Application::AttachLayer(std::unique_ptr<Layer> layer) {
     m_Layers.emplace_back(std::move(layer));
 }
 
+void Application::ApplyPendingResize() {
+    if (!m_pendingResize.has_value() ||
+        std::chrono::steady_clock::now() - m_lastResizeTime < kResizeSettleTime) {
+        return;
+    }
+    const event::WindowResizeEvent resize = *m_pendingResize;
+    m_pendingResize.reset();
+    m_sceneRenderer->Resize(resize.width, resize.height);
+}
+
+void Application::BeginProfileCapture() {
+    if (m_captureFramesLeft > 0 || m_gpuCaptureDrainFrames > 0) {
+        return;
+    }
+    m_captureFramesLeft = m_captureFrames;
+    util::CpuProfiler::BeginCapture();
+
+    render::GpuProfiler* gpuProfiler = m_sceneRenderer->GetGpuProfiler();
+    m_gpuProfilerWasEnabled = gpuProfiler->IsEnabled();
+    gpuProfiler->SetEnabled(true);
+    gpuProfiler->BeginCapture();
+}
+
+void Application::UpdateProfileCapture() {
+    if (m_captureFramesLeft > 0) {
+        if (--m_captureFramesLeft == 0) {
+            util::CpuProfiler::EndCapture();
+            m_gpuCaptureDrainFrames = render::GpuProfiler::kFramesInFlight;
+        }
+        return;
+    }
+    if (m_gpuCaptureDrainFrames == 0 || --m_gpuCaptureDrainFrames > 0) {
+        return;
+    }
+
+    render::GpuProfiler* gpuProfiler = m_sceneRenderer->GetGpuProfiler();
+    gpuProfiler->EndCapture();
+    gpuProfiler->SetEnabled(m_gpuProfilerWasEnabled);
+
+    if (auto result = util::CpuProfiler::WriteChromeTrace("cpu_trace.json"); !result) {
+        std::println("Failed to write cpu_trace.json: {}", result.error().message);
+    }
+    if (!gpuProfiler->IsSupported()) {
+        std::println("Captured {} frames to cpu_trace.json; timestamp queries are unsupported",
+                     m_captureFrames);
+        return;
+    }
+    if (auto result = gpuProfiler->WriteChromeTrace("gpu_trace.json"); !result) {
+        std::println("Failed to write gpu_trace.json: {}", result.error().message);
+    }
+    std::println("Captured {} frames to cpu_trace.json and gpu_trace.json", m_captureFrames);
+}
+
 void Application::RaiseEvent(Event& event) {
+    if (const auto* resize = std::get_if<event::WindowResizeEvent>(&event)) {
+        // A minimized window reports a zero sized framebuffer, which can't back a surface.
+        const auto& config = m_device->GetSurfaceConfig();
+        if (resize->width != 0 && resize->height != 0 &&
+            (resize->width != config.width || resize->height != config.height)) {
+            // Reconfiguring is cheap and keeps the surface from going outdated; only the
+            // transient reallocation waits for the window to settle.
+            m_device->Resize(resize->width, resize->height);
+            m_pendingResize = *resize;
+            m_lastResizeTime = std::chrono::steady_clock::now();
+        }
+    }
+    if (const auto* key = std::get_if<event::KeyPressEvent>(&event);
+        key != nullptr && key->keyCode == event::KeyCode::F12) {
+        BeginProfileCapture();
+    }
+
     for (auto& layer : std::views::reverse(m_Layers)) {
         bool catched = layer->OnEvent(event);
         if (catched) {
@@ -1,5 +1,7 @@
 #pragma once
+#include <chrono>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "AssetManager.h"
@@ -7,6 +9,7 @@
 #include "Window.h"
 #include "render/SceneRenderer.h"
 #include "render/render.h"
+#include "util/JobSystem.h"
 
 namespace core {
 
@@ -33,6 +36,10 @@ class Application {
     render::MaterialManager* GetMaterialManager() { return m_sceneRenderer->GetMaterialManager(); }
     render::MeshManager* GetMeshManager() { return m_sceneRenderer->GetMeshManager(); }
     render::Device* GetDevice() { return m_device.get(); }
+    // Shared by the renderer and layers for anything that runs in parallel.
+    util::JobSystem* GetJobSystem() { return m_jobSystem.get(); }
+    // Layers update before the frame renders, so this describes the previous frame.
+    const render::FrameStats& GetFrameStats() const { return m_sceneRenderer->GetFrameStats(); }
 
     static wgpu::BindGroupLayoutDescriptor GetGlobalLayouDesc();
 
@@ -46,22 +53,48 @@ class Application {
                 std::unique_ptr<render::Device> device,
                 std::unique_ptr<AssetManager> assetManager,
                 std::unique_ptr<EventDispatcher> eventDispatcher,
+                std::unique_ptr<util::JobSystem> jobSystem,
                 std::unique_ptr<render::SceneRenderer> sceneRenderer)
         : m_window(std::move(window)),
           m_device(std::move(device)),
           m_assetManager(std::move(assetManager)),
           m_eventDispatcher(std::move(eventDispatcher)),
+          m_jobSystem(std::move(jobSystem)),
           m_sceneRenderer(std::move(sceneRenderer)) {}
 
     Window m_window;
     std::unique_ptr<render::Device> m_device;
     std::unique_ptr<AssetManager> m_assetManager;
     std::unique_ptr<EventDispatcher> m_eventDispatcher;
+    // Declared before everything that submits jobs, so it is destroyed after them.
+    std::unique_ptr<util::JobSystem> m_jobSystem;
 
     std::unique_ptr<render::SceneRenderer> m_sceneRenderer;
     Scene m_scene;
 
     std::vector<std::unique_ptr<Layer>> m_Layers;
     bool m_souldColose = false;
+
+    // Dragging a window edge fires a resize event per frame. The surface follows every event,
+    // but the renderer only sees the latest size once no new event arrived for
+    // kResizeSettleTime, so transients are reallocated once. Frames in between are skipped.
+    static constexpr std::chrono::milliseconds kResizeSettleTime{100};
+    std::optional<event::WindowResizeEvent> m_pendingResize;
+    std::chrono::steady_clock::time_point m_lastResizeTime;
+
+    void ApplyPendingResize();
+
+    // Profiling capture of m_captureFrames frames, started with F12 or at launch by setting
+    // ENGINE_CAPTURE_FRAMES=<frames>. CPU and GPU zones are written as Chrome traces to
+    // cpu_trace.json and gpu_trace.json in the working directory.
+    static constexpr uint32_t kDefaultCaptureFrames = 60;
+    uint32_t m_captureFrames = kDefaultCaptureFrames;
+    uint32_t m_captureFramesLeft = 0;
+    // GPU timings are read back a few frames late, so its capture stays open a little longer.
+    uint32_t m_gpuCaptureDrainFrames = 0;
+    bool m_gpuProfilerWasEnabled = false;
+
+    void BeginProfileCapture();
+    void UpdateProfileCapture();
 };
 }  // namespace core
@@ -6,6 +6,7 @@
 
 #include "event/InputEvent.h"
 #include "event/WindowEvent.h"
+#include "util/CpuProfiler.h"
 
 namespace core {
 using Event = std::variant<event::KeyPressEvent,
@@ -33,6 +34,7 @@ class EventDispatcher {
         if (m_commandBuffer.empty()) {
             return;
         }
+        ENGINE_PROFILE_SCOPE("EventDispatcher::ProcessEvent");
         std::swap(m_commandBuffer, m_processingBuffer);
 
         for (auto& e : m_processingBuffer) {
@@ -1,4 +1,5 @@
 #pragma once
+#include <algorithm>
 #include "render/render.h"
 #include "render/resource/Model.h"
 
@@ -7,10 +8,37 @@ struct Scene {
     render::CameraUniformData cameraData;
     std::vector<AssetView<render::Model>> models;
     std::vector<glm::mat4x4> modelMatrices;
+    // modelMatrices[dirtyTransformBegin, dirtyTransformEnd) covers every entry changed since the
+    // last ClearDirtyTransforms; the renderer uploads only that range. Code that writes
+    // modelMatrices directly has to call MarkTransformsDirty.
+    uint32_t dirtyTransformBegin = 0;
+    uint32_t dirtyTransformEnd = 0;
 
     void AddModel(const AssetView<render::Model>& model, const glm::mat4x4& transform) {
         models.push_back(model);
         modelMatrices.push_back(transform);
+        const auto index = static_cast<uint32_t>(modelMatrices.size() - 1);
+        MarkTransformsDirty(index, index + 1);
+    }
+
+    void SetModelMatrix(uint32_t index, const glm::mat4x4& transform) {
+        modelMatrices[index] = transform;
+        MarkTransformsDirty(index, index + 1);
+    }
+
+    void MarkTransformsDirty(uint32_t begin, uint32_t end) {
+        if (dirtyTransformBegin >= dirtyTransformEnd) {
+            dirtyTransformBegin = begin;
+            dirtyTransformEnd = end;
+            return;
+        }
+        dirtyTransformBegin = std::min(dirtyTransformBegin, begin);
+        dirtyTransformEnd = std::max(dirtyTransformEnd, end);
+    }
+
+    void ClearDirtyTransforms() {
+        dirtyTransformBegin = 0;
+        dirtyTransformEnd = 0;
     }
 };
 }  // namespace core
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "Window.h"
+#include <algorithm>
 #include <print>
 
 static core::event::KeyCode GlfwToMyKeycode(int key) {
@@ -86,6 +87,12 @@ std::expected<Window, int> core::Window::Create(WindowSpec& spec) {
         dispatcher->Post(event::WindowCloseEvent{});
     });
 
+    glfwSetFramebufferSizeCallback(window, [](GLFWwindow* window, int width, int height) {
+        EventDispatcher* dispatcher = static_cast<EventDispatcher*>(glfwGetWindowUserPointer(window));
+        dispatcher->Post(event::WindowResizeEvent{.width = static_cast<uint32_t>(width),
+                                                  .height = static_cast<uint32_t>(height)});
+    });
+
     glfwSetScrollCallback(window, [](GLFWwindow* window, double xoffset, double yoffset) {
         EventDispatcher* dispatcher = static_cast<EventDispatcher*>(glfwGetWindowUserPointer(window));
         dispatcher->Post(event::ScrollEvent{.xoffset = xoffset, .yoffset = yoffset});
@@ -114,5 +121,9 @@ void Window::PollEvent() {
     glfwPollEvents();
 }
 
+void Window::WaitEvent(std::chrono::duration<double> timeout) {
+    glfwWaitEventsTimeout(std::max(timeout.count(), 0.0));
+}
+
 Window::~Window() {}
 }  // namespace core
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <expected>
 #include <functional>
 #include <memory>
@@ -42,6 +43,8 @@ class Window {
     uint32_t GetWidth() const { return m_spec.width; }
     uint32_t GetHeight() const { return m_spec.height; }
     void PollEvent();
+    // Like PollEvent, but first sleeps until an event arrives or the timeout passes.
+    void WaitEvent(std::chrono::duration<double> timeout);
 
   private:
     Window(GLFWwindow* window, WindowSpec spec) : m_spec(spec), m_window(window) {}
@@ -0,0 +1,93 @@
+#pragma once
+#include <tiny_gltf.h>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace bench {
+
+namespace detail {
+template <typename T>
+int AppendAccessor(tinygltf::Model& model,
+                   const std::vector<T>& values,
+                   int componentType,
+                   int type,
+                   size_t count) {
+    tinygltf::Buffer& buffer = model.buffers[0];
+    const size_t byteOffset = buffer.data.size();
+    const size_t byteLength = values.size() * sizeof(T);
+    buffer.data.resize(byteOffset + byteLength);
+    std::memcpy(buffer.data.data() + byteOffset, values.data(), byteLength);
+
+    tinygltf::BufferView view;
+    view.buffer = 0;
+    view.byteOffset = byteOffset;
+    view.byteLength = byteLength;
+    model.bufferViews.push_back(view);
+
+    tinygltf::Accessor accessor;
+    accessor.bufferView = static_cast<int>(model.bufferViews.size() - 1);
+    accessor.componentType = componentType;
+    accessor.type = type;
+    accessor.count = count;
+    model.accessors.push_back(accessor);
+    return static_cast<int>(model.accessors.size() - 1);
+}
+}  // namespace detail
+
+// A glTF model holding one flat grid mesh of quadsPerSide^2 quads, with the POSITION, NORMAL,
+// TEXCOORD_0 and TANGENT attributes and 32-bit indices that GLTFImporter::ImportMesh expects.
+inline tinygltf::Model MakeGridModel(uint32_t quadsPerSide) {
+    const uint32_t side = quadsPerSide + 1;
+    const size_t vertexCount = static_cast<size_t>(side) * side;
+
+    std::vector<float> positions;
+    std::vector<float> normals;
+    std::vector<float> texCoords;
+    std::vector<float> tangents;
+    positions.reserve(vertexCount * 3);
+    normals.reserve(vertexCount * 3);
+    texCoords.reserve(vertexCount * 2);
+    tangents.reserve(vertexCount * 4);
+    for (uint32_t y = 0; y < side; ++y) {
+        for (uint32_t x = 0; x < side; ++x) {
+            const float u = static_cast<float>(x) / static_cast<float>(quadsPerSide);
+            const float v = static_cast<float>(y) / static_cast<float>(quadsPerSide);
+            positions.insert(positions.end(), {u - 0.5f, 0.0f, v - 0.5f});
+            normals.insert(normals.end(), {0.0f, 1.0f, 0.0f});
+            texCoords.insert(texCoords.end(), {u, v});
+            tangents.insert(tangents.end(), {1.0f, 0.0f, 0.0f, 1.0f});
+        }
+    }
+
+    std::vector<uint32_t> indices;
+    indices.reserve(static_cast<size_t>(quadsPerSide) * quadsPerSide * 6);
+    for (uint32_t y = 0; y < quadsPerSide; ++y) {
+        for (uint32_t x = 0; x < quadsPerSide; ++x) {
+            const uint32_t i = y * side + x;
+            indices.insert(indices.end(), {i, i + side, i + 1, i + 1, i + side, i + side + 1});
+        }
+    }
+
+    tinygltf::Model model;
+    model.buffers.resize(1);
+    tinygltf::Primitive primitive;
+    primitive.mode = TINYGLTF_MODE_TRIANGLES;
+    primitive.attributes["POSITION"] = detail::AppendAccessor(
+        model, positions, TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_TYPE_VEC3, vertexCount);
+    primitive.attributes["NORMAL"] = detail::AppendAccessor(
+        model, normals, TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_TYPE_VEC3, vertexCount);
+    primitive.attributes["TEXCOORD_0"] = detail::AppendAccessor(
+        model, texCoords, TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_TYPE_VEC2, vertexCount);
+    primitive.attributes["TANGENT"] = detail::AppendAccessor(
+        model, tangents, TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_TYPE_VEC4, vertexCount);
+    primitive.indices = detail::AppendAccessor(model, indices,
+                                               TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT,
+                                               TINYGLTF_TYPE_SCALAR, indices.size());
+
+    tinygltf::Mesh mesh;
+    mesh.primitives.push_back(std::move(primitive));
+    model.meshes.push_back(std::move(mesh));
+    return model;
+}
+}  // namespace bench
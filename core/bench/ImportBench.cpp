@@ -0,0 +1,50 @@
+#include <benchmark/benchmark.h>
+#include <span>
+
+#include "GeneratedMesh.h"
+#include "ShaderAssetFormat.h"
+#include "asset/StandardPBR.h"
+#include "import/GLTFImporter.h"
+
+// Asset parsing on the CPU only; no device is created.
+
+namespace {
+using namespace core;
+
+void BM_ShaderAssetLoadFromMemory(benchmark::State& state) {
+    const std::span<const uint8_t> blob(kStandardPBR_Data.data(), kStandardPBR_Data.size());
+    for (auto _ : state) {
+        auto shaderOrError = ShaderAssetFormat::LoadFromMemory(blob);
+        if (!shaderOrError.has_value()) {
+            state.SkipWithError("Failed to parse the embedded StandardPBR shader");
+            return;
+        }
+        benchmark::DoNotOptimize(shaderOrError.value());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(blob.size()));
+}
+BENCHMARK(BM_ShaderAssetLoadFromMemory)->Unit(benchmark::kMicrosecond);
+
+// Args: {quads per grid side}
+void BM_GLTFImportMesh(benchmark::State& state) {
+    const tinygltf::Model model = bench::MakeGridModel(static_cast<uint32_t>(state.range(0)));
+    const tinygltf::Mesh& mesh = model.meshes[0];
+    for (auto _ : state) {
+        auto meshOrError = importer::GLTFImporter::ImportMesh(model, mesh);
+        if (!meshOrError.has_value()) {
+            state.SkipWithError("ImportMesh failed on the generated grid");
+            return;
+        }
+        benchmark::DoNotOptimize(meshOrError.value());
+    }
+    const int64_t side = state.range(0) + 1;
+    state.SetItemsProcessed(state.iterations() * side * side);
+    state.counters["vertices"] = static_cast<double>(side * side);
+}
+BENCHMARK(BM_GLTFImportMesh)
+    ->Arg(32)
+    ->Arg(256)
+    ->Arg(1024)
+    ->ArgName("quadsPerSide")
+    ->Unit(benchmark::kMicrosecond);
+}  // namespace
@@ -0,0 +1,161 @@
+#include <benchmark/benchmark.h>
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "render/backend/CommandRecorder.h"
+#include "render/pass/ForwardRenderPass.h"
+#include "render/render.h"
+#include "util/JobSystem.h"
+
+// Measures the CPU cost of recording and submitting one forward pass as the recording thread
+// count grows. Intents are synthetic (one triangle each) so the GPU side stays negligible.
+
+namespace {
+using namespace core;
+using namespace core::render;
+
+constexpr char const* kTriangleWGSL = R"(
+@vertex fn vs(@location(0) position : vec3f) -> @builtin(position) vec4f {
+    return vec4f(position, 1.0);
+}
+@fragment fn fs() -> @location(0) vec4f {
+    return vec4f(1.0, 0.0, 1.0, 1.0);
+}
+)";
+
+struct RecordingFixture {
+    std::unique_ptr<Device> device;
+    wgpu::RenderPipeline pipeline;
+    wgpu::Buffer vertexBuffer;
+    wgpu::Buffer indexBuffer;
+    std::array<MeshAssetFormat::BufferRange, 1> bufferRange{};
+    PassTargetState targetState;
+    pass::ForwardRenderPass forwardPass;
+
+    RecordingFixture() {
+        device = Device::CreateHeadless(HeadlessSpec{.width = 256, .height = 256});
+        if (device == nullptr) {
+            return;
+        }
+        const wgpu::TextureFormat format = device->GetSurfaceConfig().format;
+        targetState.colorTargetFormats = {format};
+
+        wgpu::ShaderModule module = device->CreateShaderModuleFromWGSL(kTriangleWGSL);
+        wgpu::VertexAttribute attribute{
+            .format = wgpu::VertexFormat::Float32x3, .offset = 0, .shaderLocation = 0};
+        wgpu::VertexBufferLayout vertexLayout{
+            .arrayStride = sizeof(float) * 3, .attributeCount = 1, .attributes = &attribute};
+        wgpu::ColorTargetState colorTarget{.format = format};
+        wgpu::FragmentState fragment{
+            .module = module, .entryPoint = "fs", .targetCount = 1, .targets = &colorTarget};
+        pipeline = device->CreateRenderPipeline(wgpu::RenderPipelineDescriptor{
+            .vertex = {.module = module,
+                       .entryPoint = "vs",
+                       .bufferCount = 1,
+                       .buffers = &vertexLayout},
+            .fragment = &fragment,
+        });
+
+        const std::array<float, 9> vertices{
+            0.0f, 0.5f, 0.0f, -0.5f, -0.5f, 0.0f, 0.5f, -0.5f, 0.0f,
+        };
+        const std::array<uint32_t, 3> indices{0, 1, 2};
+        vertexBuffer = device->CreateBufferFromData(vertices.data(), sizeof(vertices),
+                                                    wgpu::BufferUsage::Vertex);
+        indexBuffer = device->CreateBufferFromData(indices.data(), sizeof(indices),
+                                                   wgpu::BufferUsage::Index);
+        bufferRange[0] = {.offset = 0, .size = static_cast<uint32_t>(sizeof(vertices))};
+    }
+
+    std::vector<RenderIntent> MakeIntents(uint32_t count) const {
+        std::vector<RenderIntent> intents(count);
+        for (RenderIntent& intent : intents) {
+            intent.pipeline = pipeline;
+            intent.vertexBuffer = vertexBuffer;
+            intent.indexBuffer = indexBuffer;
+            intent.subMeshInfo.indexCount = 3;
+            intent.subMeshInfo.indexStart = 0;
+            intent.bufferRange = bufferRange;
+        }
+        return intents;
+    }
+};
+
+RecordingFixture& GetFixture() {
+    static RecordingFixture fixture;
+    return fixture;
+}
+
+// Args: {recording worker threads, intents in the pass, keep the bundle cache}
+void BM_RecordForwardPass(benchmark::State& state) {
+    RecordingFixture& fixture = GetFixture();
+    if (fixture.device == nullptr) {
+        state.SkipWithError("No WebGPU adapter available");
+        return;
+    }
+    if (state.range(0) > 0 && !fixture.device->SupportsMultithreading()) {
+        state.SkipWithError("Device was created without ImplicitDeviceSynchronization");
+        return;
+    }
+
+    util::JobSystem jobSystem(static_cast<uint32_t>(state.range(0)));
+    CommandRecorder recorder(fixture.device.get(), &jobSystem);
+    std::vector<RenderIntent> intents = fixture.MakeIntents(static_cast<uint32_t>(state.range(1)));
+    const std::array<CommandRecorder::NodeRecording, 1> nodes{CommandRecorder::NodeRecording{
+        .pass = &fixture.forwardPass,
+        .targetState = &fixture.targetState,
+        .intents = intents,
+    }};
+    std::vector<std::vector<wgpu::RenderBundle>> bundles;
+    std::vector<CommandStats> commands;
+    wgpu::Device device = fixture.device->GetDevice();
+    wgpu::TextureView target = fixture.device->GetCurrentTextureView();
+    const AssetRegistry assetRegistry{};
+
+    const bool keepCache = state.range(2) != 0;
+    fixture.forwardPass.GetBundleCache()->Clear();
+
+    for (auto _ : state) {
+        if (!keepCache) {
+            fixture.forwardPass.GetBundleCache()->Clear();
+        }
+        recorder.RecordBundles(nodes, bundles, commands);
+
+        wgpu::CommandEncoder commandEncoder = device.CreateCommandEncoder();
+        wgpu::RenderPassColorAttachment colorAttachment{
+            .view = target,
+            .loadOp = wgpu::LoadOp::Clear,
+            .storeOp = wgpu::StoreOp::Store,
+        };
+        wgpu::RenderPassDescriptor passDesc{.colorAttachmentCount = 1,
+                                            .colorAttachments = &colorAttachment};
+        wgpu::RenderPassEncoder encoder = commandEncoder.BeginRenderPass(&passDesc);
+        if (!bundles[0].empty()) {
+            encoder.ExecuteBundles(bundles[0].size(), bundles[0].data());
+        } else {
+            fixture.forwardPass.Execute(encoder,
+                                        {.intents = intents, .assetRegistry = assetRegistry});
+        }
+        encoder.End();
+        wgpu::CommandBuffer commandBuffer = commandEncoder.Finish();
+        device.GetQueue().Submit(1, &commandBuffer);
+
+        state.PauseTiming();
+        fixture.device->WaitIdle();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_RecordForwardPass)
+    ->ArgsProduct({{0, 1, 2, 4, 8}, {4096, 32768}, {0}})
+    ->ArgNames({"workers", "intents", "cached"})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+// Static scene: the intent list repeats, so after the first frame the bundles are replayed.
+BENCHMARK(BM_RecordForwardPass)
+    ->ArgsProduct({{0}, {4096, 32768}, {1}})
+    ->ArgNames({"workers", "intents", "cached"})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+}  // namespace
@@ -0,0 +1,276 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdlib>
+#include <format>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Application.h"
+#include "GeneratedMesh.h"
+#include "Scene.h"
+#include "import/GLTFImporter.h"
+#include "import/ShdrImporter.h"
+#include "render/RenderIntentSort.h"
+#include "render/SceneRenderer.h"
+
+// Building and sorting the render queue. ExtractRenderQueue needs real pipelines and bind groups,
+// so its fixture runs on a headless device (Dawn's CPU fallback adapter) with the forward pass
+// shader baked next to the benchmark.
+
+namespace {
+using namespace core;
+using namespace core::render;
+
+std::vector<RenderIntent> MakeShuffledIntents(size_t count) {
+    std::mt19937_64 rng(7);
+    std::vector<RenderIntent> intents(count);
+    for (size_t i = 0; i < count; ++i) {
+        intents[i].transformIndex = static_cast<uint32_t>(i);
+        intents[i].sortKey =
+            RenderIntent::CreateOpaqueKey(rng() % 64, rng() % 1024, rng() % 4096, rng() & 0xFFFF);
+    }
+    return intents;
+}
+
+// Args: {intents}
+void BM_RadixSortRenderIntents(benchmark::State& state) {
+    const std::vector<RenderIntent> source =
+        MakeShuffledIntents(static_cast<size_t>(state.range(0)));
+    std::vector<RenderIntent> intents;
+    RenderIntentSorter sorter;
+    for (auto _ : state) {
+        state.PauseTiming();
+        intents = source;
+        state.ResumeTiming();
+
+        sorter.Sort(intents);
+        benchmark::DoNotOptimize(intents.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RadixSortRenderIntents)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 20)
+    ->Arg(100000)
+    ->Unit(benchmark::kMicrosecond);
+
+// A scene of kMeshCount grid meshes and kMaterialCount materials, instanced over any number of
+// models so intents get varied sort keys.
+struct SceneFixture {
+    static constexpr uint32_t kMeshCount = 16;
+    static constexpr uint32_t kMaterialCount = 32;
+
+    std::unique_ptr<Device> device;
+    std::unique_ptr<AssetManager> assetManager;
+    util::JobSystem jobSystem{std::max(1u, std::thread::hardware_concurrency()) - 1};
+    std::unique_ptr<SceneRenderer> renderer;
+    std::vector<uint32_t> passIds;
+    std::vector<Handle> meshes;
+    std::vector<Handle> materials;
+    bool ready = false;
+
+    SceneFixture() {
+        device = Device::CreateHeadless(HeadlessSpec{.width = 1280, .height = 720});
+        if (device == nullptr) {
+            return;
+        }
+        assetManager = std::make_unique<AssetManager>(AssetManager::Create());
+        renderer = std::make_unique<SceneRenderer>(device.get(), assetManager.get(), &jobSystem,
+                                                   Application::GetGlobalLayouDesc());
+
+        auto shaderOrError = importer::ShdrImporter::ShdrImport(RENDER_BENCH_FORWARD_SHADER);
+        if (!shaderOrError.has_value()) {
+            return;
+        }
+        renderer->GetShaderManager()->LoadShader(std::move(shaderOrError.value()));
+
+        for (uint32_t i = 0; i < kMeshCount; ++i) {
+            const tinygltf::Model gltf = bench::MakeGridModel(4 + i);
+            auto meshOrError = importer::GLTFImporter::ImportMesh(gltf, gltf.meshes[0]);
+            if (!meshOrError.has_value()) {
+                return;
+            }
+            meshes.push_back(renderer->GetMeshManager()->LoadMesh(importer::MeshResult{
+                std::move(meshOrError.value()), AssetPath{std::format("bench://mesh/{}", i)}}));
+        }
+
+        // Texture paths that do not resolve fall back to the default texture.
+        const tinygltf::Model emptyGltf;
+        for (uint32_t i = 0; i < kMaterialCount; ++i) {
+            auto materialOrError =
+                importer::GLTFImporter::ImportMaterial(emptyGltf, tinygltf::Material{});
+            MaterialAssetFormat& material = materialOrError.value();
+            for (const char* slot : {"baseColorTexture", "metallicRoughnessTexture",
+                                     "normalTexture", "occlusionTexture", "emissiveTexture"}) {
+                material.SetTexture(slot, AssetPath{"bench://texture/missing"});
+            }
+            materials.push_back(renderer->GetMaterialManager()->LoadMaterial(
+                importer::MaterialResult{std::move(material),
+                                         AssetPath{std::format("bench://material/{}", i)}}));
+        }
+        for (Handle material : materials) {
+            renderer->GetBindGroupManager()->UpdateBindGroup(material);
+        }
+        renderer->GetMaterialManager()->ClearDirties();
+
+        passIds = {renderer->GetPassManager()->GetPassID("ForwardRenderPass")};
+        renderer->Setup(passIds);
+        ready = true;
+    }
+
+    // Models are scattered over a square around a camera looking down -Z, so roughly a quarter of
+    // them survive frustum culling.
+    Scene MakeScene(uint32_t modelCount) {
+        Scene scene;
+        const glm::mat4x4 view =
+            glm::lookAtRH(glm::vec3(0.0f, 2.0f, 0.0f), glm::vec3(0.0f, 2.0f, -1.0f),
+                          glm::vec3(0.0f, 1.0f, 0.0f));
+        const glm::mat4x4 proj =
+            glm::perspectiveRH(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+        scene.cameraData = CameraUniformData{
+            .view = view,
+            .proj = proj,
+            .viewProj = proj * view,
+            .invViewProj = glm::inverse(proj * view),
+            .position = glm::vec4(0.0f, 2.0f, 0.0f, 1.0f),
+        };
+
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<float> coordinate(-100.0f, 100.0f);
+        for (uint32_t i = 0; i < modelCount; ++i) {
+            Model model;
+            model.renderUnits.push_back(RenderUnit{
+                .meshHandle = meshes[rng() % meshes.size()],
+                .materialHandle = materials[rng() % materials.size()],
+            });
+            Handle modelHandle = assetManager->StoreModel(std::move(model));
+            const glm::vec3 position(coordinate(rng), 0.0f, coordinate(rng));
+            scene.AddModel(assetManager->GetModel(modelHandle),
+                           glm::translate(glm::mat4x4(1.0f), position));
+        }
+        return scene;
+    }
+};
+
+SceneFixture& GetSceneFixture() {
+    static SceneFixture fixture;
+    return fixture;
+}
+
+// Args: {models, one render unit each}
+void BM_ExtractRenderQueue(benchmark::State& state) {
+    SceneFixture& fixture = GetSceneFixture();
+    if (!fixture.ready) {
+        state.SkipWithError("Failed to set up the scene; no adapter, or no baked forward shader?");
+        return;
+    }
+
+    const Scene scene = fixture.MakeScene(static_cast<uint32_t>(state.range(0)));
+    SceneRenderer& renderer = *fixture.renderer;
+    RenderQueue renderQueue;
+    for (auto _ : state) {
+        renderQueue.Clear();
+        SceneCuller::ExtractRenderQueue(scene, fixture.passIds, fixture.assetManager.get(),
+                                        renderer.GetShaderManager(),
+                                        renderer.GetPipelineManager(),
+                                        renderer.GetBindGroupManager(),
+                                        renderer.GetPassTargetStates(), renderQueue);
+        benchmark::DoNotOptimize(renderQueue.renderIntents[fixture.passIds[0]].data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ExtractRenderQueue)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 16)
+    ->Unit(benchmark::kMicrosecond);
+
+// Args: {models, extraction worker threads}
+void BM_ExtractRenderQueueParallel(benchmark::State& state) {
+    SceneFixture& fixture = GetSceneFixture();
+    if (!fixture.ready) {
+        state.SkipWithError("Failed to set up the scene; no adapter, or no baked forward shader?");
+        return;
+    }
+
+    const Scene scene = fixture.MakeScene(static_cast<uint32_t>(state.range(0)));
+    SceneRenderer& renderer = *fixture.renderer;
+    util::JobSystem jobSystem(static_cast<uint32_t>(state.range(1)));
+    SceneCuller::ExtractScratch scratch;
+    RenderQueue renderQueue;
+    for (auto _ : state) {
+        renderQueue.Clear();
+        SceneCuller::ExtractRenderQueueParallel(
+            scene, fixture.passIds, fixture.assetManager.get(), renderer.GetShaderManager(),
+            renderer.GetPipelineManager(), renderer.GetBindGroupManager(),
+            renderer.GetPassTargetStates(), jobSystem, scratch, renderQueue);
+        benchmark::DoNotOptimize(renderQueue.renderIntents[fixture.passIds[0]].data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ExtractRenderQueueParallel)
+    ->ArgsProduct({{1 << 12, 1 << 16}, {0, 1, 2, 4, 8}})
+    ->ArgNames({"models", "workers"})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+// Whole frames with frustum culling on the CPU (0) or in a compute pass (1). The GPU path reads
+// its surviving instance count back once and checks it against FrustumCuller.
+// Args: {models, gpuCulling}
+void BM_RenderFrameCulled(benchmark::State& state) {
+    SceneFixture& fixture = GetSceneFixture();
+    if (!fixture.ready) {
+        state.SkipWithError("Failed to set up the scene; no adapter, or no baked forward shader?");
+        return;
+    }
+
+    const Scene scene = fixture.MakeScene(static_cast<uint32_t>(state.range(0)));
+    SceneRenderer& renderer = *fixture.renderer;
+    const bool gpuCulling = state.range(1) != 0;
+    renderer.SetGpuCullingEnabled(gpuCulling);
+    if (gpuCulling && !renderer.IsGpuCullingEnabled()) {
+        state.SkipWithError("The device does not support IndirectFirstInstance");
+        return;
+    }
+
+    if (gpuCulling) {
+        RenderQueue reference;
+        SceneCuller::ExtractRenderQueue(scene, fixture.passIds, fixture.assetManager.get(),
+                                        renderer.GetShaderManager(),
+                                        renderer.GetPipelineManager(),
+                                        renderer.GetBindGroupManager(),
+                                        renderer.GetPassTargetStates(), reference);
+        const auto expected =
+            static_cast<int64_t>(reference.renderIntents[fixture.passIds[0]].size());
+
+        renderer.Render(scene);
+        int64_t visible = 0;
+        for (const DrawIndexedIndirectArgs& args : renderer.GetGpuCuller()->ReadbackDrawArgs()) {
+            visible += args.instanceCount;
+        }
+        state.counters["visible"] = static_cast<double>(visible);
+        // Spheres touching a plane may fall either way with the GPU's rounding.
+        if (std::abs(visible - expected) > expected / 1000 + 1) {
+            renderer.SetGpuCullingEnabled(false);
+            state.SkipWithError(std::format("GPU culling kept {} instances, FrustumCuller {}",
+                                            visible, expected));
+            return;
+        }
+    }
+
+    for (auto _ : state) {
+        renderer.Render(scene);
+        fixture.device->WaitIdle();
+    }
+    renderer.SetGpuCullingEnabled(false);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RenderFrameCulled)
+    ->ArgsProduct({{1 << 12, 1 << 16}, {0, 1}})
+    ->ArgNames({"models", "gpuCulling"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+}  // namespace
@@ -0,0 +1,108 @@
+#include <benchmark/benchmark.h>
+#include <array>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "ResourcePool.h"
+#include "render/graph/RenderGraph.h"
+#include "render/render.h"
+
+// Handle pools of the asset side and the render graph's transient texture pool.
+
+namespace {
+using namespace core;
+using namespace core::render;
+
+struct PooledAsset {
+    std::array<uint64_t, 4> payload{};
+};
+
+// Args: {live handles}. Each iteration releases and re-attaches a random half of the handles,
+// then resolves every handle once, like a frame touching all of its assets.
+void BM_ResourcePoolChurn(benchmark::State& state) {
+    const size_t liveCount = static_cast<size_t>(state.range(0));
+    ResourcePool<PooledAsset> pool;
+    std::vector<Handle> handles;
+    handles.reserve(liveCount);
+    for (size_t i = 0; i < liveCount; ++i) {
+        handles.push_back(pool.Attach(PooledAsset{}));
+    }
+
+    std::mt19937 rng(42);
+    std::vector<uint32_t> victims(liveCount / 2);
+    for (auto _ : state) {
+        for (uint32_t& victim : victims) {
+            victim = static_cast<uint32_t>(rng() % liveCount);
+        }
+        for (uint32_t victim : victims) {
+            pool.Release(handles[victim]);
+        }
+        for (uint32_t victim : victims) {
+            handles[victim] = pool.Attach(PooledAsset{});
+        }
+
+        uint64_t sum = 0;
+        for (const Handle& handle : handles) {
+            if (PooledAsset* asset = pool.Get(handle)) {
+                sum += asset->payload[0];
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(liveCount + victims.size()));
+}
+BENCHMARK(BM_ResourcePoolChurn)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+
+// Null when no adapter is available.
+Device* GetHeadlessDevice() {
+    static std::unique_ptr<Device> device =
+        Device::CreateHeadless(HeadlessSpec{.width = 1280, .height = 720});
+    return device.get();
+}
+
+// Args: {transient requests per frame}. Requests cycle through a few formats and sizes the way a
+// compiled graph does; after the first frame every Attache is served from a free bucket.
+void BM_TransientResourcePoolAttacheRelease(benchmark::State& state) {
+    Device* device = GetHeadlessDevice();
+    if (device == nullptr) {
+        state.SkipWithError("No WebGPU adapter available");
+        return;
+    }
+    constexpr std::array<wgpu::TextureFormat, 4> kFormats{
+        wgpu::TextureFormat::RGBA8Unorm,
+        wgpu::TextureFormat::RGBA16Float,
+        wgpu::TextureFormat::RG16Float,
+        wgpu::TextureFormat::Depth24PlusStencil8,
+    };
+    constexpr std::array<float, 2> kScales{1.0f, 0.5f};
+
+    std::vector<TextureDescriptor> descs;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        const float scale = kScales[(i / kFormats.size()) % kScales.size()];
+        descs.push_back(TextureDescriptor{
+            .usage = wgpu::TextureUsage::RenderAttachment | wgpu::TextureUsage::TextureBinding,
+            .dimension = wgpu::TextureDimension::e2D,
+            .size = RelativeSize{scale, scale},
+            .format = kFormats[i % kFormats.size()],
+        });
+    }
+
+    TransientResourcePool pool(device);
+    std::vector<TransientResourcePool::Handle> handles(descs.size());
+    for (auto _ : state) {
+        pool.BeginAllocationScope();
+        // Keep two requests alive at a time, like a chain of passes reading their predecessor.
+        for (size_t i = 0; i < descs.size(); ++i) {
+            handles[i] = pool.Attache(descs[i]);
+            if (i >= 1) {
+                pool.Release(descs[i - 1], handles[i - 1]);
+            }
+        }
+        pool.Release(descs.back(), handles.back());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["physicalTextures"] = pool.GetMemoryStats().physicalTextureCount;
+}
+BENCHMARK(BM_TransientResourcePoolAttacheRelease)->Arg(8)->Arg(32)->Arg(128);
+}  // namespace
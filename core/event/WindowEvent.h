@@ -1,5 +1,10 @@
+#include <cstdint>
+
 namespace core::event {
 struct WindowCloseEvent {};
 
-struct WindowResizeEvent {};
+struct WindowResizeEvent {
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
 }  // namespace core::event
\ No newline at end of file
@@ -1,5 +1,11 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <optional>
 #include <ranges>
 
 #define TINYGLTF_IMPLEMENTATION
@@ -7,6 +13,8 @@
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 
 #include "GLTFImporter.h"
+#include "util/Load.h"
+#include "util/MappedFile.h"
 
 using core::memory::StridedSpan;
 
@@ -18,6 +26,244 @@ const char* kGltfNormal = "NORMAL";
 const char* kGltfTangent = "TANGENT";
 const char* kGltfColor = "COLOR_0";
 
+namespace {
+constexpr uint32_t kGlbMagic = 0x46546C67;  // "glTF"
+constexpr uint32_t kGlbChunkJson = 0x4E4F534A;
+constexpr uint32_t kGlbChunkBin = 0x004E4942;
+// Replaces the URI of every mapped buffer, so tinygltf only decodes a single byte for it.
+constexpr const char* kMappedBufferUri = "data:application/octet-stream;base64,AA==";
+
+// A parsed glTF file and the bytes of its buffers, which point into mappings owned by the
+// document.
+struct GLTFDocument {
+    tinygltf::Model model;
+    GLTFBufferSpans buffers;
+    std::vector<util::MappedFile> mappings;
+};
+
+struct GlbChunks {
+    std::string_view json;
+    std::span<const uint8_t> bin;
+};
+
+// GLB is little-endian, as is every target the engine builds for.
+uint32_t ReadU32(std::span<const uint8_t> bytes, size_t offset) {
+    uint32_t value = 0;
+    std::memcpy(&value, bytes.data() + offset, sizeof(value));
+    return value;
+}
+
+std::expected<GlbChunks, Error> SplitGlb(std::span<const uint8_t> bytes) {
+    if (bytes.size() < 12 || ReadU32(bytes, 0) != kGlbMagic) {
+        return std::unexpected(Error::Parse("Not a GLB file"));
+    }
+    if (ReadU32(bytes, 4) != 2) {
+        return std::unexpected(Error::Parse("Unsupported GLB version"));
+    }
+    const size_t length = std::min<size_t>(ReadU32(bytes, 8), bytes.size());
+    GlbChunks chunks;
+    for (size_t offset = 12; offset + 8 <= length;) {
+        const uint32_t chunkLength = ReadU32(bytes, offset);
+        const uint32_t chunkType = ReadU32(bytes, offset + 4);
+        offset += 8;
+        if (chunkLength > length - offset) {
+            return std::unexpected(Error::Parse("GLB chunk runs past the end of the file"));
+        }
+        const std::span<const uint8_t> chunk = bytes.subspan(offset, chunkLength);
+        if (chunkType == kGlbChunkJson && chunks.json.empty()) {
+            chunks.json =
+                std::string_view(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+        } else if (chunkType == kGlbChunkBin && chunks.bin.empty()) {
+            chunks.bin = chunk;
+        }
+        offset += chunkLength;
+    }
+    if (chunks.json.empty()) {
+        return std::unexpected(Error::Parse("GLB file has no JSON chunk"));
+    }
+    return chunks;
+}
+
+// glTF URIs are percent-encoded.
+std::string DecodeUri(std::string_view uri) {
+    std::string decoded;
+    decoded.reserve(uri.size());
+    for (size_t i = 0; i < uri.size(); ++i) {
+        unsigned int value = 0;
+        if (uri[i] == '%' && i + 2 < uri.size() &&
+            std::from_chars(uri.data() + i + 1, uri.data() + i + 3, value, 16).ptr ==
+                uri.data() + i + 3) {
+            decoded.push_back(static_cast<char>(value));
+            i += 2;
+        } else {
+            decoded.push_back(uri[i]);
+        }
+    }
+    return decoded;
+}
+
+std::optional<std::string> GetString(const nlohmann::json& object, const char* key) {
+    const auto it = object.find(key);
+    if (it == object.end() || !it->is_string()) {
+        return std::nullopt;
+    }
+    return it->get<std::string>();
+}
+
+// Loads the image entries that LoadDocument kept away from tinygltf. Images in a buffer view
+// are decoded straight from the mapping.
+std::expected<void, Error> LoadImages(GLTFDocument& document,
+                                      const nlohmann::json& images,
+                                      const std::filesystem::path& baseDir) {
+    document.model.images.resize(images.size());
+    for (size_t i = 0; i < images.size(); ++i) {
+        const nlohmann::json& entry = images[i];
+        tinygltf::Image& image = document.model.images[i];
+        image.name = GetString(entry, "name").value_or("");
+        image.mimeType = GetString(entry, "mimeType").value_or("");
+
+        std::vector<uint8_t> storage;
+        std::span<const uint8_t> encoded;
+        const auto bufferView = entry.find("bufferView");
+        if (bufferView != entry.end() && bufferView->is_number_unsigned() &&
+            bufferView->get<size_t>() < document.model.bufferViews.size()) {
+            image.bufferView = bufferView->get<int>();
+            const tinygltf::BufferView& view = document.model.bufferViews[image.bufferView];
+            if (view.buffer < 0 || static_cast<size_t>(view.buffer) >= document.buffers.size() ||
+                view.byteOffset + view.byteLength > document.buffers[view.buffer].size()) {
+                return std::unexpected(
+                    Error::Parse(std::format("glTF image {} is out of its buffer", i)));
+            }
+            encoded = document.buffers[view.buffer].subspan(view.byteOffset, view.byteLength);
+        } else if (auto uri = GetString(entry, "uri")) {
+            image.uri = *uri;
+            if (tinygltf::IsDataURI(*uri)) {
+                std::string mimeType;
+                if (!tinygltf::DecodeDataURI(&storage, mimeType, *uri, 0, false)) {
+                    return std::unexpected(
+                        Error::Parse(std::format("Failed to decode the data URI of image {}", i)));
+                }
+            } else {
+                auto bytesOrError = util::ReadFileToByte(baseDir / DecodeUri(*uri));
+                if (!bytesOrError.has_value()) {
+                    return std::unexpected(bytesOrError.error());
+                }
+                storage = std::move(bytesOrError).value();
+            }
+            encoded = storage;
+        } else {
+            return std::unexpected(
+                Error::Parse(std::format("glTF image {} has neither a bufferView nor a uri", i)));
+        }
+
+        std::string err;
+        std::string warn;
+        if (!tinygltf::LoadImageData(&image, static_cast<int>(i), &err, &warn, 0, 0,
+                                     encoded.data(), static_cast<int>(encoded.size()), nullptr)) {
+            return std::unexpected(
+                Error::Parse(std::format("Failed to decode glTF image {}: {}", i, err)));
+        }
+    }
+    return {};
+}
+
+// Parses a .gltf or .glb file. Buffers in the GLB BIN chunk or in external files are mapped
+// and swapped for a placeholder before tinygltf sees the JSON, so their bytes are never copied.
+// Images are taken out of the JSON as well, since tinygltf would decode those in a buffer
+// view from its own, now empty, copy of the buffer.
+std::expected<GLTFDocument, Error> LoadDocument(const std::filesystem::path& filePath) {
+    auto fileOrError = util::MappedFile::Open(filePath);
+    if (!fileOrError.has_value()) {
+        return std::unexpected(fileOrError.error());
+    }
+    const std::span<const uint8_t> fileBytes = fileOrError->GetBytes();
+    std::string_view jsonText(reinterpret_cast<const char*>(fileBytes.data()), fileBytes.size());
+    std::span<const uint8_t> binChunk;
+    if (fileBytes.size() >= 4 && ReadU32(fileBytes, 0) == kGlbMagic) {
+        auto chunksOrError = SplitGlb(fileBytes);
+        if (!chunksOrError.has_value()) {
+            return std::unexpected(chunksOrError.error());
+        }
+        jsonText = chunksOrError->json;
+        binChunk = chunksOrError->bin;
+    }
+
+    GLTFDocument document;
+    document.mappings.push_back(std::move(fileOrError).value());
+
+    nlohmann::json json = nlohmann::json::parse(jsonText.begin(), jsonText.end(), nullptr, false);
+    if (json.is_discarded() || !json.is_object()) {
+        return std::unexpected(Error::Parse("Failed to parse glTF JSON: " + filePath.string()));
+    }
+    const std::filesystem::path baseDir = filePath.parent_path();
+
+    std::vector<bool> mapped;
+    if (auto buffers = json.find("buffers"); buffers != json.end() && buffers->is_array()) {
+        document.buffers.resize(buffers->size());
+        mapped.resize(buffers->size());
+        for (size_t i = 0; i < buffers->size(); ++i) {
+            nlohmann::json& buffer = (*buffers)[i];
+            const auto byteLength = buffer.find("byteLength");
+            if (!buffer.is_object() || byteLength == buffer.end() ||
+                !byteLength->is_number_unsigned()) {
+                continue;  // Left for tinygltf to report.
+            }
+
+            std::span<const uint8_t> bytes;
+            const std::optional<std::string> uri = GetString(buffer, "uri");
+            if (!buffer.contains("uri")) {
+                bytes = binChunk;
+            } else if (uri.has_value() && !tinygltf::IsDataURI(*uri)) {
+                auto mappingOrError = util::MappedFile::Open(baseDir / DecodeUri(*uri));
+                if (!mappingOrError.has_value()) {
+                    return std::unexpected(mappingOrError.error());
+                }
+                bytes = mappingOrError->GetBytes();
+                document.mappings.push_back(std::move(mappingOrError).value());
+            } else {
+                continue;
+            }
+            if (byteLength->get<size_t>() > bytes.size()) {
+                return std::unexpected(
+                    Error::Parse(std::format("glTF buffer {} is larger than its data", i)));
+            }
+            document.buffers[i] = bytes.first(byteLength->get<size_t>());
+            mapped[i] = true;
+            buffer["uri"] = kMappedBufferUri;
+            buffer["byteLength"] = 1;
+        }
+    }
+
+    nlohmann::json images = nlohmann::json::array();
+    if (auto it = json.find("images"); it != json.end()) {
+        if (it->is_array()) {
+            images = std::move(*it);
+        }
+        json.erase(it);
+    }
+
+    const std::string text = json.dump();
+    tinygltf::TinyGLTF loader;
+    std::string err;
+    std::string warn;
+    if (!loader.LoadASCIIFromString(&document.model, &err, &warn, text.c_str(),
+                                    static_cast<unsigned int>(text.size()), baseDir.string())) {
+        return std::unexpected(Error::Parse("Failed to load glTF file: " + err));
+    }
+    document.buffers.resize(document.model.buffers.size());
+    for (size_t i = 0; i < document.buffers.size(); ++i) {
+        if (i >= mapped.size() || !mapped[i]) {
+            document.buffers[i] = document.model.buffers[i].data;
+        }
+    }
+
+    if (auto imagesOrError = LoadImages(document, images, baseDir); !imagesOrError.has_value()) {
+        return std::unexpected(imagesOrError.error());
+    }
+    return document;
+}
+}  // namespace
+
 AssetPath GLTFImporter::ToTextureID(int gltfTextureIndex) {
     return AssetPath{std::format("virtual://tex/{}", gltfTextureIndex)};
 }
@@ -104,15 +350,12 @@ glm::mat4 GetNodeMatrix(const tinygltf::Node& node) {
 
 std::expected<GLTFImportResult, Error> GLTFImporter::ImportFromFile(const std::string& filePath) {
     GLTFImportResult result;
-    tinygltf::Model gltfModel;
-    tinygltf::TinyGLTF loader;
-    std::string err;
-    std::string warm;
-    bool ret = loader.LoadASCIIFromFile(&gltfModel, &err, &warm, filePath);
-    if (!ret) {
-        // TODO! log
-        return std::unexpected(Error::Parse("Failed to load glTF file: " + err));
+    auto documentOrError = LoadDocument(filePath);
+    if (!documentOrError.has_value()) {
+        return std::unexpected(documentOrError.error());
     }
+    const tinygltf::Model& gltfModel = documentOrError->model;
+    const GLTFBufferSpans& buffers = documentOrError->buffers;
 
     for (const auto& [idx, texture] : gltfModel.textures | std::views::enumerate) {
         const auto& image = gltfModel.images[texture.source];
@@ -126,7 +369,7 @@ std::expected<GLTFImportResult, Error> GLTFImporter::ImportFromFile(const std::s
     }
 
     for (const auto& [idx, gltfMesh] : gltfModel.meshes | std::views::enumerate) {
-        auto meshAsset = ImportMesh(gltfModel, gltfMesh).value_or({});
+        auto meshAsset = ImportMesh(gltfModel, buffers, gltfMesh).value_or({});
         result.meshes.push_back(MeshResult{meshAsset, ToMeshId(idx)});
     }
 
@@ -154,12 +397,55 @@ std::expected<GLTFImportResult, Error> GLTFImporter::ImportFromFile(const std::s
     return result;
 }
 
+// The sphere is centered on the AABB, with the radius of the farthest vertex; tighter than the
+// AABB's circumscribed sphere for most meshes.
+static MeshAssetFormat::SubMeshBounds ComputeBounds(const StridedSpan<const glm::vec3>& positions) {
+    if (positions.empty()) {
+        return MeshAssetFormat::SubMeshBounds{};
+    }
+    glm::vec3 aabbMin = positions[0];
+    glm::vec3 aabbMax = positions[0];
+    for (const glm::vec3& position : positions) {
+        aabbMin = glm::min(aabbMin, position);
+        aabbMax = glm::max(aabbMax, position);
+    }
+    const glm::vec3 center = (aabbMin + aabbMax) * 0.5f;
+    float radiusSq = 0.0f;
+    for (const glm::vec3& position : positions) {
+        const glm::vec3 offset = position - center;
+        radiusSq = std::max(radiusSq, glm::dot(offset, offset));
+    }
+    return MeshAssetFormat::SubMeshBounds{
+        .aabbMin = aabbMin,
+        .aabbMax = aabbMax,
+        .sphereCenter = center,
+        .sphereRadius = std::sqrt(radiusSq),
+    };
+}
+
+GLTFBufferSpans GLTFImporter::GetBufferSpans(const tinygltf::Model& model) {
+    GLTFBufferSpans buffers;
+    buffers.reserve(model.buffers.size());
+    for (const tinygltf::Buffer& buffer : model.buffers) {
+        buffers.emplace_back(buffer.data);
+    }
+    return buffers;
+}
+
 std::expected<MeshAssetFormat, Error> GLTFImporter::ImportMesh(const tinygltf::Model& gltfModel,
                                                                const tinygltf::Mesh& mesh) {
+    return ImportMesh(gltfModel, GetBufferSpans(gltfModel), mesh);
+}
+
+std::expected<MeshAssetFormat, Error> GLTFImporter::ImportMesh(const tinygltf::Model& gltfModel,
+                                                               const GLTFBufferSpans& buffers,
+                                                               const tinygltf::Mesh& mesh) {
     size_t totalVertexCount = 0;
     size_t totalIndexCount = 0;
     std::vector<MeshAssetFormat::SubMeshInfo> subMeshInfos;
     subMeshInfos.reserve(mesh.primitives.size());
+    std::vector<MeshAssetFormat::SubMeshBounds> subMeshBounds;
+    subMeshBounds.reserve(mesh.primitives.size());
     for (const auto& primitive : mesh.primitives) {
         if (primitive.attributes.contains("POSITION")) {
             totalVertexCount += gltfModel.accessors.at(primitive.attributes.at("POSITION")).count;
@@ -181,7 +467,8 @@ std::expected<MeshAssetFormat, Error> GLTFImporter::ImportMesh(const tinygltf::M
         if (primitive.indices < 0) {
             continue;
         }
-        auto posSpanOpt = GetAttributePtr<const glm::vec3>(gltfModel, primitive, kGltfPosition);
+        auto posSpanOpt =
+            GetAttributePtr<const glm::vec3>(gltfModel, buffers, primitive, kGltfPosition);
         if (!posSpanOpt) {
             continue;
         }
@@ -214,12 +501,16 @@ std::expected<MeshAssetFormat, Error> GLTFImporter::ImportMesh(const tinygltf::M
             }
         }
         currentRanges.push_back(posRange);
+        subMeshBounds.push_back(ComputeBounds(posSpan));
 
-        auto texSpanOpt = GetAttributePtr<const glm::vec2>(gltfModel, primitive, kGltfTexCoord0);
+        auto texSpanOpt =
+            GetAttributePtr<const glm::vec2>(gltfModel, buffers, primitive, kGltfTexCoord0);
         if (texSpanOpt) {
             auto texSpan = texSpanOpt.value();
-            auto norSpanOpt = GetAttributePtr<const glm::vec3>(gltfModel, primitive, kGltfNormal);
-            auto tanSpanOpt = GetAttributePtr<const glm::vec4>(gltfModel, primitive, kGltfTangent);
+            auto norSpanOpt =
+                GetAttributePtr<const glm::vec3>(gltfModel, buffers, primitive, kGltfNormal);
+            auto tanSpanOpt =
+                GetAttributePtr<const glm::vec4>(gltfModel, buffers, primitive, kGltfTangent);
 
             // TODO!(#7; sunghyun): Replace MakeZero padding with true dynamic packing. Currently,
             // standard shaders strictly require Normal and Tangent inputs. This bandwidth waste
@@ -272,7 +563,8 @@ std::expected<MeshAssetFormat, Error> GLTFImporter::ImportMesh(const tinygltf::M
             currentRanges.push_back(surRange);
         }
 
-        auto colorSpanOpt = GetAttributePtr<const glm::vec4>(gltfModel, primitive, kGltfColor);
+        auto colorSpanOpt =
+            GetAttributePtr<const glm::vec4>(gltfModel, buffers, primitive, kGltfColor);
         if (colorSpanOpt) {
             auto colorSpan = colorSpanOpt.value();
             MeshAssetFormat::MeshBufferSlot colorSlot{
@@ -303,11 +595,26 @@ std::expected<MeshAssetFormat, Error> GLTFImporter::ImportMesh(const tinygltf::M
         }
 
         const auto& indexAccessor = gltfModel.accessors[primitive.indices];
+        if (indexAccessor.bufferView < 0 ||
+            static_cast<size_t>(indexAccessor.bufferView) >= gltfModel.bufferViews.size()) {
+            return std::unexpected(Error{ErrorType::AssetParsingError,
+                                         "glTF index accessor has no buffer view!"});
+        }
         const auto& indexBufferView = gltfModel.bufferViews[indexAccessor.bufferView];
-        const auto& indexBuffer = gltfModel.buffers[indexBufferView.buffer];
+        if (indexBufferView.buffer < 0 ||
+            static_cast<size_t>(indexBufferView.buffer) >= buffers.size()) {
+            return std::unexpected(Error{ErrorType::AssetParsingError,
+                                         "glTF index buffer view has no buffer!"});
+        }
+        const std::span<const uint8_t> indexBytes = buffers[indexBufferView.buffer];
+        const size_t indexOffset = indexBufferView.byteOffset + indexAccessor.byteOffset;
+        const int indexSize = tinygltf::GetComponentSizeInBytes(indexAccessor.componentType);
+        if (indexSize > 0 && indexOffset + (indexAccessor.count * indexSize) > indexBytes.size()) {
+            return std::unexpected(Error{ErrorType::AssetParsingError,
+                                         "glTF index accessor is out of its buffer!"});
+        }
 
-        const void* indices = reinterpret_cast<const void*>(
-            &indexBuffer.data[indexBufferView.byteOffset + indexAccessor.byteOffset]);
+        const void* indices = reinterpret_cast<const void*>(indexBytes.data() + indexOffset);
         subMeshInfo.indexCount = indexAccessor.count;
         subMeshInfo.indexStart = indexData.size();
 
@@ -351,6 +658,7 @@ std::expected<MeshAssetFormat, Error> GLTFImporter::ImportMesh(const tinygltf::M
         .states = std::move(vertexStates),
         .bufferRanges = std::move(currentRanges),
         .subMeshes = std::move(subMeshInfos),
+        .subMeshBounds = std::move(subMeshBounds),
         .indexData = std::move(indexData),
         .vertexData = std::move(vertexData),
     };
@@ -1,6 +1,9 @@
 #pragma once
 #include <tiny_gltf.h>
 #include <glm/glm.hpp>
+#include <cstdint>
+#include <span>
+#include <vector>
 
 #include "Importer.h"
 #include "ModelAssetFormat.h"
@@ -8,6 +11,10 @@
 
 namespace core::importer {
 
+// Bytes of every glTF buffer, by buffer index. ImportFromFile points them into the mapped .glb
+// or .bin files instead of letting tinygltf copy the buffers into tinygltf::Buffer::data.
+using GLTFBufferSpans = std::vector<std::span<const uint8_t>>;
+
 struct GLTFImportResult {
     std::vector<TextureResult> textures;
     std::vector<MaterialResult> materials;
@@ -61,12 +68,52 @@ class GLTFImporter {
         return GetAttributePtrImpl<T>(model, primitive, name);
     }
 
+    // Reads the attribute straight out of buffers. Unlike tinygltf's own buffers, mapped ones
+    // were never checked against the accessors, so out of range accessors fail here.
+    template <typename T>
+    static auto GetAttributePtr(const tinygltf::Model& model,
+                                const GLTFBufferSpans& buffers,
+                                const tinygltf::Primitive& primitive,
+                                const std::string& name)
+        -> std::expected<core::memory::StridedSpan<const T>, int> {
+        const auto attribute = primitive.attributes.find(name);
+        if (attribute == primitive.attributes.end()) {
+            return std::unexpected(-1);
+        }
+        const auto& accessor = model.accessors[attribute->second];
+        if (accessor.bufferView < 0 ||
+            static_cast<size_t>(accessor.bufferView) >= model.bufferViews.size()) {
+            return std::unexpected(-1);
+        }
+        const auto& bufferView = model.bufferViews[accessor.bufferView];
+        const int stride = accessor.ByteStride(bufferView);
+        if (stride <= 0 || bufferView.buffer < 0 ||
+            static_cast<size_t>(bufferView.buffer) >= buffers.size()) {
+            return std::unexpected(-1);
+        }
+        const std::span<const uint8_t> bytes = buffers[bufferView.buffer];
+        const size_t offset = bufferView.byteOffset + accessor.byteOffset;
+        const size_t lastElement = accessor.count > 0 ? (accessor.count - 1) * stride : 0;
+        if (accessor.count > 0 && offset + lastElement + sizeof(T) > bytes.size()) {
+            return std::unexpected(-1);
+        }
+        return core::memory::StridedSpan<const T>(bytes.data() + offset, stride, accessor.count);
+    }
+
+    // Spans over tinygltf::Buffer::data, for models built or loaded without ImportFromFile.
+    static GLTFBufferSpans GetBufferSpans(const tinygltf::Model& model);
+
+    // Loads .gltf and .glb files. Vertex and index data are read from memory mappings of the
+    // .glb or external .bin files; data URIs are still decoded by tinygltf.
     static std::expected<GLTFImportResult, Error> ImportFromFile(const std::string& filePath);
     static std::expected<TextureAssetFormat, Error> ImportTextureFromTinygltf(
         const tinygltf::Model& model,
         const tinygltf::Image& image);
     static std::expected<MeshAssetFormat, Error> ImportMesh(const tinygltf::Model& model,
                                                             const tinygltf::Mesh& mesh);
+    static std::expected<MeshAssetFormat, Error> ImportMesh(const tinygltf::Model& model,
+                                                            const GLTFBufferSpans& buffers,
+                                                            const tinygltf::Mesh& mesh);
     static std::expected<MaterialAssetFormat, Error> ImportMaterial(
         const tinygltf::Model& model,
         const tinygltf::Material& gltfMaterial);
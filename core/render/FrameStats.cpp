@@ -0,0 +1,35 @@
+#include "FrameStats.h"
+#include <format>
+#include <numeric>
+
+uint32_t core::render::FrameStats::GetTotalIntents() const {
+    return std::accumulate(intentsPerPass.begin(), intentsPerPass.end(), 0u);
+}
+
+void core::render::WriteFrameStatsCsvHeader(std::ostream& out,
+                                            const PassManager& passManager,
+                                            std::span<const uint32_t> passIds) {
+    out << "frame,intents,culledRenderUnits,setPipeline,setBindGroup,setVertexBuffer,draws,"
+           "indirectDraws,instances,indices,pipelinesCreated,transientTexturesCreated,"
+           "writeBufferBytes";
+    for (uint32_t passId : passIds) {
+        out << ",intents:" << passManager.GetPassName(static_cast<uint8_t>(passId));
+    }
+    out << '\n';
+}
+
+void core::render::WriteFrameStatsCsvRow(std::ostream& out,
+                                         const FrameStats& stats,
+                                         std::span<const uint32_t> passIds) {
+    const CommandStats& commands = stats.commands;
+    out << std::format("{},{},{},{},{},{},{},{},{},{},{},{},{}", stats.frameIndex,
+                       stats.GetTotalIntents(), stats.culledRenderUnits, commands.setPipelineCount,
+                       commands.setBindGroupCount, commands.setVertexBufferCount,
+                       commands.drawCount, commands.indirectDrawCount, commands.instanceCount,
+                       commands.indexCount, stats.pipelinesCreated, stats.transientTexturesCreated,
+                       stats.writeBufferBytes);
+    for (uint32_t passId : passIds) {
+        out << ',' << (passId < stats.intentsPerPass.size() ? stats.intentsPerPass[passId] : 0);
+    }
+    out << '\n';
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <span>
+
+#include "render/backend/CountingEncoder.h"
+#include "render/graph/IRenderPass.h"
+
+namespace core::render {
+
+// What SceneRenderer did in one frame. Counters that are not tied to drawing (pipelines,
+// transient textures, uploads) include work done between the previous frame and this one, so a
+// layer uploading a mesh shows up on the next frame.
+struct FrameStats {
+    uint64_t frameIndex = 0;
+    std::array<uint32_t, PassManager::kMaxPasses> intentsPerPass{};
+    uint32_t culledRenderUnits = 0;
+    // Commands of every executed node, including the bind groups SceneRenderer sets itself.
+    CommandStats commands;
+    // Cache misses of PipelineManager::GetOrCreatePipeline.
+    uint32_t pipelinesCreated = 0;
+    uint32_t transientTexturesCreated = 0;
+    uint64_t writeBufferBytes = 0;
+
+    uint32_t GetTotalIntents() const;
+};
+
+// One CSV row per frame; passIds picks which passes get an intent column, in that order.
+void WriteFrameStatsCsvHeader(std::ostream& out,
+                              const PassManager& passManager,
+                              std::span<const uint32_t> passIds);
+void WriteFrameStatsCsvRow(std::ostream& out,
+                           const FrameStats& stats,
+                           std::span<const uint32_t> passIds);
+
+}  // namespace core::render
@@ -0,0 +1,130 @@
+#include "FrustumCulling.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENGINE_FRUSTUM_CULL_SSE
+#include <emmintrin.h>
+#endif
+
+namespace {
+using core::render::Frustum;
+
+glm::vec4 Row(const glm::mat4x4& m, int row) {
+    return glm::vec4(m[0][row], m[1][row], m[2][row], m[3][row]);
+}
+
+glm::vec4 NormalizePlane(const glm::vec4& plane) {
+    return plane / glm::length(glm::vec3(plane));
+}
+
+// A NaN distance counts as inside, the same as in the SIMD paths.
+bool IsSphereVisible(const Frustum& frustum, float x, float y, float z, float radius) {
+    for (const glm::vec4& plane : frustum.planes) {
+        if (plane.x * x + plane.y * y + plane.z * z + plane.w + radius < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace
+
+core::render::Frustum core::render::Frustum::FromViewProj(const glm::mat4x4& viewProj) {
+    const glm::vec4 r0 = Row(viewProj, 0);
+    const glm::vec4 r1 = Row(viewProj, 1);
+    const glm::vec4 r2 = Row(viewProj, 2);
+    const glm::vec4 r3 = Row(viewProj, 3);
+    return Frustum{.planes = {
+                       NormalizePlane(r3 + r0),
+                       NormalizePlane(r3 - r0),
+                       NormalizePlane(r3 + r1),
+                       NormalizePlane(r3 - r1),
+#if defined(GLM_FORCE_DEPTH_ZERO_TO_ONE)
+                       NormalizePlane(r2),
+#else
+                       NormalizePlane(r3 + r2),
+#endif
+                       NormalizePlane(r3 - r2),
+                   }};
+}
+
+void core::render::FrustumCuller::Reset(const Frustum& frustum) {
+    m_frustum = frustum;
+    m_centerX.clear();
+    m_centerY.clear();
+    m_centerZ.clear();
+    m_radius.clear();
+}
+
+void core::render::FrustumCuller::AddSphere(const glm::mat4x4& model,
+                                            const glm::vec4& localSphere) {
+    const glm::vec4 center = model * glm::vec4(glm::vec3(localSphere), 1.0f);
+    // The largest axis scale keeps the sphere conservative under non-uniform scaling.
+    const float scaleSq = std::max({glm::dot(glm::vec3(model[0]), glm::vec3(model[0])),
+                                    glm::dot(glm::vec3(model[1]), glm::vec3(model[1])),
+                                    glm::dot(glm::vec3(model[2]), glm::vec3(model[2]))});
+    m_centerX.push_back(center.x);
+    m_centerY.push_back(center.y);
+    m_centerZ.push_back(center.z);
+    m_radius.push_back(localSphere.w * std::sqrt(scaleSq));
+}
+
+std::span<const uint8_t> core::render::FrustumCuller::Cull() {
+    const size_t count = m_radius.size();
+    m_visible.resize(count);
+    size_t i = 0;
+
+    // Each lane accumulates whether its sphere lies fully behind any plane.
+#if defined(__AVX__)
+    for (; i + 8 <= count; i += 8) {
+        const __m256 x = _mm256_loadu_ps(m_centerX.data() + i);
+        const __m256 y = _mm256_loadu_ps(m_centerY.data() + i);
+        const __m256 z = _mm256_loadu_ps(m_centerZ.data() + i);
+        const __m256 radius = _mm256_loadu_ps(m_radius.data() + i);
+        __m256 outside = _mm256_setzero_ps();
+        for (const glm::vec4& plane : m_frustum.planes) {
+            __m256 distance = _mm256_mul_ps(_mm256_set1_ps(plane.x), x);
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(plane.y), y));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(plane.z), z));
+            distance = _mm256_add_ps(distance, _mm256_set1_ps(plane.w));
+            distance = _mm256_add_ps(distance, radius);
+            outside = _mm256_or_ps(outside,
+                                   _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_LT_OQ));
+        }
+        const int mask = _mm256_movemask_ps(outside);
+        for (size_t lane = 0; lane < 8; ++lane) {
+            m_visible[i + lane] = static_cast<uint8_t>(((mask >> lane) & 1) ^ 1);
+        }
+    }
+#elif defined(ENGINE_FRUSTUM_CULL_SSE)
+    for (; i + 4 <= count; i += 4) {
+        const __m128 x = _mm_loadu_ps(m_centerX.data() + i);
+        const __m128 y = _mm_loadu_ps(m_centerY.data() + i);
+        const __m128 z = _mm_loadu_ps(m_centerZ.data() + i);
+        const __m128 radius = _mm_loadu_ps(m_radius.data() + i);
+        __m128 outside = _mm_setzero_ps();
+        for (const glm::vec4& plane : m_frustum.planes) {
+            __m128 distance = _mm_mul_ps(_mm_set1_ps(plane.x), x);
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.y), y));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.z), z));
+            distance = _mm_add_ps(distance, _mm_set1_ps(plane.w));
+            distance = _mm_add_ps(distance, radius);
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, _mm_setzero_ps()));
+        }
+        const int mask = _mm_movemask_ps(outside);
+        for (size_t lane = 0; lane < 4; ++lane) {
+            m_visible[i + lane] = static_cast<uint8_t>(((mask >> lane) & 1) ^ 1);
+        }
+    }
+#endif
+
+    for (; i < count; ++i) {
+        m_visible[i] = IsSphereVisible(m_frustum, m_centerX[i], m_centerY[i], m_centerZ[i],
+                                       m_radius[i])
+                           ? 1
+                           : 0;
+    }
+    return m_visible;
+}
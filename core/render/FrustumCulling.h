@@ -0,0 +1,43 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace core::render {
+
+// Planes of a view frustum with inward normals, normalized so dot(plane, vec4(p, 1)) is the
+// signed distance of p from the plane.
+struct Frustum {
+    std::array<glm::vec4, 6> planes;
+
+    static Frustum FromViewProj(const glm::mat4x4& viewProj);
+};
+
+// Tests bounding spheres against a frustum. Spheres are transformed to world space as they are
+// added and kept as a structure of arrays, so Cull tests one plane against 8 (AVX) or 4 (SSE)
+// spheres per instruction; other targets fall back to a scalar loop. Buffers are kept between
+// Reset calls.
+class FrustumCuller {
+  public:
+    void Reset(const Frustum& frustum);
+    // localSphere is (center, radius) in the space model maps to world space.
+    void AddSphere(const glm::mat4x4& model, const glm::vec4& localSphere);
+    uint32_t GetSphereCount() const { return static_cast<uint32_t>(m_radius.size()); }
+
+    // One entry per added sphere, in order; 1 if the sphere intersects the frustum. Valid until
+    // the next Reset.
+    std::span<const uint8_t> Cull();
+
+  private:
+    Frustum m_frustum{};
+    std::vector<float> m_centerX;
+    std::vector<float> m_centerY;
+    std::vector<float> m_centerZ;
+    std::vector<float> m_radius;
+    std::vector<uint8_t> m_visible;
+};
+
+}  // namespace core::render
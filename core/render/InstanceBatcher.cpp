@@ -0,0 +1,38 @@
+#include "InstanceBatcher.h"
+#include <utility>
+
+namespace {
+using core::render::RenderIntent;
+
+bool IsSameDraw(const RenderIntent& a, const RenderIntent& b) {
+    return a.pipeline.Get() == b.pipeline.Get() && a.bindGroup.Get() == b.bindGroup.Get() &&
+           a.vertexBuffer.Get() == b.vertexBuffer.Get() &&
+           a.indexBuffer.Get() == b.indexBuffer.Get() &&
+           a.subMeshInfo.indexStart == b.subMeshInfo.indexStart &&
+           a.subMeshInfo.indexCount == b.subMeshInfo.indexCount &&
+           a.bufferRange.data() == b.bufferRange.data() &&
+           a.bufferRange.size() == b.bufferRange.size();
+}
+}  // namespace
+
+void core::render::InstanceBatcher::Batch(std::vector<RenderIntent>& intents, bool mergeRuns) {
+    m_instances.reserve(m_instances.size() + intents.size());
+    size_t out = 0;
+    for (size_t i = 0; i < intents.size(); ++i) {
+        RenderIntent& intent = intents[i];
+        const auto instanceIndex = static_cast<uint32_t>(m_instances.size());
+        m_instances.push_back(intent.transformIndex);
+
+        if (mergeRuns && out > 0 && IsSameDraw(intents[out - 1], intent)) {
+            ++intents[out - 1].instanceCount;
+            continue;
+        }
+        intent.firstInstance = instanceIndex;
+        intent.instanceCount = 1;
+        if (out != i) {
+            intents[out] = std::move(intent);
+        }
+        ++out;
+    }
+    intents.resize(out);
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "render/graph/IRenderPass.h"
+
+namespace core::render {
+
+// Turns sorted intents into instanced draws. Every intent gets its transform index appended to
+// the frame's instance list; runs of adjacent intents that draw the same submesh with the same
+// pipeline and material collapse into the first intent of the run, which then draws the whole
+// run with one DrawIndexed. Sorting by RenderIntent::sortKey is what makes such runs adjacent.
+class InstanceBatcher {
+  public:
+    // Starts a new frame; instances of the previous one are dropped.
+    void Reset() { m_instances.clear(); }
+
+    // Rewrites intents in place. With mergeRuns off every intent stays a single-instance draw,
+    // which is useful to measure what instancing saves.
+    void Batch(std::vector<RenderIntent>& intents, bool mergeRuns = true);
+
+    // Transform index of every instance, in firstInstance order.
+    std::span<const uint32_t> GetInstances() const { return m_instances; }
+
+  private:
+    std::vector<uint32_t> m_instances;
+};
+
+}  // namespace core::render
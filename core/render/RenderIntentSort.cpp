@@ -0,0 +1,72 @@
+#include "RenderIntentSort.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <utility>
+
+namespace {
+constexpr uint32_t kBitsPerPass = 8;
+constexpr uint32_t kBucketCount = 1 << kBitsPerPass;
+constexpr uint32_t kPassCount = sizeof(uint64_t);
+}  // namespace
+
+void core::render::RenderIntentSorter::Sort(std::vector<RenderIntent>& intents) {
+    const size_t count = intents.size();
+    if (count <= 1) {
+        return;
+    }
+    assert(count <= UINT32_MAX && "Too many intents for 32-bit sort indices");
+
+    m_pairs.resize(count);
+    m_scratch.resize(count);
+
+    // Histograms of every byte position are gathered in a single pass over the keys.
+    std::array<std::array<uint32_t, kBucketCount>, kPassCount> histograms{};
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint64_t key = intents[i].sortKey;
+        m_pairs[i] = KeyIndex{key, i};
+        for (uint32_t pass = 0; pass < kPassCount; ++pass) {
+            histograms[pass][(key >> (pass * kBitsPerPass)) & 0xFF]++;
+        }
+    }
+
+    KeyIndex* src = m_pairs.data();
+    KeyIndex* dst = m_scratch.data();
+    const uint64_t firstKey = m_pairs[0].key;
+    for (uint32_t pass = 0; pass < kPassCount; ++pass) {
+        const uint32_t shift = pass * kBitsPerPass;
+        const std::array<uint32_t, kBucketCount>& histogram = histograms[pass];
+        if (histogram[(firstKey >> shift) & 0xFF] == count) {
+            continue;
+        }
+
+        std::array<uint32_t, kBucketCount> offsets;
+        uint32_t total = 0;
+        for (uint32_t bucket = 0; bucket < kBucketCount; ++bucket) {
+            offsets[bucket] = total;
+            total += histogram[bucket];
+        }
+        for (size_t i = 0; i < count; ++i) {
+            dst[offsets[(src[i].key >> shift) & 0xFF]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+
+    bool alreadySorted = true;
+    for (uint32_t i = 0; i < count && alreadySorted; ++i) {
+        alreadySorted = src[i].index == i;
+    }
+    if (alreadySorted) {
+        return;
+    }
+
+    // Moving leaves the wgpu handles' reference counts untouched. The intents are moved back
+    // rather than swapped in, so the caller keeps its buffer and m_sorted keeps its own.
+    m_sorted.clear();
+    m_sorted.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        m_sorted.push_back(std::move(intents[src[i].index]));
+    }
+    std::ranges::move(m_sorted, intents.begin());
+    m_sorted.clear();
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "render/graph/IRenderPass.h"
+
+namespace core::render {
+
+// Stable LSD radix sort of intents by RenderIntent::sortKey. Only compact (key, index) pairs move
+// between passes; the intents themselves are permuted once at the end. Byte positions that hold
+// the same value in every key are skipped, which with the opaque key layout usually removes
+// several of the eight passes. Scratch buffers are kept between calls, so a sorter reused every
+// frame stops allocating once it has seen the largest queue.
+class RenderIntentSorter {
+  public:
+    void Sort(std::vector<RenderIntent>& intents);
+
+  private:
+    struct KeyIndex {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    std::vector<KeyIndex> m_pairs;
+    std::vector<KeyIndex> m_scratch;
+    std::vector<RenderIntent> m_sorted;
+};
+
+}  // namespace core::render
@@ -1,77 +1,257 @@
 
 #include "SceneRenderer.h"
+#include <algorithm>
+#include <iterator>
+#include <optional>
 #include "render/backend/BindGroupManager.h"
 #include "render/backend/PipelineManager.h"
 #include "render/pass/DeferredGBufferPass.h"
 #include "render/pass/DeferredLightingPass.h"
 #include "render/pass/ForwardRenderPass.h"
+#include "render/pass/GpuCullingPass.h"
+#include "util/CpuProfiler.h"
+
+namespace {
+using core::render::PipelineManager;
+
+// Appends the intents of one render unit for every pass through emit(passSlot, intent).
+// resolvePipeline returns std::nullopt for a pipeline that does not exist yet, which abandons the
+// rest of the unit.
+template <typename ResolvePipeline, typename Emit>
+bool ExtractRenderUnit(uint32_t transformIndex,
+                       const core::render::RenderUnit& renderUnit,
+                       std::span<const uint32_t> passes,
+                       core::AssetManager* assetManager,
+                       core::render::ShaderManager* shaderManager,
+                       PipelineManager* pipelineManager,
+                       core::render::BindGroupManager* bindGroupManager,
+                       std::span<const core::render::PassTargetState> passTargetStates,
+                       ResolvePipeline&& resolvePipeline,
+                       Emit&& emit) {
+    using namespace core::render;
+    core::AssetView<Mesh> mesh = assetManager->GetMesh(renderUnit.meshHandle);
+    const core::MeshAssetFormat::SubMeshInfo& subMesh =
+        mesh->GetSubMeshInfo(renderUnit.subMeshIndex);
+    std::span<const core::MeshAssetFormat::BufferRange> bufferRanges =
+        mesh->GetBufferRanges(subMesh.bufferRangeStart, subMesh.bufferRangeCount);
+    core::AssetView<Material> material = assetManager->GetMaterial(renderUnit.materialHandle);
+    for (uint32_t passSlot = 0; passSlot < passes.size(); ++passSlot) {
+        const uint32_t passId = passes[passSlot];
+        core::Handle shaderHandle =
+            shaderManager->GetShaderHandle(passId, material->GetActiveTechniqueID());
+        if (!shaderHandle.IsValid()) {
+            continue;
+        }
+        core::AssetView<ShaderAsset> shader = shaderManager->GetShaderAsset(shaderHandle);
+
+        const std::optional<core::Handle> pipelineHandle =
+            resolvePipeline(PipelineManager::PipelineConfig{
+                .shader = shader,
+                .layoutId = mesh->GetGlobalVertexStateID(renderUnit.subMeshIndex),
+                .blendMode = BlendMode::Opaque,
+                .depthStencilId = DepthStencilStateManager::kDefaultDepthStateID,
+                .passId = passId,
+                .cullMode = wgpu::CullMode::Back,
+                .targetState = &passTargetStates[passId],
+            });
+        if (!pipelineHandle.has_value()) {
+            return false;
+        }
+
+        RenderIntent intent;
+        intent.transformIndex = transformIndex;
+        intent.pipeline = pipelineManager->GetPipeline(*pipelineHandle);
+        intent.vertexBuffer = mesh->vertexBuffer;
+        intent.indexBuffer = mesh->indexBuffer;
+        intent.bufferRange = bufferRanges;
+        intent.subMeshInfo = subMesh;
+        intent.boundingSphere = mesh->GetBoundingSphere(renderUnit.subMeshIndex);
+        // Opaque draws are not depth sorted yet; the submesh in the low bits keeps identical
+        // draws adjacent so InstanceBatcher can merge them.
+        intent.sortKey = RenderIntent::CreateOpaqueKey(
+            pipelineHandle->index, renderUnit.materialHandle.index, renderUnit.meshHandle.index,
+            renderUnit.subMeshIndex);
+
+        intent.bindGroup = bindGroupManager->GetBindGroup(material.handle);
+
+        emit(passSlot, std::move(intent));
+    }
+    return true;
+}
+
+void AddBoundingSphere(core::render::FrustumCuller& culler,
+                       core::AssetManager* assetManager,
+                       const glm::mat4x4& modelMatrix,
+                       const core::render::RenderUnit& renderUnit) {
+    core::AssetView<core::render::Mesh> mesh = assetManager->GetMesh(renderUnit.meshHandle);
+    culler.AddSphere(modelMatrix, mesh->GetBoundingSphere(renderUnit.subMeshIndex));
+}
+}  // namespace
 
 void core::render::SceneCuller::ExtractRenderQueue(
     const Scene& scene,
-    std::span<uint32_t> passes,
+    std::span<const uint32_t> passes,
     AssetManager* assetManager,
     ShaderManager* shaderManager,
     PipelineManager* pipelineManager,
     BindGroupManager* bindGroupManager,
     std::span<const PassTargetState> passTargetStates,
     RenderQueue& outRenderQueue) {
+    ENGINE_PROFILE_SCOPE("SceneCuller::ExtractRenderQueue");
+    FrustumCuller culler;
+    culler.Reset(Frustum::FromViewProj(scene.cameraData.viewProj));
+    for (uint32_t i = 0; i < scene.models.size(); ++i) {
+        for (const auto& renderUnit : scene.models[i]->renderUnits) {
+            AddBoundingSphere(culler, assetManager, scene.modelMatrices[i], renderUnit);
+        }
+    }
+    const std::span<const uint8_t> visible = culler.Cull();
+
+    const auto getOrCreatePipeline = [&](const PipelineManager::PipelineConfig& config) {
+        return std::optional<Handle>(pipelineManager->GetOrCreatePipeline(config));
+    };
+    uint32_t unitIndex = 0;
     for (uint32_t i = 0; i < scene.models.size(); ++i) {
         for (const auto& renderUnit : scene.models[i]->renderUnits) {
-            AssetView<Mesh> mesh = assetManager->GetMesh(renderUnit.meshHandle);
-            const MeshAssetFormat::SubMeshInfo& subMesh =
-                mesh->GetSubMeshInfo(renderUnit.subMeshIndex);
-            std::span<const MeshAssetFormat::BufferRange> bufferRanges =
-                mesh->GetBufferRanges(subMesh.bufferRangeStart, subMesh.bufferRangeCount);
-            AssetView<Material> material = assetManager->GetMaterial(renderUnit.materialHandle);
-            for (uint32_t passId : passes) {
-                Handle shaderHandle =
-                    shaderManager->GetShaderHandle(passId, material->GetActiveTechniqueID());
-                if (!shaderHandle.IsValid()) {
-                    continue;
-                }
-                AssetView<ShaderAsset> shader = shaderManager->GetShaderAsset(shaderHandle);
-
-                Handle pipelineHandle =
-                    pipelineManager->GetOrCreatePipeline(PipelineManager::PipelineConfig{
-                        .shader = shader,
-                        .layoutId = mesh->GetGlobalVertexStateID(renderUnit.subMeshIndex),
-                        .blendMode = BlendMode::Opaque,
-                        .depthStencilId = DepthStencilStateManager::kDefaultDepthStateID,
-                        .passId = passId,
-                        .cullMode = wgpu::CullMode::Back,
-                        .targetState = &passTargetStates[passId],
-                    });
-
-                RenderIntent intent;
-                intent.transformIndex = i;
-                intent.pipeline = pipelineManager->GetPipeline(pipelineHandle);
-                intent.vertexBuffer = mesh->vertexBuffer;
-                intent.indexBuffer = mesh->indexBuffer;
-                intent.bufferRange = bufferRanges;
-                intent.subMeshInfo = subMesh;
-                intent.sortKey = RenderIntent::CreateOpaqueKey(pipelineHandle.index,
-                                                               renderUnit.materialHandle.index,
-                                                               renderUnit.meshHandle.index, 0);
-
-                intent.bindGroup = bindGroupManager->GetBindGroup(material.handle);
-
-                outRenderQueue.renderIntents[passId].push_back(intent);
+            if (!visible[unitIndex++]) {
+                ++outRenderQueue.culledRenderUnits;
+                continue;
             }
+            ExtractRenderUnit(i, renderUnit, passes, assetManager, shaderManager, pipelineManager,
+                              bindGroupManager, passTargetStates, getOrCreatePipeline,
+                              [&](uint32_t passSlot, RenderIntent&& intent) {
+                                  outRenderQueue.renderIntents[passes[passSlot]].push_back(
+                                      std::move(intent));
+                              });
         }
     }
 
     outRenderQueue.cameraData = scene.cameraData;
     outRenderQueue.transforms = std::span(scene.modelMatrices.data(), scene.modelMatrices.size());
+    outRenderQueue.dirtyTransformBegin = scene.dirtyTransformBegin;
+    outRenderQueue.dirtyTransformEnd = scene.dirtyTransformEnd;
+}
+
+void core::render::SceneCuller::ExtractRenderQueueParallel(
+    const Scene& scene,
+    std::span<const uint32_t> passes,
+    AssetManager* assetManager,
+    ShaderManager* shaderManager,
+    PipelineManager* pipelineManager,
+    BindGroupManager* bindGroupManager,
+    std::span<const PassTargetState> passTargetStates,
+    util::JobSystem& jobSystem,
+    ExtractScratch& scratch,
+    RenderQueue& outRenderQueue,
+    bool frustumCulling) {
+    ENGINE_PROFILE_SCOPE("SceneCuller::ExtractRenderQueue");
+    scratch.units.clear();
+    for (uint32_t i = 0; i < scene.models.size(); ++i) {
+        for (const auto& renderUnit : scene.models[i]->renderUnits) {
+            scratch.units.push_back(ExtractScratch::UnitRef{i, &renderUnit});
+        }
+    }
+
+    const auto unitCount = static_cast<uint32_t>(scratch.units.size());
+    const uint32_t chunkCount = (unitCount + kUnitsPerChunk - 1) / kUnitsPerChunk;
+    if (scratch.chunks.size() < chunkCount) {
+        scratch.chunks.resize(chunkCount);
+    }
+
+    const Frustum frustum = Frustum::FromViewProj(scene.cameraData.viewProj);
+    const auto extractChunk = [&](uint32_t c, auto&& resolvePipeline) {
+        ExtractScratch::Chunk& chunk = scratch.chunks[c];
+        chunk.intents.resize(passes.size());
+        for (auto& intents : chunk.intents) {
+            intents.clear();
+        }
+        chunk.missedPipeline = false;
+
+        const uint32_t begin = c * kUnitsPerChunk;
+        const uint32_t end = std::min(unitCount, begin + kUnitsPerChunk);
+        std::span<const uint8_t> visible;
+        chunk.culledCount = 0;
+        if (frustumCulling) {
+            chunk.culler.Reset(frustum);
+            for (uint32_t u = begin; u < end; ++u) {
+                const ExtractScratch::UnitRef& unit = scratch.units[u];
+                AddBoundingSphere(chunk.culler, assetManager,
+                                  scene.modelMatrices[unit.modelIndex], *unit.renderUnit);
+            }
+            visible = chunk.culler.Cull();
+            chunk.culledCount = static_cast<uint32_t>(std::ranges::count(visible, uint8_t{0}));
+        }
+
+        for (uint32_t u = begin; u < end; ++u) {
+            if (frustumCulling && !visible[u - begin]) {
+                continue;
+            }
+            const ExtractScratch::UnitRef& unit = scratch.units[u];
+            const bool complete = ExtractRenderUnit(
+                unit.modelIndex, *unit.renderUnit, passes, assetManager, shaderManager,
+                pipelineManager, bindGroupManager, passTargetStates, resolvePipeline,
+                [&](uint32_t passSlot, RenderIntent&& intent) {
+                    chunk.intents[passSlot].push_back(std::move(intent));
+                });
+            if (!complete) {
+                chunk.missedPipeline = true;
+                return;
+            }
+        }
+    };
+
+    // Workers only look pipelines up. Creating them mutates PipelineManager, so chunks that hit a
+    // missing pipeline are redone on this thread afterwards; the result is the same as a serial
+    // extraction.
+    jobSystem.ParallelFor(chunkCount, [&](uint32_t c) {
+        extractChunk(c, [&](const PipelineManager::PipelineConfig& config) {
+            return pipelineManager->FindPipeline(config);
+        });
+    });
+    for (uint32_t c = 0; c < chunkCount; ++c) {
+        if (scratch.chunks[c].missedPipeline) {
+            extractChunk(c, [&](const PipelineManager::PipelineConfig& config) {
+                return std::optional<Handle>(pipelineManager->GetOrCreatePipeline(config));
+            });
+        }
+    }
+
+    // Chunks are merged in unit order, so the queue does not depend on thread scheduling.
+    for (uint32_t c = 0; c < chunkCount; ++c) {
+        outRenderQueue.culledRenderUnits += scratch.chunks[c].culledCount;
+    }
+    for (uint32_t passSlot = 0; passSlot < passes.size(); ++passSlot) {
+        std::vector<RenderIntent>& out = outRenderQueue.renderIntents[passes[passSlot]];
+        size_t total = out.size();
+        for (uint32_t c = 0; c < chunkCount; ++c) {
+            total += scratch.chunks[c].intents[passSlot].size();
+        }
+        out.reserve(total);
+        for (uint32_t c = 0; c < chunkCount; ++c) {
+            std::vector<RenderIntent>& intents = scratch.chunks[c].intents[passSlot];
+            std::move(intents.begin(), intents.end(), std::back_inserter(out));
+            intents.clear();
+        }
+    }
+
+    outRenderQueue.cameraData = scene.cameraData;
+    outRenderQueue.transforms = std::span(scene.modelMatrices.data(), scene.modelMatrices.size());
+    outRenderQueue.dirtyTransformBegin = scene.dirtyTransformBegin;
+    outRenderQueue.dirtyTransformEnd = scene.dirtyTransformEnd;
 }
 
 namespace core::render {
 
 SceneRenderer::SceneRenderer(Device* device,
                              AssetManager* assetManager,
+                             util::JobSystem* jobSystem,
                              wgpu::BindGroupLayoutDescriptor globalBindGroupLayoutDesc)
     : m_device(device),
       m_assetManager(assetManager),
+      m_jobSystem(jobSystem),
       m_layoutCache(std::make_unique<LayoutCache>(device)),
+      m_instanceBuffer(std::make_unique<InstanceBuffer>(device, m_layoutCache.get())),
+      m_gpuCuller(std::make_unique<GpuCuller>(device)),
       m_vertexLayoutManager(std::make_unique<VertexLayoutManager>()),
       m_passManager(std::make_unique<PassManager>()),
       m_textureManager(std::make_unique<TextureManager>(device, assetManager)),
@@ -92,11 +272,18 @@ SceneRenderer::SceneRenderer(Device* device,
       m_bindGroupManager(std::make_unique<BindGroupManager>(device,
                                                             m_shaderManager.get(),
                                                             m_materialManager.get())),
+      m_commandRecorder(std::make_unique<CommandRecorder>(
+          device,
+          device->SupportsMultithreading() ? jobSystem : nullptr)),
+      m_gpuProfiler(std::make_unique<GpuProfiler>(device, m_passManager.get())),
       m_renderGraph(device),
       m_vra(device) {
     m_passManager->RegisterPass<pass::ForwardRenderPass>("ForwardRenderPass");
     m_passManager->RegisterPass<pass::DeferredGBufferPass>("DeferredGBufferPass");
     m_passManager->RegisterPass<pass::DeferredLightingPass>("DeferredLightingPass");
+    m_gpuCullingPassId = m_passManager->RegisterPass<pass::GpuCullingPass>("GpuCullingPass");
+    static_cast<pass::GpuCullingPass*>(m_passManager->GetPass(m_gpuCullingPassId))
+        ->SetCuller(m_gpuCuller.get());
 
     CameraUniformData cameraUniformData;
     wgpu::Buffer globalUniform = device->CreateBufferFromData(
@@ -146,69 +333,84 @@ SceneRenderer::SceneRenderer(Device* device,
         .entryCount = bindGroupEntries.size(),
         .entries = bindGroupEntries.data(),
     });
-
-    m_depthTexture = device->CreateTexture(wgpu::TextureDescriptor{
-        .usage = wgpu::TextureUsage::RenderAttachment,
-        .size =
-            wgpu::Extent3D{
-                .width = device->GetSurfaceConfig().width,
-                .height = device->GetSurfaceConfig().height,
-                .depthOrArrayLayers = 1,
-            },
-        .format = wgpu::TextureFormat::Depth24Plus,
-    });
 }
 
-void SceneRenderer::Setup(std::span<uint32_t> passIDs) {
-    m_compiledGraph =
-        m_renderGraph.Compile(passIDs, m_passManager.get(), m_shaderManager.get(), m_vra);
+void SceneRenderer::Resize(uint32_t width, uint32_t height) {
+    if (m_vra.Resize(width, height) > 0) {
+        m_renderGraph.RefreshBindGroups(m_shaderManager.get(), m_vra);
+    }
 }
 
-inline void RadixSortRenderIntents64(std::vector<core::render::RenderIntent>& intents) {
-    if (intents.empty()) {
-        return;
+wgpu::Texture SceneRenderer::GetExportedTexture(const std::string& name) {
+    if (m_compiledGraph == nullptr) {
+        return nullptr;
     }
+    auto it = m_compiledGraph->subResourceMap.find(ToPropertyID(name));
+    if (it == m_compiledGraph->subResourceMap.end() ||
+        std::ranges::find(m_compiledGraph->exportedResources, it->second) ==
+            m_compiledGraph->exportedResources.end()) {
+        return nullptr;
+    }
+    const SubResource& resource = m_compiledGraph->subResources[it->second];
+    if (resource.kind != SubResource::Kind::Texture || resource.actualResource == UINT32_MAX) {
+        return nullptr;
+    }
+    return m_vra.Get(resource.actualResource);
+}
 
-    std::vector<core::render::RenderIntent> scratchBuffer(intents.size());
-
-    auto* src = &intents;
-    auto* dst = &scratchBuffer;
-
-    const int bitsPerPass = 8;
-    const int bucketCount = 1 << bitsPerPass;
-    const int passCount = sizeof(uint64_t);
-
-    for (int pass = 0; pass < passCount; ++pass) {
-        size_t counts[bucketCount] = {0};
-        size_t offsets[bucketCount] = {0};
-
-        const int shift = pass * bitsPerPass;
-
-        for (const auto& intent : *src) {
-            uint8_t bucket = (intent.sortKey >> shift) & 0xFF;
-            counts[bucket]++;
-        }
+void SceneRenderer::Setup(std::span<uint32_t> passIDs) {
+    m_setupPasses.assign(passIDs.begin(), passIDs.end());
+    CompileGraph();
+}
 
-        size_t total = 0;
-        for (int i = 0; i < bucketCount; ++i) {
-            offsets[i] = total;
-            total += counts[i];
-        }
+void SceneRenderer::InvalidatePass(uint32_t passId) {
+    m_renderGraph.InvalidatePass(passId);
+    if (m_compiledGraph != nullptr) {
+        CompileGraph();
+    }
+}
 
-        for (const auto& intent : *src) {
-            uint8_t bucket = (intent.sortKey >> shift) & 0xFF;
-            (*dst)[offsets[bucket]++] = intent;
-        }
+void SceneRenderer::InvalidateAll() {
+    m_renderGraph.InvalidateAll();
+    if (m_compiledGraph != nullptr) {
+        CompileGraph();
+    }
+}
 
-        std::swap(src, dst);
+void SceneRenderer::SetGpuCullingEnabled(bool enabled) {
+    enabled = enabled && m_device->SupportsIndirectFirstInstance();
+    if (enabled == m_gpuCullingEnabled) {
+        return;
+    }
+    m_gpuCullingEnabled = enabled;
+    if (m_compiledGraph != nullptr) {
+        CompileGraph();
     }
+}
 
-    if (src != &intents) {
-        intents = std::move(scratchBuffer);
+void SceneRenderer::CompileGraph() {
+    m_graphPasses.clear();
+    if (m_gpuCullingEnabled) {
+        m_graphPasses.push_back(m_gpuCullingPassId);
     }
+    m_graphPasses.insert(m_graphPasses.end(), m_setupPasses.begin(), m_setupPasses.end());
+    m_compiledGraph =
+        &m_renderGraph.Compile(m_graphPasses, m_passManager.get(), m_shaderManager.get(), m_vra);
 }
 
-void SceneRenderer::Render(const Scene& scene, std::span<uint32_t> passIDs) {
+bool SceneRenderer::Render(const Scene& scene) {
+    if (m_compiledGraph == nullptr) {
+        return false;
+    }
+    // Surface-sized attachments and transients must agree in size within a render pass.
+    const wgpu::Texture surfaceTexture = m_device->GetCurrentTexture();
+    if (surfaceTexture == nullptr || surfaceTexture.GetWidth() != m_vra.GetWidth() ||
+        surfaceTexture.GetHeight() != m_vra.GetHeight()) {
+        return false;
+    }
+    m_vra.InjectExternalResource(core::render::TransientResourcePool::kSurfaceTextureIndex,
+                                 surfaceTexture);
+
     m_renderQueue.Clear();
 
     std::span<Handle> dirties = m_materialManager->GetDirtyMaterials();
@@ -217,14 +419,19 @@ void SceneRenderer::Render(const Scene& scene, std::span<uint32_t> passIDs) {
     }
     m_materialManager->ClearDirties();
 
-    SceneCuller::ExtractRenderQueue(scene, passIDs, m_assetManager, m_shaderManager.get(),
-                                    m_pipelineManager.get(), m_bindGroupManager.get(),
-                                    m_compiledGraph.targetStates, m_renderQueue);
-    Prepare(m_compiledGraph, m_renderQueue);
-    Execute(m_compiledGraph, m_renderQueue);
+    SceneCuller::ExtractRenderQueueParallel(
+        scene, m_compiledGraph->executionOrder, m_assetManager, m_shaderManager.get(),
+        m_pipelineManager.get(), m_bindGroupManager.get(), m_compiledGraph->targetStates,
+        *m_jobSystem, m_extractScratch, m_renderQueue, !m_gpuCullingEnabled);
+    Prepare(*m_compiledGraph, m_renderQueue);
+    Execute(*m_compiledGraph, m_renderQueue);
+    UpdateFrameStats(m_renderQueue);
+    return true;
 }
 
-void SceneRenderer::Prepare(CompiledGraph& compiledGraph, RenderQueue& renderQueue) {
+void SceneRenderer::Prepare(const CompiledGraph& compiledGraph, RenderQueue& renderQueue) {
+    ENGINE_PROFILE_SCOPE("SceneRenderer::Prepare");
+    m_instanceBatcher.Reset();
     for (uint32_t i = 0; i < compiledGraph.executionOrder.size(); ++i) {
         uint32_t nodeId = compiledGraph.executionOrder[i];
 
@@ -246,28 +453,86 @@ void SceneRenderer::Prepare(CompiledGraph& compiledGraph, RenderQueue& renderQue
             }
         }
 
-        RadixSortRenderIntents64(renderQueue.renderIntents[nodeId]);
+        m_intentSorter.Sort(renderQueue.renderIntents[nodeId]);
+        m_instanceBatcher.Batch(renderQueue.renderIntents[nodeId], m_instancingEnabled);
+    }
+
+    if (m_gpuCullingEnabled) {
+        m_gpuCuller->Reset(Frustum::FromViewProj(renderQueue.cameraData.viewProj));
+        for (uint32_t nodeId : compiledGraph.executionOrder) {
+            m_gpuCuller->AddDraws(renderQueue.renderIntents[nodeId],
+                                  m_instanceBatcher.GetInstances());
+        }
     }
 }
 
-void SceneRenderer::Execute(CompiledGraph& compiledGraph, RenderQueue& renderQueue) {
+void SceneRenderer::Execute(const CompiledGraph& compiledGraph, RenderQueue& renderQueue) {
+    ENGINE_PROFILE_SCOPE("SceneRenderer::Execute");
     auto d = m_device->GetDevice();
-    m_vra.InjectExternalResource(core::render::TransientResourcePool::kSurfaceTextureIndex,
-                                 m_device->GetCurrentTexture());
 
     auto& cameraData = renderQueue.cameraData;
-    d.GetQueue().WriteBuffer(m_globalUniformBuffer, 0, &cameraData, sizeof(CameraUniformData));
+    m_device->WriteBuffer(m_globalUniformBuffer, 0, &cameraData, sizeof(CameraUniformData));
+    m_instanceBuffer->UploadTransforms(renderQueue.transforms, renderQueue.dirtyTransformBegin,
+                                       renderQueue.dirtyTransformEnd);
+    if (m_gpuCullingEnabled) {
+        // The culling dispatch writes the instance list; the batcher's list only bounds its size.
+        m_instanceBuffer->ReserveInstances(
+            static_cast<uint32_t>(m_instanceBatcher.GetInstances().size()));
+        m_gpuCuller->Upload();
+        // Both may have been reallocated to grow; the culling pass resolves them every frame.
+        m_vra.InjectExternalBuffer(ToPropertyID(pass::GpuCullingPass::kTransformsName),
+                                   m_instanceBuffer->GetTransformBuffer());
+        m_vra.InjectExternalBuffer(ToPropertyID(pass::GpuCullingPass::kVisibleInstancesName),
+                                   m_instanceBuffer->GetInstanceBuffer());
+    } else {
+        m_instanceBuffer->UploadInstances(m_instanceBatcher.GetInstances());
+    }
+    const wgpu::Buffer indirectBuffer =
+        m_gpuCullingEnabled ? m_gpuCuller->GetIndirectBuffer() : nullptr;
+
+    const AssetRegistry assetRegistry = m_assetManager->GetRegistry();
+    m_nodeRecordings.clear();
+    for (uint32_t nodeId : compiledGraph.executionOrder) {
+        m_nodeRecordings.push_back(CommandRecorder::NodeRecording{
+            .pass = compiledGraph.renderNodes[nodeId].pass,
+            .targetState = &compiledGraph.targetStates[nodeId],
+            .globalBindGroup = m_globalBindGroup,
+            .passBindGroup = compiledGraph.renderNodes[nodeId].m_bindGroup,
+            .instanceBindGroup = m_instanceBuffer->GetBindGroup(),
+            .indirectBuffer = indirectBuffer,
+            .intents = renderQueue.renderIntents[nodeId],
+            .assetRegistry = assetRegistry,
+        });
+    }
+    m_commandRecorder->RecordBundles(m_nodeRecordings, m_nodeBundles, m_nodeCommands);
+    m_encodedCommands = {};
+    m_gpuProfiler->BeginFrame();
 
     auto commandEncoder = d.CreateCommandEncoder();
     for (uint32_t i = 0; i < compiledGraph.executionOrder.size(); ++i) {
         uint32_t nodeId = compiledGraph.executionOrder[i];
 
+        if (compiledGraph.renderNodes[nodeId].type == PassType::Compute) {
+            const wgpu::ComputePassDescriptor computePassDescriptor{
+                .timestampWrites = m_gpuProfiler->WriteNode(nodeId),
+            };
+            wgpu::ComputePassEncoder encoder =
+                commandEncoder.BeginComputePass(&computePassDescriptor);
+            const ResourceResolver resolver(compiledGraph.passNodes[nodeId],
+                                            compiledGraph.subResourceMap,
+                                            compiledGraph.subResources, &m_vra);
+            static_cast<IComputePass*>(compiledGraph.renderNodes[nodeId].pass)
+                ->ExecuteCompute(encoder, {.device = m_device, .resources = resolver});
+            encoder.End();
+            continue;
+        }
+
         wgpu::RenderPassDescriptor renderPassDescriptor{};
 
         std::vector<wgpu::RenderPassColorAttachment> colorAttachments;
         colorAttachments.reserve(compiledGraph.renderNodes[nodeId].attachments.size());
         for (const auto& attach : compiledGraph.renderNodes[nodeId].attachments) {
-            wgpu::TextureView view = m_vra.Get(attach.resourceIdx).CreateView();
+            wgpu::TextureView view = m_vra.GetView(attach.resourceIdx);
             colorAttachments.push_back(wgpu::RenderPassColorAttachment{
                 .view = view,
                 .loadOp = attach.colorAttach.loadOp,
@@ -281,12 +546,10 @@ void SceneRenderer::Execute(CompiledGraph& compiledGraph, RenderQueue& renderQue
 
         wgpu::RenderPassDepthStencilAttachment depthStencilAttach;
         if (compiledGraph.renderNodes[nodeId].depthStencilAttachment) {
-            const auto& desc =
-                compiledGraph.renderNodes[nodeId].depthStencilAttachment->depthStencilAttach;
+            const auto& depthAttach = *compiledGraph.renderNodes[nodeId].depthStencilAttachment;
+            const auto& desc = depthAttach.depthStencilAttach;
 
-            depthStencilAttach.view =
-                m_vra.Get(compiledGraph.renderNodes[nodeId].depthStencilAttachment->resourceIdx)
-                    .CreateView();
+            depthStencilAttach.view = m_vra.GetView(depthAttach.resourceIdx);
             depthStencilAttach.depthClearValue = desc.depthClearValue;
             depthStencilAttach.depthLoadOp = desc.depthLoadOp;
             depthStencilAttach.depthStoreOp = desc.depthStoreOp;
@@ -296,20 +559,64 @@ void SceneRenderer::Execute(CompiledGraph& compiledGraph, RenderQueue& renderQue
 
             renderPassDescriptor.depthStencilAttachment = &depthStencilAttach;
         }
+        renderPassDescriptor.timestampWrites = m_gpuProfiler->WriteNode(nodeId);
         wgpu::RenderPassEncoder encoder = commandEncoder.BeginRenderPass(&renderPassDescriptor);
-        encoder.SetBindGroup(0, m_globalBindGroup);
-        encoder.SetBindGroup(BindSlot::Pass, compiledGraph.renderNodes[nodeId].m_bindGroup);
-        compiledGraph.renderNodes[nodeId].pass->Execute(
-            encoder, {
-                         .intents = renderQueue.renderIntents[nodeId],
-                         .assetRegistry = m_assetManager->GetRegistry(),
-                         .proceduralPipeline = renderQueue.proceduralPipelines[nodeId],
-                     });
+        const std::vector<wgpu::RenderBundle>& bundles = m_nodeBundles[i];
+        if (!bundles.empty()) {
+            encoder.ExecuteBundles(bundles.size(), bundles.data());
+            m_encodedCommands += m_nodeCommands[i];
+        } else {
+            const PassExecuteContext executeContext{
+                .intents = renderQueue.renderIntents[nodeId],
+                .assetRegistry = assetRegistry,
+                .proceduralPipeline = renderQueue.proceduralPipelines[nodeId],
+                .indirectBuffer = indirectBuffer,
+            };
+            const auto setBindGroups = [&](auto& target) {
+                target.SetBindGroup(0, m_globalBindGroup);
+                target.SetBindGroup(BindSlot::Pass, compiledGraph.renderNodes[nodeId].m_bindGroup);
+                target.SetBindGroup(BindSlot::Instance, m_instanceBuffer->GetBindGroup());
+            };
+            setBindGroups(encoder);
+            compiledGraph.renderNodes[nodeId].pass->Execute(encoder, executeContext);
+
+            // Only inline nodes are counted here: small ones, and passes that can't record
+            // bundles. Bundle commands were counted when the bundles were recorded.
+            CountingEncoder counter(m_encodedCommands);
+            setBindGroups(counter);
+            compiledGraph.renderNodes[nodeId].pass->CountCommands(counter, executeContext);
+        }
         encoder.End();
     }
 
+    m_gpuProfiler->EndFrame(commandEncoder);
     auto commandBuffer = commandEncoder.Finish();
     d.GetQueue().Submit(1, &commandBuffer);
+    m_gpuProfiler->AfterSubmit();
+}
+
+void SceneRenderer::UpdateFrameStats(const RenderQueue& renderQueue) {
+    FrameStats stats{.frameIndex = m_frameStats.frameIndex + 1};
+    for (uint32_t passId = 0; passId < PassManager::kMaxPasses; ++passId) {
+        stats.intentsPerPass[passId] =
+            static_cast<uint32_t>(renderQueue.renderIntents[passId].size());
+    }
+    stats.culledRenderUnits = renderQueue.culledRenderUnits;
+    stats.commands = m_encodedCommands;
+
+    const uint64_t createdPipelineCount = m_pipelineManager->GetCreatedPipelineCount();
+    const uint64_t createdTextureCount = m_vra.GetCreatedTextureCount();
+    const uint64_t writeBufferBytes = m_device->GetWriteBufferBytes();
+    stats.pipelinesCreated =
+        static_cast<uint32_t>(createdPipelineCount - m_lastCreatedPipelineCount);
+    stats.transientTexturesCreated =
+        static_cast<uint32_t>(createdTextureCount - m_lastCreatedTextureCount);
+    stats.writeBufferBytes = writeBufferBytes - m_lastWriteBufferBytes;
+    m_lastCreatedPipelineCount = createdPipelineCount;
+    m_lastCreatedTextureCount = createdTextureCount;
+    m_lastWriteBufferBytes = writeBufferBytes;
+
+    m_frameStats = stats;
 }
 
 }  // namespace core::render
@@ -1,9 +1,17 @@
 #pragma once
 #include <memory>
 #include <span>
+#include "FrameStats.h"
+#include "FrustumCulling.h"
+#include "InstanceBatcher.h"
+#include "RenderIntentSort.h"
 #include "Scene.h"
 #include "render.h"
 #include "render/backend/BindGroupManager.h"
+#include "render/backend/CommandRecorder.h"
+#include "render/backend/GpuCuller.h"
+#include "render/backend/GpuProfiler.h"
+#include "render/backend/InstanceBuffer.h"
 #include "render/backend/PipelineManager.h"
 #include "render/graph/IRenderPass.h"
 #include "render/graph/RenderGraph.h"
@@ -11,25 +19,61 @@
 #include "render/resource/MeshManager.h"
 #include "render/resource/ShaderManager.h"
 #include "render/resource/TextureManager.h"
+#include "util/JobSystem.h"
 
 namespace core::render {
 
 class SceneCuller {
   public:
     static void ExtractRenderQueue(const Scene& scene,
-                                   std::span<uint32_t> passes,
+                                   std::span<const uint32_t> passes,
                                    AssetManager* assetManager,
                                    ShaderManager* shaderManager,
                                    PipelineManager* pipelineManager,
                                    BindGroupManager* bindGroupManager,
                                    std::span<const PassTargetState> passTargetStates,
                                    RenderQueue& outRenderQueue);
+
+    // Buffers reused across frames by ExtractRenderQueueParallel.
+    struct ExtractScratch {
+        struct UnitRef {
+            uint32_t modelIndex;
+            const RenderUnit* renderUnit;
+        };
+        struct Chunk {
+            // One intent list per entry of passes.
+            std::vector<std::vector<RenderIntent>> intents;
+            FrustumCuller culler;
+            uint32_t culledCount = 0;
+            bool missedPipeline = false;
+        };
+        std::vector<UnitRef> units;
+        std::vector<Chunk> chunks;
+    };
+    static constexpr uint32_t kUnitsPerChunk = 512;
+
+    // Same output as ExtractRenderQueue, with render units extracted in chunks on jobSystem.
+    // Without frustumCulling every render unit is extracted, for culling on the GPU.
+    static void ExtractRenderQueueParallel(const Scene& scene,
+                                           std::span<const uint32_t> passes,
+                                           AssetManager* assetManager,
+                                           ShaderManager* shaderManager,
+                                           PipelineManager* pipelineManager,
+                                           BindGroupManager* bindGroupManager,
+                                           std::span<const PassTargetState> passTargetStates,
+                                           util::JobSystem& jobSystem,
+                                           ExtractScratch& scratch,
+                                           RenderQueue& outRenderQueue,
+                                           bool frustumCulling = true);
 };
 
 class SceneRenderer {
   public:
+    // jobSystem runs extraction and command recording; it is shared with the rest of the engine
+    // and must outlive the renderer.
     SceneRenderer(Device* device,
                   AssetManager* assetManager,
+                  util::JobSystem* jobSystem,
                   wgpu::BindGroupLayoutDescriptor globalBindGroupLayoutDesc);
     ~SceneRenderer() = default;
 
@@ -38,8 +82,17 @@ class SceneRenderer {
     SceneRenderer(SceneRenderer&&) noexcept = default;
     SceneRenderer& operator=(SceneRenderer&&) noexcept = default;
 
+    // Cheap to call again when the pass list changes at runtime; see RenderGraph::Compile.
     void Setup(std::span<uint32_t> passIDs);
-    void Render(const Scene& scene, std::span<uint32_t> passIDs);
+    // Runs IRenderPass::Setup again for the pass, or for every pass, and recompiles the graph.
+    void InvalidatePass(uint32_t passId);
+    void InvalidateAll();
+    // Returns false when the frame was skipped: Setup was never called, no surface texture could
+    // be acquired, or the surface was resized and Resize has not caught the transients up yet.
+    // Renders the passes of the last Setup; passes culled by the graph are not extracted.
+    bool Render(const Scene& scene);
+    // May lag behind Device::Resize. Only RelativeSize transients are reallocated.
+    void Resize(uint32_t width, uint32_t height);
 
     PipelineManager* GetPipelineManager() { return m_pipelineManager.get(); }
     ShaderManager* GetShaderManager() { return m_shaderManager.get(); }
@@ -50,13 +103,49 @@ class SceneRenderer {
     LayoutCache* GetLayoutCache() { return m_layoutCache.get(); }
     PassManager* GetPassManager() { return m_passManager.get(); }
     BindGroupManager* GetBindGroupManager() { return m_bindGroupManager.get(); }
-    RenderGraph* GetRenderGraph() { return &m_renderGraph; }
+    // Const because the compiled graph in use lives in its cache; invalidate through the
+    // SceneRenderer so that graph is recompiled.
+    const RenderGraph* GetRenderGraph() const { return &m_renderGraph; }
+    // Merges repeated draws of the same submesh, pipeline and material into instanced draws.
+    void SetInstancingEnabled(bool enabled) { m_instancingEnabled = enabled; }
+    bool IsInstancingEnabled() const { return m_instancingEnabled; }
+    // Moves frustum culling to a compute pass and draws mesh intents indirectly. The culling
+    // pass is put in front of the Setup pass list, which is recompiled. Batches draw from their
+    // own offset of the instance buffer, so culling stays on the CPU when the device lacks
+    // IndirectFirstInstance; check IsGpuCullingEnabled afterwards.
+    void SetGpuCullingEnabled(bool enabled);
+    bool IsGpuCullingEnabled() const { return m_gpuCullingEnabled; }
+    GpuCuller* GetGpuCuller() { return m_gpuCuller.get(); }
+    CommandRecorder* GetCommandRecorder() { return m_commandRecorder.get(); }
+    util::JobSystem* GetJobSystem() { return m_jobSystem; }
+    GpuProfiler* GetGpuProfiler() { return m_gpuProfiler.get(); }
+    TransientMemoryStats GetTransientMemoryStats() const {
+        return m_compiledGraph != nullptr ? m_compiledGraph->memoryStats : TransientMemoryStats{};
+    }
+    const GraphCompileReport* GetCompileReport() const {
+        return m_compiledGraph != nullptr ? &m_compiledGraph->report : nullptr;
+    }
+    // Indexed by pass id; empty before Setup.
+    std::span<const PassTargetState> GetPassTargetStates() const {
+        if (m_compiledGraph == nullptr) {
+            return {};
+        }
+        return m_compiledGraph->targetStates;
+    }
+    // Statistics of the last rendered frame.
+    const FrameStats& GetFrameStats() const { return m_frameStats; }
+    // Texture a pass exported under name, valid after Render. Null if it was not exported or its
+    // producer was culled.
+    wgpu::Texture GetExportedTexture(const std::string& name);
 
   private:
     Device* m_device;
     AssetManager* m_assetManager;
+    util::JobSystem* m_jobSystem;
 
     std::unique_ptr<LayoutCache> m_layoutCache;
+    std::unique_ptr<InstanceBuffer> m_instanceBuffer;
+    std::unique_ptr<GpuCuller> m_gpuCuller;
     std::unique_ptr<VertexLayoutManager> m_vertexLayoutManager;
     std::unique_ptr<PassManager> m_passManager;
     std::unique_ptr<TextureManager> m_textureManager;
@@ -65,19 +154,44 @@ class SceneRenderer {
     std::unique_ptr<PipelineManager> m_pipelineManager;
     std::unique_ptr<ShaderManager> m_shaderManager;
     std::unique_ptr<BindGroupManager> m_bindGroupManager;
+    std::unique_ptr<CommandRecorder> m_commandRecorder;
+    std::unique_ptr<GpuProfiler> m_gpuProfiler;
     RenderGraph m_renderGraph;
     RenderQueue m_renderQueue;
+    RenderIntentSorter m_intentSorter;
+    InstanceBatcher m_instanceBatcher;
+    bool m_instancingEnabled = true;
+    bool m_gpuCullingEnabled = false;
+    SceneCuller::ExtractScratch m_extractScratch;
 
     wgpu::BindGroup m_globalBindGroup;
     wgpu::Buffer m_globalUniformBuffer;
     wgpu::Sampler m_linearRepeatSampler;
     wgpu::Sampler m_pointSampler;
-    wgpu::Texture m_depthTexture;
     TransientResourcePool m_vra;
-    CompiledGraph m_compiledGraph;
+    // Owned by m_renderGraph's compile cache.
+    const CompiledGraph* m_compiledGraph = nullptr;
+    // Pass list given to Setup, and the one compiled from it.
+    std::vector<uint32_t> m_setupPasses;
+    std::vector<uint32_t> m_graphPasses;
+    uint32_t m_gpuCullingPassId = 0;
+    // Per-frame scratch, kept to avoid reallocating every frame.
+    std::vector<CommandRecorder::NodeRecording> m_nodeRecordings;
+    std::vector<std::vector<wgpu::RenderBundle>> m_nodeBundles;
+    std::vector<CommandStats> m_nodeCommands;
+    // Commands encoded by the last Execute, counted as they were encoded or recorded.
+    CommandStats m_encodedCommands;
+
+    FrameStats m_frameStats;
+    // Lifetime counters as of the last frame; FrameStats reports the difference.
+    uint64_t m_lastCreatedPipelineCount = 0;
+    uint64_t m_lastCreatedTextureCount = 0;
+    uint64_t m_lastWriteBufferBytes = 0;
 
-    void Prepare(CompiledGraph& compiledGraph, RenderQueue& renderQueue);
-    void Execute(CompiledGraph& compiledGraph, RenderQueue& renderQueue);
+    void CompileGraph();
+    void Prepare(const CompiledGraph& compiledGraph, RenderQueue& renderQueue);
+    void Execute(const CompiledGraph& compiledGraph, RenderQueue& renderQueue);
+    void UpdateFrameStats(const RenderQueue& renderQueue);
 };
 
 }  // namespace core::render
@@ -0,0 +1,133 @@
+#include "CommandRecorder.h"
+#include <algorithm>
+
+core::render::CommandRecorder::CommandRecorder(Device* device, util::JobSystem* jobSystem)
+    : m_device(device), m_jobSystem(jobSystem) {}
+
+void core::render::CommandRecorder::RecordBundles(
+    std::span<const NodeRecording> nodes,
+    std::vector<std::vector<wgpu::RenderBundle>>& outBundles,
+    std::vector<CommandStats>& outCommands) {
+    outBundles.resize(nodes.size());
+    for (auto& bundles : outBundles) {
+        bundles.clear();
+    }
+    outCommands.assign(nodes.size(), CommandStats{});
+
+    const uint32_t threadCount = GetWorkerCount() + 1;
+    m_chunks.clear();
+    m_cacheStores.clear();
+    for (uint32_t n = 0; n < nodes.size(); ++n) {
+        const NodeRecording& node = nodes[n];
+        const uint32_t intentCount = static_cast<uint32_t>(node.intents.size());
+        if (!node.pass->SupportsBundleRecording() || intentCount == 0) {
+            continue;
+        }
+
+        // A cached bundle pays off from the second frame on, so cacheable passes always record
+        // into bundles. Others only do when the recording can be spread across workers.
+        RenderBundleCache* cache = node.pass->GetBundleCache();
+        if (cache != nullptr) {
+            ComputeBundleKey(node, m_keyScratch);
+            if (const RenderBundleCache::Entry* cached = cache->Find(m_keyScratch)) {
+                outBundles[n] = cached->bundles;
+                outCommands[n] = cached->commands;
+                continue;
+            }
+            m_cacheStores.emplace_back(n, std::move(m_keyScratch));
+            m_keyScratch = {};
+        } else if (threadCount == 1 || intentCount < kMinIntentsPerBundle) {
+            continue;
+        }
+
+        const uint32_t chunkCount = std::clamp(intentCount / kMinIntentsPerBundle, 1u, threadCount);
+        const uint32_t chunkSize = (intentCount + chunkCount - 1) / chunkCount;
+        outBundles[n].resize(chunkCount);
+        for (uint32_t c = 0; c < chunkCount; ++c) {
+            m_chunks.push_back(Chunk{
+                .node = n,
+                .begin = c * chunkSize,
+                .end = std::min(intentCount, (c + 1) * chunkSize),
+                .out = &outBundles[n][c],
+            });
+        }
+    }
+
+    m_chunkCommands.assign(m_chunks.size(), CommandStats{});
+    const auto recordChunk = [&](uint32_t i) {
+        const Chunk& chunk = m_chunks[i];
+        *chunk.out = RecordChunk(nodes[chunk.node], chunk.begin, chunk.end, m_chunkCommands[i]);
+    };
+    const auto chunkCount = static_cast<uint32_t>(m_chunks.size());
+    if (m_jobSystem != nullptr) {
+        m_jobSystem->ParallelFor(chunkCount, recordChunk);
+    } else {
+        for (uint32_t i = 0; i < chunkCount; ++i) {
+            recordChunk(i);
+        }
+    }
+
+    for (uint32_t i = 0; i < chunkCount; ++i) {
+        outCommands[m_chunks[i].node] += m_chunkCommands[i];
+    }
+
+    for (auto& [node, key] : m_cacheStores) {
+        nodes[node].pass->GetBundleCache()->Store(
+            std::move(key), {.bundles = outBundles[node], .commands = outCommands[node]});
+    }
+}
+
+void core::render::CommandRecorder::ComputeBundleKey(const NodeRecording& node,
+                                                     RenderBundleCache::Key& outKey) {
+    outKey.clear();
+    RenderBundleCache::AppendHandle(node.globalBindGroup.Get(), outKey);
+    RenderBundleCache::AppendHandle(node.passBindGroup.Get(), outKey);
+    RenderBundleCache::AppendHandle(node.instanceBindGroup.Get(), outKey);
+    RenderBundleCache::AppendHandle(node.indirectBuffer.Get(), outKey);
+    outKey.push_back(static_cast<uint64_t>(node.targetState->depthStencilFormat));
+    outKey.push_back(node.targetState->colorTargetFormats.size());
+    for (wgpu::TextureFormat format : node.targetState->colorTargetFormats) {
+        outKey.push_back(static_cast<uint64_t>(format));
+    }
+    RenderBundleCache::AppendIntents(node.intents, outKey);
+}
+
+wgpu::RenderBundle core::render::CommandRecorder::RecordChunk(const NodeRecording& node,
+                                                              uint32_t begin,
+                                                              uint32_t end,
+                                                              CommandStats& outCommands) {
+    const PassTargetState& targetState = *node.targetState;
+    wgpu::RenderBundleEncoderDescriptor desc{
+        .colorFormatCount = targetState.colorTargetFormats.size(),
+        .colorFormats = targetState.colorTargetFormats.data(),
+        .depthStencilFormat = targetState.depthStencilFormat,
+        .sampleCount = 1,
+    };
+    wgpu::RenderBundleEncoder encoder = m_device->GetDevice().CreateRenderBundleEncoder(&desc);
+
+    // Bundles don't inherit state from the render pass they are executed in.
+    const auto setBindGroups = [&node](auto& target) {
+        if (node.globalBindGroup != nullptr) {
+            target.SetBindGroup(0, node.globalBindGroup);
+        }
+        if (node.passBindGroup != nullptr) {
+            target.SetBindGroup(BindSlot::Pass, node.passBindGroup);
+        }
+        if (node.instanceBindGroup != nullptr) {
+            target.SetBindGroup(BindSlot::Instance, node.instanceBindGroup);
+        }
+    };
+    const PassExecuteContext executeContext{
+        .intents = node.intents.subspan(begin, end - begin),
+        .assetRegistry = node.assetRegistry,
+        .proceduralPipeline = nullptr,
+        .indirectBuffer = node.indirectBuffer,
+    };
+    setBindGroups(encoder);
+    node.pass->ExecuteBundle(encoder, executeContext);
+
+    CountingEncoder counter(outCommands);
+    setBindGroups(counter);
+    node.pass->CountCommands(counter, executeContext);
+    return encoder.Finish();
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <webgpu/webgpu_cpp.h>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "CountingEncoder.h"
+#include "RenderBundleCache.h"
+#include "render/graph/IRenderPass.h"
+#include "render/render.h"
+#include "util/JobSystem.h"
+
+namespace core::render {
+
+// Records large passes into render bundles on worker threads. The main thread still owns the
+// command encoder and replays the bundles of each node in execution order, so submission order
+// is unchanged. Passes with a RenderBundleCache reuse last frame's bundles when their intents,
+// bind groups and targets did not change.
+class CommandRecorder {
+  public:
+    // Below this many intents a node is recorded inline; bundle setup would cost more than the
+    // parallelism saves.
+    static constexpr uint32_t kMinIntentsPerBundle = 256;
+
+    struct NodeRecording {
+        IRenderPass* pass = nullptr;
+        const PassTargetState* targetState = nullptr;
+        wgpu::BindGroup globalBindGroup = nullptr;
+        wgpu::BindGroup passBindGroup = nullptr;
+        wgpu::BindGroup instanceBindGroup = nullptr;
+        wgpu::Buffer indirectBuffer = nullptr;
+        std::span<RenderIntent> intents;
+        AssetRegistry assetRegistry;
+    };
+
+    // Without a job system, or with one that has no workers, only cacheable passes are recorded
+    // into bundles and everything else is recorded inline. The job system must only be handed in
+    // when the device supports multithreading.
+    CommandRecorder(Device* device, util::JobSystem* jobSystem);
+
+    CommandRecorder(const CommandRecorder&) = delete;
+    CommandRecorder& operator=(const CommandRecorder&) = delete;
+
+    uint32_t GetWorkerCount() const {
+        return m_jobSystem != nullptr ? m_jobSystem->GetWorkerCount() : 0;
+    }
+
+    // Fills outBundles[i] with the bundles for nodes[i] in draw order, and outCommands[i] with
+    // the commands recorded into them. Commands are counted while recording, and cached bundles
+    // bring their counts along. Nodes left empty have to be recorded inline with
+    // IRenderPass::Execute and are not counted.
+    void RecordBundles(std::span<const NodeRecording> nodes,
+                       std::vector<std::vector<wgpu::RenderBundle>>& outBundles,
+                       std::vector<CommandStats>& outCommands);
+
+    static void ComputeBundleKey(const NodeRecording& node, RenderBundleCache::Key& outKey);
+
+  private:
+    struct Chunk {
+        uint32_t node;
+        uint32_t begin;
+        uint32_t end;
+        wgpu::RenderBundle* out;
+    };
+
+    wgpu::RenderBundle RecordChunk(const NodeRecording& node,
+                                   uint32_t begin,
+                                   uint32_t end,
+                                   CommandStats& outCommands);
+
+    Device* m_device;
+    util::JobSystem* m_jobSystem;
+    std::vector<Chunk> m_chunks;
+    // Indexed like m_chunks; each worker only writes its chunk's entry.
+    std::vector<CommandStats> m_chunkCommands;
+    // (node, key) of cache misses to store once their chunks are recorded.
+    std::vector<std::pair<uint32_t, RenderBundleCache::Key>> m_cacheStores;
+    // Reused across lookups so a cache hit doesn't allocate.
+    RenderBundleCache::Key m_keyScratch;
+};
+}  // namespace core::render
@@ -0,0 +1,67 @@
+#pragma once
+#include <webgpu/webgpu_cpp.h>
+#include <cstdint>
+
+namespace core::render {
+
+struct CommandStats {
+    uint32_t setPipelineCount = 0;
+    uint32_t setBindGroupCount = 0;
+    uint32_t setVertexBufferCount = 0;
+    uint32_t drawCount = 0;
+    uint32_t indirectDrawCount = 0;
+    uint64_t instanceCount = 0;
+    uint64_t indexCount = 0;
+
+    CommandStats& operator+=(const CommandStats& other) {
+        setPipelineCount += other.setPipelineCount;
+        setBindGroupCount += other.setBindGroupCount;
+        setVertexBufferCount += other.setVertexBufferCount;
+        drawCount += other.drawCount;
+        indirectDrawCount += other.indirectDrawCount;
+        instanceCount += other.instanceCount;
+        indexCount += other.indexCount;
+        return *this;
+    }
+};
+
+// Stands in for wgpu::RenderPassEncoder in templated draw loops and only counts the commands
+// that would be encoded, so a pass can report its command stream without touching the GPU.
+class CountingEncoder {
+  public:
+    explicit CountingEncoder(CommandStats& stats) : m_stats(stats) {}
+
+    void SetPipeline(const wgpu::RenderPipeline&) { ++m_stats.setPipelineCount; }
+    void SetBindGroup(uint32_t,
+                      const wgpu::BindGroup&,
+                      size_t = 0,
+                      const uint32_t* = nullptr) {
+        ++m_stats.setBindGroupCount;
+    }
+    void SetVertexBuffer(uint32_t, const wgpu::Buffer&, uint64_t = 0, uint64_t = 0) {
+        ++m_stats.setVertexBufferCount;
+    }
+    void SetIndexBuffer(const wgpu::Buffer&, wgpu::IndexFormat, uint64_t = 0, uint64_t = 0) {}
+    void Draw(uint32_t, uint32_t instanceCount = 1, uint32_t = 0, uint32_t = 0) {
+        ++m_stats.drawCount;
+        m_stats.instanceCount += instanceCount;
+    }
+    void DrawIndexed(uint32_t indexCount,
+                     uint32_t instanceCount = 1,
+                     uint32_t = 0,
+                     int32_t = 0,
+                     uint32_t = 0) {
+        ++m_stats.drawCount;
+        m_stats.instanceCount += instanceCount;
+        m_stats.indexCount += static_cast<uint64_t>(indexCount) * instanceCount;
+    }
+    // Instance and index counts of indirect draws are only known to the GPU.
+    void DrawIndexedIndirect(const wgpu::Buffer&, uint64_t) {
+        ++m_stats.drawCount;
+        ++m_stats.indirectDrawCount;
+    }
+
+  private:
+    CommandStats& m_stats;
+};
+}  // namespace core::render
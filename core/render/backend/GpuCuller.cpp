@@ -0,0 +1,223 @@
+#include "GpuCuller.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string_view>
+#include <thread>
+
+namespace {
+// Same test as FrustumCuller. Survivors are appended to their draw with an atomic, so the
+// order of instances within a draw changes from frame to frame.
+constexpr std::string_view kCullShader = R"(
+struct Candidate {
+    sphere: vec4f,
+    transformIndex: u32,
+    drawIndex: u32,
+};
+
+struct DrawArgs {
+    indexCount: u32,
+    instanceCount: atomic<u32>,
+    firstIndex: u32,
+    baseVertex: i32,
+    firstInstance: u32,
+};
+
+struct Params {
+    planes: array<vec4f, 6>,
+    candidateCount: u32,
+};
+
+@group(0) @binding(0) var<uniform> params: Params;
+@group(0) @binding(1) var<storage, read> candidates: array<Candidate>;
+@group(0) @binding(2) var<storage, read> transforms: array<mat4x4f>;
+@group(0) @binding(3) var<storage, read_write> draws: array<DrawArgs>;
+@group(0) @binding(4) var<storage, read_write> visibleInstances: array<u32>;
+
+@compute @workgroup_size(64)
+fn main(@builtin(global_invocation_id) id: vec3u, @builtin(num_workgroups) groups: vec3u) {
+    let i = id.x + id.y * groups.x * 64u;
+    if (i >= params.candidateCount) {
+        return;
+    }
+    let candidate = candidates[i];
+    let model = transforms[candidate.transformIndex];
+    let center = (model * vec4f(candidate.sphere.xyz, 1.0)).xyz;
+    let scaleSq = max(max(dot(model[0].xyz, model[0].xyz), dot(model[1].xyz, model[1].xyz)),
+                      dot(model[2].xyz, model[2].xyz));
+    let radius = candidate.sphere.w * sqrt(scaleSq);
+    for (var p = 0u; p < 6u; p++) {
+        let plane = params.planes[p];
+        if (dot(plane.xyz, center) + plane.w + radius < 0.0) {
+            return;
+        }
+    }
+    let slot = atomicAdd(&draws[candidate.drawIndex].instanceCount, 1u);
+    visibleInstances[draws[candidate.drawIndex].firstInstance + slot] = candidate.transformIndex;
+}
+)";
+
+constexpr uint32_t kMaxWorkgroupsPerDimension = 65535;
+// WGSL leaves infinities undefined, so meshes without bounds get a sphere that is merely huge.
+constexpr float kUnboundedRadius = 1e30f;
+}  // namespace
+
+core::render::GpuCuller::GpuCuller(Device* device) : m_device(device) {
+    static_assert(sizeof(DrawIndexedIndirectArgs) == 20);
+    static_assert(sizeof(Candidate) == 32);
+    wgpu::ShaderModule module = device->CreateShaderModuleFromWGSL(kCullShader);
+    m_pipeline = device->CreateComputePipeline(wgpu::ComputePipelineDescriptor{
+        .label = "GpuCulling",
+        .compute = {.module = module, .entryPoint = "main"},
+    });
+    m_params = device->CreateBuffer(wgpu::BufferDescriptor{
+        .label = "GpuCullingParams",
+        .usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopyDst,
+        .size = sizeof(Params),
+    });
+}
+
+void core::render::GpuCuller::Reset(const Frustum& frustum) {
+    m_frustum = frustum;
+    m_candidates.clear();
+    m_drawArgs.clear();
+}
+
+void core::render::GpuCuller::AddDraws(std::span<RenderIntent> intents,
+                                       std::span<const uint32_t> instances) {
+    for (RenderIntent& intent : intents) {
+        const auto drawIndex = static_cast<uint32_t>(m_drawArgs.size());
+        m_drawArgs.push_back(DrawIndexedIndirectArgs{
+            .indexCount = intent.subMeshInfo.indexCount,
+            .instanceCount = 0,
+            .firstIndex = intent.subMeshInfo.indexStart,
+            .baseVertex = 0,
+            .firstInstance = intent.firstInstance,
+        });
+        intent.indirectIndex = drawIndex;
+
+        // Batched instances draw the same submesh, so they share its local bounds.
+        glm::vec4 sphere = intent.boundingSphere;
+        if (!std::isfinite(sphere.w)) {
+            sphere.w = kUnboundedRadius;
+        }
+        for (uint32_t i = 0; i < intent.instanceCount; ++i) {
+            m_candidates.push_back(Candidate{
+                .sphere = sphere,
+                .transformIndex = instances[intent.firstInstance + i],
+                .drawIndex = drawIndex,
+            });
+        }
+    }
+}
+
+void core::render::GpuCuller::Upload() {
+    const Params params{
+        .planes = m_frustum.planes,
+        .candidateCount = GetCandidateCount(),
+    };
+    m_device->WriteBuffer(m_params, 0, &params, sizeof(Params));
+    if (m_drawArgs.empty()) {
+        return;
+    }
+
+    Reserve(m_candidatesBuffer, m_candidates.size() * sizeof(Candidate),
+            wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopyDst, "GpuCullingCandidates");
+    Reserve(m_indirect, m_drawArgs.size() * sizeof(DrawIndexedIndirectArgs),
+            wgpu::BufferUsage::Indirect | wgpu::BufferUsage::Storage |
+                wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::CopySrc,
+            "GpuCullingDrawArgs");
+    // Rewriting the arguments also resets every instanceCount the shader counts up.
+    m_device->WriteBuffer(m_candidatesBuffer.buffer, 0, m_candidates.data(),
+                          m_candidates.size() * sizeof(Candidate));
+    m_device->WriteBuffer(m_indirect.buffer, 0, m_drawArgs.data(),
+                          m_drawArgs.size() * sizeof(DrawIndexedIndirectArgs));
+}
+
+void core::render::GpuCuller::Dispatch(wgpu::ComputePassEncoder& pass,
+                                       const wgpu::Buffer& transforms,
+                                       const wgpu::Buffer& visibleInstances) {
+    if (m_candidates.empty()) {
+        return;
+    }
+
+    const std::array<WGPUBuffer, 4> buffers{m_candidatesBuffer.buffer.Get(), transforms.Get(),
+                                            m_indirect.buffer.Get(), visibleInstances.Get()};
+    if (m_bindGroup == nullptr || buffers != m_boundBuffers) {
+        const std::array<wgpu::BindGroupEntry, 5> entries{
+            wgpu::BindGroupEntry{.binding = 0, .buffer = m_params, .size = sizeof(Params)},
+            wgpu::BindGroupEntry{.binding = 1, .buffer = m_candidatesBuffer.buffer},
+            wgpu::BindGroupEntry{.binding = 2, .buffer = transforms},
+            wgpu::BindGroupEntry{.binding = 3, .buffer = m_indirect.buffer},
+            wgpu::BindGroupEntry{.binding = 4, .buffer = visibleInstances},
+        };
+        m_bindGroup = m_device->CreateBindGroup(wgpu::BindGroupDescriptor{
+            .label = "GpuCulling",
+            .layout = m_pipeline.GetBindGroupLayout(0),
+            .entryCount = entries.size(),
+            .entries = entries.data(),
+        });
+        m_boundBuffers = buffers;
+    }
+
+    const uint32_t groupCount = (GetCandidateCount() + kWorkgroupSize - 1) / kWorkgroupSize;
+    const uint32_t groupsX = std::min(groupCount, kMaxWorkgroupsPerDimension);
+    const uint32_t groupsY = (groupCount + groupsX - 1) / groupsX;
+
+    pass.SetPipeline(m_pipeline);
+    pass.SetBindGroup(0, m_bindGroup);
+    pass.DispatchWorkgroups(groupsX, groupsY);
+}
+
+std::vector<core::render::DrawIndexedIndirectArgs> core::render::GpuCuller::ReadbackDrawArgs() {
+    const uint64_t size = m_drawArgs.size() * sizeof(DrawIndexedIndirectArgs);
+    if (size == 0) {
+        return {};
+    }
+    wgpu::Buffer readback = m_device->CreateBuffer(wgpu::BufferDescriptor{
+        .label = "GpuCullingReadback",
+        .usage = wgpu::BufferUsage::MapRead | wgpu::BufferUsage::CopyDst,
+        .size = size,
+    });
+    const wgpu::Device& device = m_device->GetDevice();
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    encoder.CopyBufferToBuffer(m_indirect.buffer, 0, readback, 0, size);
+    wgpu::CommandBuffer commands = encoder.Finish();
+    device.GetQueue().Submit(1, &commands);
+
+    auto done = std::make_shared<bool>(false);
+    readback.MapAsync(wgpu::MapMode::Read, 0, size, wgpu::CallbackMode::AllowProcessEvents,
+                      [done](wgpu::MapAsyncStatus, wgpu::StringView) { *done = true; });
+    m_device->WaitIdle();
+    while (!*done) {
+        m_device->ProcessEvents();
+        std::this_thread::yield();
+    }
+
+    std::vector<DrawIndexedIndirectArgs> args;
+    if (const auto* mapped =
+            static_cast<const DrawIndexedIndirectArgs*>(readback.GetConstMappedRange(0, size))) {
+        args.assign(mapped, mapped + m_drawArgs.size());
+    }
+    readback.Unmap();
+    return args;
+}
+
+void core::render::GpuCuller::Reserve(GrowableBuffer& target,
+                                      uint64_t size,
+                                      wgpu::BufferUsage usage,
+                                      const char* label) {
+    if (size <= target.size) {
+        return;
+    }
+    uint64_t capacity = std::max<uint64_t>(target.size, 4096);
+    while (capacity < size) {
+        capacity *= 2;
+    }
+    target.size = capacity;
+    target.buffer = m_device->CreateBuffer(wgpu::BufferDescriptor{
+        .label = label,
+        .usage = usage,
+        .size = capacity,
+    });
+}
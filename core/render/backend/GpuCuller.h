@@ -0,0 +1,94 @@
+#pragma once
+#include <webgpu/webgpu_cpp.h>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "render/FrustumCulling.h"
+#include "render/graph/IRenderPass.h"
+#include "render/render.h"
+
+namespace core::render {
+
+// Layout of one wgpu DrawIndexedIndirect call in an indirect buffer.
+struct DrawIndexedIndirectArgs {
+    uint32_t indexCount;
+    uint32_t instanceCount;
+    uint32_t firstIndex;
+    int32_t baseVertex;
+    uint32_t firstInstance;
+};
+
+// Frustum culls instances on the GPU and turns batched intents into indirect draws. Every
+// instance InstanceBatcher assigned to a draw becomes a candidate; a compute shader tests its
+// bounding sphere against the frustum and appends the survivors to the draw's instance range,
+// counting them in the draw's instanceCount. The CPU never learns how many instances survived,
+// so the intents, and the render bundles recorded from them, stay the same while the camera and
+// the objects move.
+class GpuCuller {
+  public:
+    static constexpr uint32_t kWorkgroupSize = 64;
+
+    explicit GpuCuller(Device* device);
+
+    // Starts a new frame; draws of the previous one are dropped.
+    void Reset(const Frustum& frustum);
+    // Makes intents draw indirectly, filling RenderIntent::indirectIndex. instances is the frame's
+    // instance list from InstanceBatcher, which intents were batched against.
+    void AddDraws(std::span<RenderIntent> intents, std::span<const uint32_t> instances);
+    uint32_t GetDrawCount() const { return static_cast<uint32_t>(m_drawArgs.size()); }
+    uint32_t GetCandidateCount() const { return static_cast<uint32_t>(m_candidates.size()); }
+
+    void Upload();
+    // Encodes the culling dispatch into pass; see pass::GpuCullingPass. transforms holds the
+    // scene's model matrices and visibleInstances receives the transform index of every surviving
+    // instance; both are the InstanceBuffer's, and visibleInstances needs room for
+    // GetCandidateCount() entries.
+    void Dispatch(wgpu::ComputePassEncoder& pass,
+                  const wgpu::Buffer& transforms,
+                  const wgpu::Buffer& visibleInstances);
+
+    // Valid after Upload; changes when it grows.
+    const wgpu::Buffer& GetIndirectBuffer() const { return m_indirect.buffer; }
+
+    // Copies the draw arguments of the last dispatch back and blocks until the GPU is done. For
+    // tests and debugging only.
+    std::vector<DrawIndexedIndirectArgs> ReadbackDrawArgs();
+
+  private:
+    // Must match the Candidate struct of the culling shader.
+    struct Candidate {
+        glm::vec4 sphere;
+        uint32_t transformIndex;
+        uint32_t drawIndex;
+        uint32_t padding[2];
+    };
+    struct Params {
+        std::array<glm::vec4, 6> planes;
+        uint32_t candidateCount;
+        uint32_t padding[3];
+    };
+    struct GrowableBuffer {
+        wgpu::Buffer buffer;
+        uint64_t size = 0;
+    };
+
+    // Grows by doubling; the contents are not kept.
+    void Reserve(GrowableBuffer& target, uint64_t size, wgpu::BufferUsage usage, const char* label);
+
+    Device* m_device;
+    wgpu::ComputePipeline m_pipeline;
+    wgpu::Buffer m_params;
+    GrowableBuffer m_candidatesBuffer;
+    GrowableBuffer m_indirect;
+    wgpu::BindGroup m_bindGroup;
+    // Buffers m_bindGroup was created with; it is recreated when any of them changes.
+    std::array<WGPUBuffer, 4> m_boundBuffers{};
+
+    Frustum m_frustum{};
+    std::vector<Candidate> m_candidates;
+    std::vector<DrawIndexedIndirectArgs> m_drawArgs;
+};
+}  // namespace core::render
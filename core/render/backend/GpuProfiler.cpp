@@ -0,0 +1,174 @@
+#include "GpuProfiler.h"
+#include <utility>
+
+namespace {
+constexpr uint64_t kQueryCount = core::render::GpuProfiler::kMaxNodesPerFrame * 2;
+constexpr uint64_t kQueryBufferSize = kQueryCount * sizeof(uint64_t);
+}  // namespace
+
+core::render::GpuProfiler::GpuProfiler(Device* device, const PassManager* passManager)
+    : m_device(device), m_passManager(passManager) {
+    const wgpu::Device& d = device->GetDevice();
+    if (!d.HasFeature(wgpu::FeatureName::TimestampQuery)) {
+        return;
+    }
+
+    const wgpu::QuerySetDescriptor querySetDesc{
+        .label = "NodeTimestamps",
+        .type = wgpu::QueryType::Timestamp,
+        .count = kQueryCount,
+    };
+    m_querySet = d.CreateQuerySet(&querySetDesc);
+    m_resolveBuffer = device->CreateBuffer(wgpu::BufferDescriptor{
+        .label = "NodeTimestampsResolve",
+        .usage = wgpu::BufferUsage::QueryResolve | wgpu::BufferUsage::CopySrc,
+        .size = kQueryBufferSize,
+    });
+    for (FrameSlot& slot : m_slots) {
+        slot.readback = device->CreateBuffer(wgpu::BufferDescriptor{
+            .label = "NodeTimestampsReadback",
+            .usage = wgpu::BufferUsage::MapRead | wgpu::BufferUsage::CopyDst,
+            .size = kQueryBufferSize,
+        });
+    }
+}
+
+void core::render::GpuProfiler::BeginFrame() {
+    m_currentSlot = nullptr;
+    if (!IsSupported()) {
+        return;
+    }
+
+    // Delivers MapAsync callbacks of earlier frames; never blocks.
+    m_device->ProcessEvents();
+    for (FrameSlot& slot : m_slots) {
+        if (slot.state == SlotState::Mapping && slot.request->done) {
+            if (slot.request->status == wgpu::MapAsyncStatus::Success) {
+                Resolve(slot);
+                slot.readback.Unmap();
+            }
+            slot.request.reset();
+            slot.state = SlotState::Free;
+        }
+    }
+
+    if (!m_enabled) {
+        return;
+    }
+    for (FrameSlot& slot : m_slots) {
+        if (slot.state == SlotState::Free) {
+            slot.state = SlotState::Recording;
+            slot.passIds.clear();
+            m_currentSlot = &slot;
+            return;
+        }
+    }
+}
+
+const wgpu::PassTimestampWrites* core::render::GpuProfiler::WriteNode(uint32_t passId) {
+    if (m_currentSlot == nullptr || m_currentSlot->passIds.size() >= kMaxNodesPerFrame) {
+        return nullptr;
+    }
+    const uint32_t queryIndex = static_cast<uint32_t>(m_currentSlot->passIds.size()) * 2;
+    m_currentSlot->passIds.push_back(passId);
+    m_timestampWrites = wgpu::PassTimestampWrites{
+        .querySet = m_querySet,
+        .beginningOfPassWriteIndex = queryIndex,
+        .endOfPassWriteIndex = queryIndex + 1,
+    };
+    return &m_timestampWrites;
+}
+
+void core::render::GpuProfiler::EndFrame(wgpu::CommandEncoder& encoder) {
+    if (m_currentSlot == nullptr) {
+        return;
+    }
+    if (m_currentSlot->passIds.empty()) {
+        m_currentSlot->state = SlotState::Free;
+        m_currentSlot = nullptr;
+        return;
+    }
+
+    const uint32_t queryCount = static_cast<uint32_t>(m_currentSlot->passIds.size()) * 2;
+    encoder.ResolveQuerySet(m_querySet, 0, queryCount, m_resolveBuffer, 0);
+    encoder.CopyBufferToBuffer(m_resolveBuffer, 0, m_currentSlot->readback, 0,
+                               queryCount * sizeof(uint64_t));
+    m_currentSlot->state = SlotState::Submitted;
+}
+
+void core::render::GpuProfiler::AfterSubmit() {
+    FrameSlot* slot = std::exchange(m_currentSlot, nullptr);
+    if (slot == nullptr || slot->state != SlotState::Submitted) {
+        return;
+    }
+
+    // The callback only touches the shared request, so it stays safe even if it fires after the
+    // profiler is gone.
+    slot->state = SlotState::Mapping;
+    slot->request = std::make_shared<MapRequest>();
+    slot->readback.MapAsync(
+        wgpu::MapMode::Read, 0, slot->passIds.size() * 2 * sizeof(uint64_t),
+        wgpu::CallbackMode::AllowProcessEvents,
+        [request = slot->request](wgpu::MapAsyncStatus status, wgpu::StringView) {
+            request->status = status;
+            request->done = true;
+        });
+}
+
+void core::render::GpuProfiler::Resolve(FrameSlot& slot) {
+    const size_t size = slot.passIds.size() * 2 * sizeof(uint64_t);
+    const auto* ticks = static_cast<const uint64_t*>(slot.readback.GetConstMappedRange(0, size));
+    if (ticks == nullptr) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < slot.passIds.size(); ++i) {
+        const uint32_t passId = slot.passIds[i];
+        const uint64_t begin = ticks[i * 2];
+        const uint64_t end = ticks[i * 2 + 1];
+        // Timestamps are in nanoseconds; quantization can make end land before begin.
+        const uint64_t durationNs = end > begin ? end - begin : 0;
+        const float ms = static_cast<float>(durationNs) * 1e-6f;
+
+        GpuPassTiming& timing = m_timings[passId];
+        timing.lastMs = ms;
+        timing.averageMs = timing.sampleCount == 0
+                               ? ms
+                               : timing.averageMs + (ms - timing.averageMs) / kAverageWindow;
+        timing.sampleCount++;
+
+        if (m_capturing) {
+            const uint64_t origin = m_captureOrigin.value_or(begin);
+            m_captureOrigin = origin;
+            m_captured.push_back(util::TraceEvent{
+                .name = m_passManager->GetPassName(static_cast<uint8_t>(passId)),
+                .category = "gpu",
+                .startUs = begin > origin ? static_cast<double>(begin - origin) * 1e-3 : 0.0,
+                .durationUs = static_cast<double>(durationNs) * 1e-3,
+            });
+        }
+    }
+}
+
+std::optional<core::render::GpuPassTiming> core::render::GpuProfiler::GetTiming(
+    uint32_t passId) const {
+    if (passId >= m_timings.size() || m_timings[passId].sampleCount == 0) {
+        return std::nullopt;
+    }
+    return m_timings[passId];
+}
+
+void core::render::GpuProfiler::BeginCapture() {
+    m_capturing = true;
+    m_captureOrigin.reset();
+    m_captured.clear();
+}
+
+void core::render::GpuProfiler::EndCapture() {
+    m_capturing = false;
+}
+
+std::expected<void, core::Error> core::render::GpuProfiler::WriteChromeTrace(
+    const std::filesystem::path& filepath) const {
+    return util::WriteChromeTrace(filepath, m_captured);
+}
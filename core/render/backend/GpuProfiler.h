@@ -0,0 +1,95 @@
+#pragma once
+#include <webgpu/webgpu_cpp.h>
+#include <array>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "render/graph/IRenderPass.h"
+#include "render/render.h"
+#include "util/ChromeTrace.h"
+
+namespace core::render {
+
+struct GpuPassTiming {
+    float lastMs = 0.0f;
+    // Exponential moving average over roughly kAverageWindow frames.
+    float averageMs = 0.0f;
+    uint64_t sampleCount = 0;
+};
+
+// Measures the GPU time of every render graph node with timestamp queries. Results are copied
+// into one of kFramesInFlight readback buffers and mapped asynchronously, so the CPU never waits
+// on the GPU; a frame is skipped when every readback buffer is still in flight. Needs the
+// TimestampQuery feature, which the device requests whenever the adapter exposes it. Dawn
+// quantizes timestamps by default and the fallback adapter runs on the CPU, so treat timings
+// there as relative.
+class GpuProfiler {
+  public:
+    static constexpr uint32_t kMaxNodesPerFrame = 64;
+    static constexpr uint32_t kFramesInFlight = 3;
+    static constexpr uint32_t kAverageWindow = 32;
+
+    GpuProfiler(Device* device, const PassManager* passManager);
+
+    bool IsSupported() const { return m_querySet != nullptr; }
+    void SetEnabled(bool enabled) { m_enabled = enabled && IsSupported(); }
+    bool IsEnabled() const { return m_enabled; }
+
+    // Polls pending readbacks and picks a free readback buffer for this frame.
+    void BeginFrame();
+    // Timestamp writes for the next render pass, or nullptr if this frame is not profiled.
+    const wgpu::PassTimestampWrites* WriteNode(uint32_t passId);
+    // Resolves the queries of this frame into its readback buffer. Call before Finish.
+    void EndFrame(wgpu::CommandEncoder& encoder);
+    // Starts the asynchronous readback. Call after the command buffer was submitted.
+    void AfterSubmit();
+
+    std::optional<GpuPassTiming> GetTiming(uint32_t passId) const;
+    const std::array<GpuPassTiming, PassManager::kMaxPasses>& GetTimings() const {
+        return m_timings;
+    }
+
+    // While capturing, every resolved node is also kept as a trace event.
+    void BeginCapture();
+    void EndCapture();
+    std::expected<void, Error> WriteChromeTrace(const std::filesystem::path& filepath) const;
+
+  private:
+    enum class SlotState { Free, Recording, Submitted, Mapping };
+
+    struct MapRequest {
+        wgpu::MapAsyncStatus status = wgpu::MapAsyncStatus::Aborted;
+        bool done = false;
+    };
+
+    struct FrameSlot {
+        wgpu::Buffer readback;
+        std::vector<uint32_t> passIds;
+        SlotState state = SlotState::Free;
+        std::shared_ptr<MapRequest> request;
+    };
+
+    // Reads the timings out of a mapped readback buffer; the caller unmaps it.
+    void Resolve(FrameSlot& slot);
+
+    Device* m_device;
+    const PassManager* m_passManager;
+    bool m_enabled = false;
+
+    wgpu::QuerySet m_querySet;
+    wgpu::Buffer m_resolveBuffer;
+    std::array<FrameSlot, kFramesInFlight> m_slots;
+    FrameSlot* m_currentSlot = nullptr;
+    wgpu::PassTimestampWrites m_timestampWrites;
+
+    std::array<GpuPassTiming, PassManager::kMaxPasses> m_timings{};
+
+    bool m_capturing = false;
+    std::optional<uint64_t> m_captureOrigin;
+    std::vector<util::TraceEvent> m_captured;
+};
+}  // namespace core::render
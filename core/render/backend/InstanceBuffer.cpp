@@ -0,0 +1,125 @@
+#include "InstanceBuffer.h"
+#include <algorithm>
+#include <array>
+
+wgpu::BindGroupLayoutDescriptor core::render::InstanceBuffer::GetLayoutDesc() {
+    static const std::array<wgpu::BindGroupLayoutEntry, 2> entries{
+        wgpu::BindGroupLayoutEntry{
+            .binding = 0,
+            .visibility = wgpu::ShaderStage::Vertex,
+            .buffer =
+                wgpu::BufferBindingLayout{
+                    .type = wgpu::BufferBindingType::ReadOnlyStorage,
+                    .hasDynamicOffset = false,
+                    .minBindingSize = sizeof(uint32_t),
+                }},
+        wgpu::BindGroupLayoutEntry{
+            .binding = 1,
+            .visibility = wgpu::ShaderStage::Vertex,
+            .buffer =
+                wgpu::BufferBindingLayout{
+                    .type = wgpu::BufferBindingType::ReadOnlyStorage,
+                    .hasDynamicOffset = false,
+                    .minBindingSize = sizeof(InstanceUniforms),
+                }},
+    };
+
+    return wgpu::BindGroupLayoutDescriptor{
+        .label = "InstanceBindGroup",
+        .entryCount = entries.size(),
+        .entries = entries.data(),
+    };
+}
+
+core::render::InstanceBuffer::InstanceBuffer(Device* device, LayoutCache* layoutCache)
+    : m_device(device) {
+    wgpu::BindGroupLayoutDescriptor layoutDesc = GetLayoutDesc();
+    m_layout = layoutCache->GetBindGroupLayout(layoutDesc);
+    Reserve(m_instances, kInitialCapacity, sizeof(uint32_t), "InstanceTransformIndices");
+    Reserve(m_transforms, kInitialCapacity, sizeof(InstanceUniforms), "Transforms");
+    CreateBindGroup();
+}
+
+void core::render::InstanceBuffer::UploadTransforms(std::span<const glm::mat4x4> transforms,
+                                                    uint32_t dirtyBegin,
+                                                    uint32_t dirtyEnd) {
+    static_assert(sizeof(InstanceUniforms) == sizeof(glm::mat4x4));
+    const auto count = static_cast<uint32_t>(transforms.size());
+    if (Reserve(m_transforms, count, sizeof(InstanceUniforms), "Transforms")) {
+        CreateBindGroup();
+        m_transformCount = 0;
+    }
+    if (count != m_transformCount) {
+        dirtyBegin = 0;
+        dirtyEnd = count;
+        m_transformCount = count;
+    }
+    dirtyEnd = std::min(dirtyEnd, count);
+    if (dirtyBegin >= dirtyEnd) {
+        return;
+    }
+    m_device->WriteBuffer(m_transforms.buffer, dirtyBegin * sizeof(InstanceUniforms),
+                          transforms.data() + dirtyBegin,
+                          (dirtyEnd - dirtyBegin) * sizeof(InstanceUniforms));
+}
+
+void core::render::InstanceBuffer::UploadInstances(std::span<const uint32_t> transformIndices) {
+    if (transformIndices.empty()) {
+        return;
+    }
+    if (Reserve(m_instances, static_cast<uint32_t>(transformIndices.size()), sizeof(uint32_t),
+                "InstanceTransformIndices")) {
+        CreateBindGroup();
+    }
+    m_device->WriteBuffer(m_instances.buffer, 0, transformIndices.data(),
+                          transformIndices.size_bytes());
+}
+
+void core::render::InstanceBuffer::ReserveInstances(uint32_t count) {
+    if (Reserve(m_instances, count, sizeof(uint32_t), "InstanceTransformIndices")) {
+        CreateBindGroup();
+    }
+}
+
+bool core::render::InstanceBuffer::Reserve(GrowableBuffer& target,
+                                           uint32_t count,
+                                           uint64_t stride,
+                                           const char* label) {
+    if (count <= target.capacity) {
+        return false;
+    }
+    uint32_t capacity = std::max(target.capacity, kInitialCapacity);
+    while (capacity < count) {
+        capacity *= 2;
+    }
+    // Whatever the old buffer held is uploaded again by the caller.
+    target.capacity = capacity;
+    target.buffer = m_device->CreateBuffer(wgpu::BufferDescriptor{
+        .label = label,
+        .usage = wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopyDst,
+        .size = capacity * stride,
+    });
+    return true;
+}
+
+void core::render::InstanceBuffer::CreateBindGroup() {
+    const std::array<wgpu::BindGroupEntry, 2> entries{
+        wgpu::BindGroupEntry{
+            .binding = 0,
+            .buffer = m_instances.buffer,
+            .offset = 0,
+            .size = m_instances.capacity * sizeof(uint32_t),
+        },
+        wgpu::BindGroupEntry{
+            .binding = 1,
+            .buffer = m_transforms.buffer,
+            .offset = 0,
+            .size = m_transforms.capacity * sizeof(InstanceUniforms),
+        },
+    };
+    m_bindGroup = m_device->CreateBindGroup(wgpu::BindGroupDescriptor{
+        .layout = m_layout,
+        .entryCount = entries.size(),
+        .entries = entries.data(),
+    });
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <webgpu/webgpu_cpp.h>
+#include <cstdint>
+#include <span>
+#include <glm/glm.hpp>
+#include <ShaderInterop.h>
+
+#include "LayoutCache.h"
+#include "render/render.h"
+
+namespace core::render {
+
+// GPU side of per-object data, bound at BindSlot::Instance:
+//  - binding 0: the transform index of every instance drawn this frame. A draw reaches its
+//    instances through firstInstance, which the vertex stage sees in SV_InstanceID.
+//  - binding 1: the scene's model matrices, indexed by RenderIntent::transformIndex. They stay
+//    resident between frames and only changed ranges are uploaded.
+// Both buffers grow by doubling and are never shrunk.
+class InstanceBuffer {
+  public:
+    static constexpr uint32_t kInitialCapacity = 1024;
+
+    static wgpu::BindGroupLayoutDescriptor GetLayoutDesc();
+
+    InstanceBuffer(Device* device, LayoutCache* layoutCache);
+
+    // Uploads transforms[dirtyBegin, dirtyEnd) with a single WriteBuffer. All of them are
+    // uploaded instead when the count changed since the last call.
+    void UploadTransforms(std::span<const glm::mat4x4> transforms,
+                          uint32_t dirtyBegin,
+                          uint32_t dirtyEnd);
+    // Replaces the instance list of the frame.
+    void UploadInstances(std::span<const uint32_t> transformIndices);
+    // Makes room for count instances that the GPU writes itself; see GpuCuller.
+    void ReserveInstances(uint32_t count);
+
+    const wgpu::Buffer& GetInstanceBuffer() const { return m_instances.buffer; }
+    const wgpu::Buffer& GetTransformBuffer() const { return m_transforms.buffer; }
+
+    // Always valid, so passes without instanced draws can still satisfy the pipeline layout.
+    // Changes when a buffer grows.
+    const wgpu::BindGroup& GetBindGroup() const { return m_bindGroup; }
+
+  private:
+    struct GrowableBuffer {
+        wgpu::Buffer buffer;
+        uint32_t capacity = 0;
+    };
+
+    // Returns true if the buffer had to be reallocated.
+    bool Reserve(GrowableBuffer& target, uint32_t count, uint64_t stride, const char* label);
+    void CreateBindGroup();
+
+    Device* m_device;
+    wgpu::BindGroupLayout m_layout;
+    GrowableBuffer m_instances;
+    GrowableBuffer m_transforms;
+    uint32_t m_transformCount = 0;
+    wgpu::BindGroup m_bindGroup;
+};
+}  // namespace core::render
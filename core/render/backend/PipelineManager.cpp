@@ -65,9 +65,11 @@ PipelineManager::PipelineManager(Device* device,
       m_vertexLayoutManager(vertexLayoutManager),
       m_passManager(passManager) {
     m_globalBindGroupLayout = m_layoutCache->GetBindGroupLayout(globalBindGroupLayoutDesc);
+    wgpu::BindGroupLayoutDescriptor instanceLayoutDesc = InstanceBuffer::GetLayoutDesc();
+    m_instanceBindGroupLayout = m_layoutCache->GetBindGroupLayout(instanceLayoutDesc);
 }
 
-Handle PipelineManager::GetOrCreatePipeline(const PipelineConfig& config) {
+PipelineKey PipelineManager::MakeKey(const PipelineConfig& config) {
     PipelineKey key{};
     key.bits.shaderId = config.shader.handle.index;
     key.bits.layoutId = config.layoutId;
@@ -79,7 +81,19 @@ Handle PipelineManager::GetOrCreatePipeline(const PipelineConfig& config) {
     key.bits.topology = static_cast<uint64_t>(wgpu::PrimitiveTopology::TriangleList);
     key.bits.cullMode = static_cast<uint64_t>(config.cullMode);
     key.bits.frontFace = static_cast<uint64_t>(wgpu::FrontFace::CCW);
+    return key;
+}
+
+std::optional<Handle> PipelineManager::FindPipeline(const PipelineConfig& config) const {
+    auto it = m_pipelineIDCache.find(MakeKey(config).hash);
+    if (it != m_pipelineIDCache.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
 
+Handle PipelineManager::GetOrCreatePipeline(const PipelineConfig& config) {
+    const PipelineKey key = MakeKey(config);
     auto it = m_pipelineIDCache.find(key.hash);
     if (it != m_pipelineIDCache.end()) {
         return it->second;
@@ -126,9 +140,11 @@ Handle PipelineManager::GetOrCreatePipeline(const PipelineConfig& config) {
     std::vector<wgpu::BindGroupLayout> bindGroupLayouts{
         m_globalBindGroupLayout,
     };
-    for (uint32_t i = 1; i < 4; ++i) {
+    for (uint32_t i = BindSlot::Material; i < BindSlot::Instance; ++i) {
         bindGroupLayouts.push_back(config.shader->GetBindGroupLayout(i));
     }
+    // Owned by the renderer like the global group, so every pipeline can share one bind group.
+    bindGroupLayouts.push_back(m_instanceBindGroupLayout);
 
     wgpu::PipelineLayoutDescriptor pipelineLayoutDesc{
         .bindGroupLayoutCount = bindGroupLayouts.size(),
@@ -162,6 +178,7 @@ Handle PipelineManager::GetOrCreatePipeline(const PipelineConfig& config) {
     };
     const wgpu::DepthStencilState* depthStencilState =
         m_depthStencilStateManager.GetDepthStencilState(key.bits.depthStencilId);
+    ++m_createdPipelineCount;
     wgpu::RenderPipeline renderPipeline =
         m_device->CreateRenderPipeline(wgpu::RenderPipelineDescriptor{
             .label = passName.c_str(),
@@ -1,4 +1,6 @@
 #pragma once
+#include <optional>
+#include "InstanceBuffer.h"
 #include "LayoutCache.h"
 #include "ResourcePool.h"
 #include "render/graph/IRenderPass.h"
@@ -76,14 +78,20 @@ class PipelineManager {
     };
 
     Handle GetOrCreatePipeline(const PipelineConfig& config);
+    // Cache lookup only. Safe to call from several threads while no pipeline is being created.
+    std::optional<Handle> FindPipeline(const PipelineConfig& config) const;
     // wgpu::RenderPipeline GetRenderPipeline(const PipelineDesc& Desc);
     std::span<const wgpu::RenderPipeline> GetAllPipelines() {
         return m_pipelinePool.GetDataSpan();
     };
 
     wgpu::RenderPipeline GetPipeline(Handle handle) { return GetAllPipelines()[handle.index]; }
+    // Number of GetOrCreatePipeline calls that missed the cache.
+    uint64_t GetCreatedPipelineCount() const { return m_createdPipelineCount; }
 
   private:
+    static PipelineKey MakeKey(const PipelineConfig& config);
+
     Device* m_device;
     LayoutCache* m_layoutCache;
     VertexLayoutManager* m_vertexLayoutManager;
@@ -91,9 +99,11 @@ class PipelineManager {
     DepthStencilStateManager m_depthStencilStateManager;
 
     wgpu::BindGroupLayout m_globalBindGroupLayout;
+    wgpu::BindGroupLayout m_instanceBindGroupLayout;
 
     std::unordered_map<uint64_t, Handle> m_pipelineIDCache;
     ResourcePool<wgpu::RenderPipeline> m_pipelinePool;
+    uint64_t m_createdPipelineCount = 0;
     // std::unordered_map<PipelineDesc, wgpu::RenderPipeline, PipelineDescHash> m_pipelineCache;
 };
 }  // namespace core::render
@@ -0,0 +1,44 @@
+#include "RenderBundleCache.h"
+
+void core::render::RenderBundleCache::AppendIntents(std::span<const RenderIntent> intents,
+                                                    Key& outKey) {
+    outKey.push_back(intents.size());
+    for (const RenderIntent& intent : intents) {
+        AppendHandle(intent.pipeline.Get(), outKey);
+        AppendHandle(intent.vertexBuffer.Get(), outKey);
+        AppendHandle(intent.indexBuffer.Get(), outKey);
+        AppendHandle(intent.bindGroup.Get(), outKey);
+        // Transforms are read from the instance buffer, so only the instance range matters.
+        outKey.push_back(uint64_t{intent.firstInstance} << 32 | intent.instanceCount);
+        outKey.push_back(intent.indirectIndex);
+        outKey.push_back(uint64_t{intent.subMeshInfo.indexCount} << 32 |
+                         intent.subMeshInfo.indexStart);
+        // Prefixed with the count so ranges of neighbouring draws can't shift into each other.
+        outKey.push_back(intent.bufferRange.size());
+        for (const auto& range : intent.bufferRange) {
+            outKey.push_back(uint64_t{range.offset} << 32 | range.size);
+        }
+    }
+}
+
+const core::render::RenderBundleCache::Entry* core::render::RenderBundleCache::Find(
+    const Key& key) {
+    if (m_valid && m_key == key) {
+        ++m_hitCount;
+        return &m_entry;
+    }
+    ++m_missCount;
+    return nullptr;
+}
+
+void core::render::RenderBundleCache::Store(Key key, Entry entry) {
+    m_valid = true;
+    m_key = std::move(key);
+    m_entry = std::move(entry);
+}
+
+void core::render::RenderBundleCache::Clear() {
+    m_valid = false;
+    m_key.clear();
+    m_entry = {};
+}
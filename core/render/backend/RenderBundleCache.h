@@ -0,0 +1,48 @@
+#pragma once
+#include <webgpu/webgpu_cpp.h>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "CountingEncoder.h"
+#include "render/graph/IRenderPass.h"
+
+namespace core::render {
+
+// Remembers the render bundles a pass recorded for its last intent list. Mostly static scenes
+// produce the same sorted intents every frame, so the bundles can be replayed as they are.
+class RenderBundleCache {
+  public:
+    // Everything the recorded bundles depend on, flattened in draw order. Lookups compare it in
+    // full, so a changed intent list can never replay stale bundles.
+    using Key = std::vector<uint64_t>;
+
+    // Appends everything a recorded draw depends on to outKey, in draw order.
+    static void AppendIntents(std::span<const RenderIntent> intents, Key& outKey);
+    static void AppendHandle(const void* handle, Key& outKey) {
+        outKey.push_back(reinterpret_cast<uintptr_t>(handle));
+    }
+
+    struct Entry {
+        std::vector<wgpu::RenderBundle> bundles;
+        // Commands recorded into the bundles, counted once when they were recorded.
+        CommandStats commands;
+    };
+
+    // Returns the entry stored under key, or nullptr if the intent set changed since.
+    const Entry* Find(const Key& key);
+    void Store(Key key, Entry entry);
+    void Clear();
+
+    uint64_t GetHitCount() const { return m_hitCount; }
+    uint64_t GetMissCount() const { return m_missCount; }
+
+  private:
+    bool m_valid = false;
+    Key m_key;
+    Entry m_entry;
+
+    uint64_t m_hitCount = 0;
+    uint64_t m_missCount = 0;
+};
+}  // namespace core::render
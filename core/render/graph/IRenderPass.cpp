@@ -40,6 +40,10 @@ void core::render::PassSetupContext::RegisterTextureRead(Handle texture,
     m_readTextures.push_back({texture, viewDesc});
 }
 
+void core::render::PassSetupContext::ExportTexture(Handle texture) {
+    m_exportedTextures.push_back(texture);
+}
+
 core::Handle core::render::PassSetupContext::GetResourceHandle(const std::string& name) {
     uint32_t index = m_requiredTextures.size();
     LocalTexture texture{.name = name};
@@ -47,6 +51,43 @@ core::Handle core::render::PassSetupContext::GetResourceHandle(const std::string
     return Handle(index);
 }
 
+core::Handle core::render::PassSetupContext::DeclareBuffer(const std::string& bindingName,
+                                                           const BufferDescriptor& desc) {
+    LocalBuffer buffer{.name = bindingName, .bufferDesc = desc};
+
+    m_declaredBuffers.push_back(buffer);
+    uint32_t index = m_requiredBuffers.size();
+    m_requiredBuffers.push_back(buffer);
+    return Handle{.index = index, .generation = 0};
+}
+
+core::Handle core::render::PassSetupContext::GetBufferHandle(const std::string& name) {
+    uint32_t index = m_requiredBuffers.size();
+    m_requiredBuffers.push_back(LocalBuffer{.name = name});
+    return Handle(index);
+}
+
+core::Handle core::render::PassSetupContext::ImportBuffer(const std::string& bindingName) {
+    LocalBuffer buffer{.name = bindingName, .imported = true};
+
+    m_declaredBuffers.push_back(buffer);
+    uint32_t index = m_requiredBuffers.size();
+    m_requiredBuffers.push_back(buffer);
+    return Handle{.index = index, .generation = 0};
+}
+
+void core::render::PassSetupContext::ExportBuffer(Handle buffer) {
+    m_exportedBuffers.push_back(buffer);
+}
+
+void core::render::PassSetupContext::RegisterStorageTexture(Handle texture, StorageAccess access) {
+    m_storageTextures.push_back({texture, access});
+}
+
+void core::render::PassSetupContext::RegisterStorageBuffer(Handle buffer, StorageAccess access) {
+    m_storageBuffers.push_back({buffer, access});
+}
+
 core::render::IRenderPass* core::render::PassManager::GetPass(uint8_t id) const {
     return m_passes[id].get();
 }
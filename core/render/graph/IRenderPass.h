@@ -24,6 +24,14 @@ struct RenderIntent {
     // TODO(#10): Populate 64-bit sort key for Radix Sorting
     wgpu::BindGroup bindGroup;
     uint64_t sortKey;
+    // Range of the frame's instance buffer this draw covers; filled in by InstanceBatcher.
+    uint32_t firstInstance = 0;
+    uint32_t instanceCount = 1;
+    // Object space (center, radius) of the submesh, for culling on the GPU.
+    glm::vec4 boundingSphere{0.0f};
+    // Entry of PassExecuteContext::indirectBuffer holding this draw's arguments; filled in by
+    // GpuCuller.
+    uint32_t indirectIndex = 0;
 
     // Helper to generate a deterministic, endian-independent key
     static constexpr uint64_t CreateOpaqueKey(uint64_t pipeline,
@@ -84,8 +92,9 @@ struct TextureDescriptor {
     uint32_t mipLevelCount = 1;
     uint32_t sampleCount = 1;
     // NOTE: viewFormats and viewFormatCount are view-level properties and are intentionally
-    // ignored in comparison (operator==, operator<) and hashing. This allows transient
-    // resources to be shared across passes even if they use different view format casts.
+    // ignored in comparison (operator==, operator<) and hashing. The transient pool still keys
+    // allocations on them (TransientTextureKey), so a texture is only shared between requests
+    // that can view it with the same casts.
     // In a future refactoring, view formats should be decoupled from the allocation descriptor
     // and handled at the texture view registration stage (RegisterRead).
     size_t viewFormatCount = 0;
@@ -158,6 +167,21 @@ struct TextureDescriptor {
     }
 };
 
+// Transient buffers are matched by size alone; usages of buffers that alias are merged.
+struct BufferDescriptor {
+    std::string label;
+    wgpu::BufferUsage usage = wgpu::BufferUsage::None;
+    uint64_t size = 0;
+};
+
+enum class StorageAccess : uint8_t {
+    Read,
+    // Replaces the contents, producing a new version of the resource.
+    Write,
+    // Modifies the previous version in place.
+    ReadWrite,
+};
+
 struct ColorAttachmentInfo {
     wgpu::LoadOp loadOp = wgpu::LoadOp::Clear;
     wgpu::StoreOp storeOp = wgpu::StoreOp::Store;
@@ -184,15 +208,30 @@ struct DepthStencilAttachment {
 };
 
 struct SubResource {
+    enum class Kind : uint8_t {
+        Texture,
+        Buffer,
+    };
     TextureDescriptor textureDesc;
+    Kind kind = Kind::Texture;
+    // Only used by Kind::Buffer.
+    BufferDescriptor bufferDesc;
+    // Declared with PassSetupContext::ImportBuffer; never allocated by the graph.
+    bool imported = false;
+    // Every write produces a new version of the texture: version n is the contents left by
+    // writePassInfos[n - 1], which are kept in pass list order.
     struct ReadInfo {
         uint32_t passId;
+        uint32_t version = 0;
     };
     std::vector<ReadInfo> readPassInfos;
     struct WriteInfo {
         uint32_t passId;
+        // Loads the previous version instead of clearing it, i.e. a read-modify-write.
+        bool preservesContents = false;
     };
     std::vector<WriteInfo> writePassInfos;
+    // A TransientResourcePool texture or buffer handle, depending on kind.
     uint32_t actualResource = UINT32_MAX;
 };
 
@@ -201,11 +240,22 @@ struct LocalTexture {
     TextureDescriptor textureDesc;
 };
 
+struct LocalBuffer {
+    std::string name;
+    BufferDescriptor bufferDesc;
+    bool imported = false;
+};
+
 struct PassReadInfo {
     Handle virTexture;
     std::optional<wgpu::TextureViewDescriptor> viewDesc;
 };
 
+struct PassStorageInfo {
+    Handle resource;
+    StorageAccess access;
+};
+
 struct PassSetupContext {
     constexpr static Handle kSceneColorHandle{.index = 0, .generation = 0};
     constexpr static char const* kSceneColorName = "SceneColor";
@@ -219,30 +269,102 @@ struct PassSetupContext {
     void RegisterTextureRead(Handle texture);
     void RegisterTextureRead(Handle texture, wgpu::TextureViewDescriptor desc);
 
+    // Marks a texture as a graph output. Like SceneColor, its producers are never culled and it
+    // stays alive until the end of the graph so it can be read back after execution.
+    void ExportTexture(Handle texture);
+
     Handle GetResourceHandle(const std::string& name);
 
+    // Buffer handles index a separate list from texture handles. Buffer and texture names share
+    // one namespace in the graph.
+    Handle DeclareBuffer(const std::string& bindingName, const BufferDescriptor& desc);
+    Handle GetBufferHandle(const std::string& name);
+    // Declares a buffer owned outside the graph, supplied every frame through
+    // TransientResourcePool::InjectExternalBuffer. Its contents before the first writer count as
+    // produced, so reading it never culls a pass.
+    Handle ImportBuffer(const std::string& bindingName);
+    // Like ExportTexture: the last writer of the buffer is a graph output and never culled.
+    void ExportBuffer(Handle buffer);
+
+    // Storage bindings, mostly of compute passes. They order and keep alive passes just like
+    // attachments and sampled reads do.
+    void RegisterStorageTexture(Handle texture, StorageAccess access);
+    void RegisterStorageBuffer(Handle buffer, StorageAccess access);
+
     std::vector<LocalTexture> m_declaredTextures = {{"SceneColor"}};
     std::vector<ColorAttachment> m_colorAttachments;
     std::optional<DepthStencilAttachment> m_depthStencilAttachment;
 
     std::vector<LocalTexture> m_requiredTextures = {{"SceneColor"}};
     std::vector<PassReadInfo> m_readTextures;
+    std::vector<Handle> m_exportedTextures;
+
+    std::vector<LocalBuffer> m_declaredBuffers;
+    std::vector<LocalBuffer> m_requiredBuffers;
+    std::vector<PassStorageInfo> m_storageTextures;
+    std::vector<PassStorageInfo> m_storageBuffers;
+    std::vector<Handle> m_exportedBuffers;
 };
 
 struct PassExecuteContext {
     std::span<RenderIntent> intents;
     const AssetRegistry& assetRegistry;
     wgpu::RenderPipeline proceduralPipeline;
+    // Set when intents draw indirectly with arguments written by GpuCuller.
+    wgpu::Buffer indirectBuffer = nullptr;
+};
+
+class Device;
+class ResourceResolver;
+
+struct ComputeExecuteContext {
+    // For creating the pass's pipelines and bind groups.
+    Device* device;
+    // Resolves the textures and buffers the pass registered in Setup by name.
+    const ResourceResolver& resources;
+};
+
+enum class PassType : uint8_t {
+    Render,
+    Compute,
 };
 
+class RenderBundleCache;
+class CountingEncoder;
+
 class IRenderPass {
   public:
     IRenderPass() = default;
     virtual ~IRenderPass() = default;
+    virtual PassType GetType() const { return PassType::Render; }
     virtual void Execute(wgpu::RenderPassEncoder encoder,
                          const PassExecuteContext& executeContext) = 0;
 
     virtual void Setup(PassSetupContext& context) = 0;
+
+    // Passes whose draws depend only on executeContext.intents can have them split into chunks
+    // and recorded into render bundles on worker threads. The bundle encoder starts with the
+    // global and pass bind groups already set.
+    virtual bool SupportsBundleRecording() const { return false; }
+    virtual void ExecuteBundle(wgpu::RenderBundleEncoder encoder,
+                               const PassExecuteContext& executeContext) {}
+    // Passes returning a cache get their bundles replayed while the intent list is unchanged,
+    // and are recorded into bundles even when no worker threads are available.
+    virtual RenderBundleCache* GetBundleCache() { return nullptr; }
+    // Replays the commands Execute would encode into a counter, for FrameStats.
+    virtual void CountCommands(CountingEncoder& encoder,
+                               const PassExecuteContext& executeContext) const {}
+};
+
+// Passes that dispatch compute work. The graph encodes them in their own compute pass, so they
+// have no attachments; their outputs are storage textures and buffers.
+class IComputePass : public IRenderPass {
+  public:
+    PassType GetType() const final { return PassType::Compute; }
+    void Execute(wgpu::RenderPassEncoder, const PassExecuteContext&) final {}
+
+    virtual void ExecuteCompute(wgpu::ComputePassEncoder encoder,
+                                const ComputeExecuteContext& executeContext) = 0;
 };
 
 struct transparent_string_hash {
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <array>
 #include <ranges>
 
@@ -5,6 +6,40 @@
 #include "render/resource/Material.h"
 #include "render/resource/ShaderManager.h"
 
+namespace {
+uint64_t EstimateTextureBytes(const core::render::TransientTextureKey& key) {
+    const size_t unitSize = wgx::GetUnitSize(key.format);
+    if (unitSize == static_cast<size_t>(-1)) {
+        return 0;
+    }
+
+    uint64_t bytes = 0;
+    uint32_t width = key.size.width;
+    uint32_t height = key.size.height;
+    for (uint32_t mip = 0; mip < key.mipLevelCount; ++mip) {
+        bytes += static_cast<uint64_t>(width) * height * key.size.depthOrArrayLayers * unitSize;
+        width = std::max(1u, width / 2);
+        height = std::max(1u, height / 2);
+    }
+    return bytes * key.sampleCount;
+}
+}  // namespace
+
+std::size_t core::render::TransientTextureKeyHash::operator()(
+    const TransientTextureKey& key) const {
+    size_t seed = 0;
+    wgx::hash_combine(seed, std::hash<int>{}(static_cast<int>(key.format)));
+    wgx::hash_combine(seed, std::hash<int>{}(static_cast<int>(key.dimension)));
+    wgx::hash_combine(seed, std::hash<wgpu::Extent3D>{}(key.size));
+    wgx::hash_combine(seed, std::hash<uint32_t>{}(key.mipLevelCount));
+    wgx::hash_combine(seed, std::hash<uint32_t>{}(key.sampleCount));
+    wgx::hash_combine(seed, std::hash<RelativeSize>{}(key.relativeSize));
+    for (wgpu::TextureFormat viewFormat : key.viewFormats) {
+        wgx::hash_combine(seed, std::hash<int>{}(static_cast<int>(viewFormat)));
+    }
+    return seed;
+}
+
 core::render::TransientResourcePool::TransientResourcePool(Device* device) : m_device(device) {
     m_textures.resize(1);  // Reserve index 0 for scene frame texture
     m_config = device->GetSurfaceConfig();
@@ -15,75 +50,473 @@ void core::render::TransientResourcePool::InjectExternalResource(uint32_t handle
     if (handle >= m_textures.size()) {
         m_textures.resize(handle + 1);
     }
-    m_textures[handle] = externalTexture;
+    PhysicalTexture& physical = m_textures[handle];
+    if (physical.texture.Get() != externalTexture.Get()) {
+        physical.texture = externalTexture;
+        physical.views.clear();
+    }
 }
 
-uint32_t core::render::TransientResourcePool::Attache(const TextureDescriptor& desc) {
-    auto it = m_freeResources.find(desc);
-    if (it != m_freeResources.end()) {
-        auto nh = m_freeResources.extract(it);
-        uint32_t index = nh.mapped();
-        m_activeResources.insert(std::move(nh));
-        return index;
-    }
+wgpu::Extent3D core::render::TransientResourcePool::ResolveRelativeSize(
+    const RelativeSize& relativeSize) const {
+    return wgpu::Extent3D{
+        .width = static_cast<uint32_t>(m_config.width * relativeSize.widthRatio),
+        .height = static_cast<uint32_t>(m_config.height * relativeSize.heightRatio),
+    };
+}
 
-    wgpu::TextureDescriptor wgpuDescription{
-        .usage = desc.usage,
-        .dimension = desc.dimension,
-        .size =
-            [&]() {
-                if (const auto* relSize = std::get_if<RelativeSize>(&desc.size)) {
-                    return wgpu::Extent3D{
-                        .width = static_cast<uint32_t>(m_config.width * relSize->widthRatio),
-                        .height = static_cast<uint32_t>(m_config.height * relSize->heightRatio),
-                    };
-                } else {
-                    return *std::get_if<wgpu::Extent3D>(&desc.size);
-                }
-            }(),
+core::render::TransientTextureKey core::render::TransientResourcePool::ResolveKey(
+    const TextureDescriptor& desc) const {
+    TransientTextureKey key{
         .format = desc.format,
+        .dimension = desc.dimension,
         .mipLevelCount = desc.mipLevelCount,
         .sampleCount = desc.sampleCount,
-        .viewFormatCount = desc.viewFormatCount,
-        .viewFormats = desc.viewFormats,
     };
+    if (desc.viewFormatCount > 0) {
+        key.viewFormats.assign(desc.viewFormats, desc.viewFormats + desc.viewFormatCount);
+    }
+    if (const auto* relSize = std::get_if<RelativeSize>(&desc.size)) {
+        key.size = ResolveRelativeSize(*relSize);
+        key.relativeSize = *relSize;
+    } else {
+        key.size = *std::get_if<wgpu::Extent3D>(&desc.size);
+    }
+    return key;
+}
+
+wgpu::Texture core::render::TransientResourcePool::CreatePhysicalTexture(
+    const TransientTextureKey& key,
+    wgpu::TextureUsage usage) {
+    wgpu::TextureDescriptor wgpuDescription{
+        .usage = usage,
+        .dimension = key.dimension,
+        .size = key.size,
+        .format = key.format,
+        .mipLevelCount = key.mipLevelCount,
+        .sampleCount = key.sampleCount,
+        .viewFormatCount = key.viewFormats.size(),
+        .viewFormats = key.viewFormats.data(),
+    };
+    ++m_createdTextureCount;
+    return m_device->CreateTexture(wgpuDescription);
+}
 
-    wgpu::Texture texture = m_device->CreateTexture(wgpuDescription);
-    m_textures.push_back(texture);
+uint32_t core::render::TransientResourcePool::Resize(uint32_t width, uint32_t height) {
+    if (m_config.width == width && m_config.height == height) {
+        return 0;
+    }
+    m_config.width = width;
+    m_config.height = height;
+
+    uint32_t reallocated = 0;
+    std::unordered_map<TransientTextureKey, std::vector<Handle>, TransientTextureKeyHash>
+        freeBuckets;
+    std::unordered_map<TransientTextureKey, wgpu::TextureUsage, TransientTextureKeyHash>
+        bucketUsages;
+    for (const auto& [key, usage] : m_bucketUsages) {
+        if (!key.IsSizeDependent()) {
+            bucketUsages[key] = usage;
+        }
+    }
+
+    for (uint32_t i = kSurfaceTextureIndex + 1; i < m_textures.size(); ++i) {
+        PhysicalTexture& physical = m_textures[i];
+        if (physical.key.IsSizeDependent()) {
+            physical.key.size = ResolveRelativeSize(physical.key.relativeSize);
+            physical.texture = CreatePhysicalTexture(physical.key, physical.usage);
+            physical.views.clear();
+            physical.byteSize = EstimateTextureBytes(physical.key);
+
+            wgpu::TextureUsage& usage = bucketUsages[physical.key];
+            usage = usage | physical.usage;
+            ++reallocated;
+        }
+        if (!physical.active) {
+            freeBuckets[physical.key].push_back(i);
+        }
+    }
+
+    m_freeBuckets = std::move(freeBuckets);
+    m_bucketUsages = std::move(bucketUsages);
+    return reallocated;
+}
+
+void core::render::TransientResourcePool::BeginAllocationScope() {
+    m_liveBytes = 0;
+    m_stats = {};
+}
+
+void core::render::TransientResourcePool::Reserve(const TextureDescriptor& desc) {
+    wgpu::TextureUsage& usage = m_bucketUsages[ResolveKey(desc)];
+    usage = usage | desc.usage;
+}
 
-    uint32_t index = m_textures.size() - 1;
-    m_activeResources.insert(std::make_pair(desc, index));
+uint32_t core::render::TransientResourcePool::Attache(const TextureDescriptor& desc) {
+    const TransientTextureKey key = ResolveKey(desc);
+
+    uint32_t index = UINT32_MAX;
+    std::vector<Handle>& freeList = m_freeBuckets[key];
+    auto it = std::ranges::find_if(freeList, [&](Handle handle) {
+        return (m_textures[handle].usage & desc.usage) == desc.usage;
+    });
+    if (it != freeList.end()) {
+        index = *it;
+        freeList.erase(it);
+    } else {
+        wgpu::TextureUsage& bucketUsage = m_bucketUsages[key];
+        bucketUsage = bucketUsage | desc.usage;
+
+        m_textures.push_back(PhysicalTexture{
+            .texture = CreatePhysicalTexture(key, bucketUsage),
+            .key = key,
+            .usage = bucketUsage,
+            .byteSize = EstimateTextureBytes(key),
+        });
+        index = m_textures.size() - 1;
+    }
+
+    PhysicalTexture& physical = m_textures[index];
+    physical.active = true;
+
+    m_stats.requestCount++;
+    m_stats.naiveBytes += EstimateTextureBytes(key);
+    m_liveBytes += physical.byteSize;
+    m_stats.peakBytes = std::max(m_stats.peakBytes, m_liveBytes);
     return index;
 }
 
 void core::render::TransientResourcePool::Release(const TextureDescriptor& desc,
                                                   TransientResourcePool::Handle handle) {
-    auto range = m_activeResources.equal_range(desc);
-    for (auto it = range.first; it != range.second; ++it) {
-        if (it->second == handle) {
-            m_freeResources.insert(m_activeResources.extract(it));
-            return;
-        }
+    if (handle >= m_textures.size() || !m_textures[handle].active) {
+        assert(false && "Failed to release: Handle not found in active resources!");
+        return;
     }
+    PhysicalTexture& physical = m_textures[handle];
+    assert(physical.key == ResolveKey(desc) && "Released with a different descriptor!");
+
+    physical.active = false;
+    m_liveBytes -= physical.byteSize;
+    m_freeBuckets[physical.key].push_back(handle);
+}
 
-    assert(false && "Failed to release: Handle not found in active resources!");
+void core::render::TransientResourcePool::ReserveBuffer(const BufferDescriptor& desc) {
+    wgpu::BufferUsage& usage = m_bufferBucketUsages[desc.size];
+    usage = usage | desc.usage;
+}
+
+uint32_t core::render::TransientResourcePool::AttacheBuffer(const BufferDescriptor& desc) {
+    uint32_t index = UINT32_MAX;
+    std::vector<Handle>& freeList = m_freeBufferBuckets[desc.size];
+    auto it = std::ranges::find_if(freeList, [&](Handle handle) {
+        return (m_buffers[handle].usage & desc.usage) == desc.usage;
+    });
+    if (it != freeList.end()) {
+        index = *it;
+        freeList.erase(it);
+    } else {
+        wgpu::BufferUsage& bucketUsage = m_bufferBucketUsages[desc.size];
+        bucketUsage = bucketUsage | desc.usage;
+
+        m_buffers.push_back(PhysicalBuffer{
+            .buffer = m_device->CreateBuffer(wgpu::BufferDescriptor{
+                .label = desc.label.c_str(),
+                .usage = bucketUsage,
+                .size = desc.size,
+            }),
+            .size = desc.size,
+            .usage = bucketUsage,
+        });
+        index = m_buffers.size() - 1;
+    }
+
+    PhysicalBuffer& physical = m_buffers[index];
+    physical.active = true;
+
+    m_stats.requestCount++;
+    m_stats.naiveBytes += desc.size;
+    m_liveBytes += physical.size;
+    m_stats.peakBytes = std::max(m_stats.peakBytes, m_liveBytes);
+    return index;
+}
+
+void core::render::TransientResourcePool::ReleaseBuffer(TransientResourcePool::Handle handle) {
+    if (handle >= m_buffers.size() || !m_buffers[handle].active) {
+        assert(false && "Failed to release: Handle not found in active buffers!");
+        return;
+    }
+    PhysicalBuffer& physical = m_buffers[handle];
+    physical.active = false;
+    m_liveBytes -= physical.size;
+    m_freeBufferBuckets[physical.size].push_back(handle);
+}
+
+uint32_t core::render::TransientResourcePool::GetExternalBufferHandle(PropertyId id) {
+    auto [it, inserted] = m_externalBuffers.try_emplace(id, m_buffers.size());
+    if (inserted) {
+        m_buffers.push_back(PhysicalBuffer{.external = true});
+    }
+    return it->second;
+}
+
+void core::render::TransientResourcePool::InjectExternalBuffer(PropertyId id,
+                                                               wgpu::Buffer externalBuffer) {
+    PhysicalBuffer& physical = m_buffers[GetExternalBufferHandle(id)];
+    physical.size = externalBuffer != nullptr ? externalBuffer.GetSize() : 0;
+    physical.buffer = std::move(externalBuffer);
+}
+
+core::render::TransientMemoryStats core::render::TransientResourcePool::GetMemoryStats() const {
+    TransientMemoryStats stats = m_stats;
+    // Index 0 is the externally owned scene color texture.
+    for (uint32_t i = kSurfaceTextureIndex + 1; i < m_textures.size(); ++i) {
+        stats.allocatedBytes += m_textures[i].byteSize;
+        stats.physicalTextureCount++;
+    }
+    for (const PhysicalBuffer& physical : m_buffers) {
+        if (physical.external) {
+            continue;
+        }
+        stats.allocatedBytes += physical.size;
+        stats.physicalBufferCount++;
+    }
+    return stats;
 }
 
 wgpu::Texture core::render::TransientResourcePool::Get(uint32_t index) {
-    return m_textures[index];
+    return m_textures[index].texture;
+}
+
+wgpu::TextureView core::render::TransientResourcePool::GetView(
+    uint32_t handle,
+    const wgpu::TextureViewDescriptor* desc) {
+    PhysicalTexture& physical = m_textures[handle];
+    // A texture rarely has more than a couple of distinct views, a linear scan beats hashing.
+    auto it = std::ranges::find_if(physical.views, [desc](const CachedView& cached) {
+        if (desc == nullptr || !cached.desc.has_value()) {
+            return desc == nullptr && !cached.desc.has_value();
+        }
+        return wgx::Equals(*cached.desc, *desc);
+    });
+    if (it != physical.views.end()) {
+        return it->view;
+    }
+
+    wgpu::TextureView view = physical.texture.CreateView(desc);
+    CachedView cached{.view = view};
+    if (desc != nullptr) {
+        cached.desc = *desc;
+        cached.desc->label = {};
+        cached.desc->nextInChain = nullptr;
+    }
+    physical.views.push_back(std::move(cached));
+    return view;
 }
 
 core::render::RenderGraph::RenderGraph(Device* device) : m_device(device) {}
 
-core::render::CompiledGraph core::render::RenderGraph::Compile(std::span<uint32_t> passes,
-                                                               PassManager* passManager,
-                                                               ShaderManager* shaderManager,
-                                                               TransientResourcePool& vra) {
+size_t core::render::RenderGraph::GraphKeyHash::operator()(const GraphKey& key) const {
+    size_t seed = 0;
+    for (uint32_t passId : key.passes) {
+        wgx::hash_combine(seed, std::hash<uint32_t>{}(passId));
+    }
+    for (uint64_t generation : key.setupGenerations) {
+        wgx::hash_combine(seed, std::hash<uint64_t>{}(generation));
+    }
+    return seed;
+}
+
+bool core::render::RenderGraph::PassBindGroupKey::Read::operator==(const Read& other) const {
+    if (propertyId != other.propertyId || texture != other.texture ||
+        viewDesc.has_value() != other.viewDesc.has_value()) {
+        return false;
+    }
+    return !viewDesc.has_value() || wgx::Equals(*viewDesc, *other.viewDesc);
+}
+
+size_t core::render::RenderGraph::PassBindGroupKeyHash::operator()(
+    const PassBindGroupKey& key) const {
+    size_t seed = 0;
+    wgx::hash_combine(seed, std::hash<uint32_t>{}(key.passId));
+    wgx::hash_combine(seed, std::hash<WGPUBindGroupLayout>{}(key.layout));
+    for (const auto& read : key.reads) {
+        wgx::hash_combine(seed, std::hash<PropertyId>{}(read.propertyId));
+        wgx::hash_combine(seed, std::hash<WGPUTexture>{}(read.texture));
+        if (read.viewDesc.has_value()) {
+            wgx::hash_combine(seed, wgx::Hash(*read.viewDesc));
+        }
+    }
+    for (const auto& storage : key.storages) {
+        wgx::hash_combine(seed, std::hash<PropertyId>{}(storage.propertyId));
+        wgx::hash_combine(seed, std::hash<WGPUTexture>{}(storage.texture));
+        wgx::hash_combine(seed, std::hash<WGPUBuffer>{}(storage.buffer));
+        wgx::hash_combine(seed, std::hash<uint64_t>{}(storage.offset));
+        wgx::hash_combine(seed, std::hash<uint64_t>{}(storage.size));
+    }
+    return seed;
+}
+
+bool core::render::RenderGraph::IsCompiled(std::span<const uint32_t> passes) const {
+    GraphKey graphKey{.passes = {passes.begin(), passes.end()}};
+    for (uint32_t passId : passes) {
+        if (!m_setupCache[passId].has_value()) {
+            return false;
+        }
+        graphKey.setupGenerations.push_back(m_setupCache[passId]->generation);
+    }
+    return m_compiledCache.contains(graphKey);
+}
+
+void core::render::RenderGraph::InvalidatePass(uint32_t passId) {
+    m_setupCache[passId].reset();
+}
+
+void core::render::RenderGraph::InvalidateAll() {
+    for (auto& setup : m_setupCache) {
+        setup.reset();
+    }
+    m_bindGroupCache.clear();
+}
+
+void core::render::RenderGraph::RefreshBindGroups(ShaderManager* shaderManager,
+                                                  TransientResourcePool& vra) {
+    BindGroupCache alive;
+    for (auto& entry : m_compiledCache) {
+        CompiledGraph& compiledGraph = entry.second.graph;
+        for (uint32_t nodeIdx : compiledGraph.executionOrder) {
+            compiledGraph.renderNodes[nodeIdx].m_bindGroup = GetOrCreatePassBindGroup(
+                nodeIdx, compiledGraph.passNodes[nodeIdx], compiledGraph.subResourceMap,
+                compiledGraph.subResources, shaderManager, vra, &alive);
+        }
+    }
+    m_bindGroupCache = std::move(alive);
+}
+
+const core::render::RenderGraph::CachedSetup& core::render::RenderGraph::GetOrSetupPass(
+    uint32_t passId,
+    PassManager* passManager) {
+    std::optional<CachedSetup>& cached = m_setupCache[passId];
+    if (!cached.has_value()) {
+        CachedSetup setup;
+        passManager->GetPass(passId)->Setup(setup.context);
+        setup.generation = m_nextSetupGeneration++;
+        cached = std::move(setup);
+    }
+    return *cached;
+}
+
+const core::render::CompiledGraph& core::render::RenderGraph::Compile(
+    std::span<uint32_t> passes,
+    PassManager* passManager,
+    ShaderManager* shaderManager,
+    TransientResourcePool& vra) {
+    GraphKey graphKey{.passes = {passes.begin(), passes.end()}};
+    for (uint32_t passId : passes) {
+        graphKey.setupGenerations.push_back(GetOrSetupPass(passId, passManager).generation);
+    }
+
+    auto it = m_compiledCache.find(graphKey);
+    if (it == m_compiledCache.end()) {
+        it = m_compiledCache
+                 .emplace(std::move(graphKey),
+                          CachedGraph{.graph = Build(passes, passManager, shaderManager, vra)})
+                 .first;
+    }
+    it->second.lastUsed = ++m_compileCounter;
+    EvictCompiledGraphs();
+    return it->second.graph;
+}
+
+void core::render::RenderGraph::EvictCompiledGraphs() {
+    if (m_compiledCache.size() <= kMaxCompiledGraphs) {
+        return;
+    }
+    while (m_compiledCache.size() > kMaxCompiledGraphs) {
+        auto oldest = std::ranges::min_element(
+            m_compiledCache, {}, [](const auto& entry) { return entry.second.lastUsed; });
+        m_compiledCache.erase(oldest);
+    }
+
+    std::vector<WGPUBindGroup> referenced;
+    for (const auto& [key, cached] : m_compiledCache) {
+        for (uint32_t nodeIdx : cached.graph.executionOrder) {
+            referenced.push_back(cached.graph.renderNodes[nodeIdx].m_bindGroup.Get());
+        }
+    }
+    std::erase_if(m_bindGroupCache, [&referenced](const auto& entry) {
+        return !std::ranges::contains(referenced, entry.second.Get());
+    });
+}
+
+wgpu::BindGroup core::render::RenderGraph::GetOrCreatePassBindGroup(
+    uint32_t passId,
+    const VirtualPassNode& passNode,
+    const std::unordered_map<PropertyId, uint32_t>& subResourceMap,
+    std::span<const SubResource> subResources,
+    ShaderManager* shaderManager,
+    TransientResourcePool& vra,
+    BindGroupCache* outUsed) {
+    std::optional<wgpu::BindGroupLayout> layout = shaderManager->GetPassBindGroupLayout(passId);
+    if (!layout.has_value()) {
+        return nullptr;
+    }
+
+    // A pass bind group only depends on its layout and the resources behind its reads and
+    // storage bindings, so a node whose inputs resolve to the same textures and buffers keeps its
+    // bind group across recompiles.
+    PassBindGroupKey key{.passId = passId, .layout = layout->Get()};
+    for (const auto& read : passNode.readInfos) {
+        const SubResource& subResource = subResources[read.virTextureIndex];
+        key.reads.push_back(PassBindGroupKey::Read{
+            .propertyId = read.bindingResourcePropertyId,
+            .texture = vra.Get(subResource.actualResource).Get(),
+            .viewDesc = read.viewDesc,
+        });
+    }
+    for (const auto& storage : passNode.storageInfos) {
+        const SubResource& subResource = subResources[storage.virResourceIndex];
+        PassBindGroupKey::Storage entry{.propertyId = storage.bindingResourcePropertyId};
+        if (subResource.kind == SubResource::Kind::Buffer) {
+            const wgpu::Buffer buffer = vra.GetBuffer(subResource.actualResource);
+            entry.buffer = buffer.Get();
+            entry.size = buffer != nullptr ? buffer.GetSize() : 0;
+        } else {
+            entry.texture = vra.Get(subResource.actualResource).Get();
+        }
+        key.storages.push_back(entry);
+    }
+
+    wgpu::BindGroup bindGroup = nullptr;
+    if (auto it = m_bindGroupCache.find(key); it != m_bindGroupCache.end()) {
+        bindGroup = it->second;
+    } else {
+        std::span<const ShaderAssetFormat::Binding> bindingInfo =
+            shaderManager->GetPassBindGroupInfo(passId);
+        ResourceResolver resolver(passNode, subResourceMap, subResources, &vra);
+        bindGroup = BindGroupFactory::Create(m_device, layout.value(), bindingInfo,
+                                             RenderGraphProvider{&resolver});
+        m_bindGroupCache[key] = bindGroup;
+    }
+
+    if (outUsed != nullptr) {
+        (*outUsed)[key] = bindGroup;
+    }
+    return bindGroup;
+}
+
+core::render::CompiledGraph core::render::RenderGraph::Build(std::span<uint32_t> passes,
+                                                             PassManager* passManager,
+                                                             ShaderManager* shaderManager,
+                                                             TransientResourcePool& vra) {
     CompiledGraph compiledGraph;
-    std::array<PassSetupContext, PassManager::kMaxPasses> setupContexts;
+    GraphCompileReport& report = compiledGraph.report;
+    std::array<const PassSetupContext*, PassManager::kMaxPasses> setupContexts{};
     std::array<VirtualPassNode, PassManager::kMaxPasses> virtualPasses;
     std::unordered_map<PropertyId, uint32_t> subResourceMap;
     std::vector<SubResource> subResources;
+    std::vector<std::string> subResourceNames;
+    // A pass is viable while every texture it reads has a viable producer.
+    std::array<bool, PassManager::kMaxPasses> viable{};
 
     subResources.push_back(SubResource{
         .textureDesc =
@@ -95,14 +528,15 @@ core::render::CompiledGraph core::render::RenderGraph::Compile(std::span<uint32_
                 .format = m_device->GetSurfaceConfig().format,
             },
         .actualResource = TransientResourcePool::kSurfaceTextureIndex});
+    subResourceNames.push_back(PassSetupContext::kSceneColorName);
     subResourceMap[ToPropertyID(PassSetupContext::kSceneColorName)] =
         PassSetupContext::kSceneColorHandle.index;
 
     for (uint32_t passId : passes) {
-        IRenderPass* pass_ptr = passManager->GetPass(passId);
-        pass_ptr->Setup(setupContexts[passId]);
+        setupContexts[passId] = &m_setupCache[passId]->context;
+        viable[passId] = true;
 
-        const PassSetupContext& ctx = setupContexts[passId];
+        const PassSetupContext& ctx = *setupContexts[passId];
 
         // start at [1] because we need to skip the scene color texture
         for (uint32_t i = PassSetupContext::kSceneColorHandle.index + 1;
@@ -114,11 +548,29 @@ core::render::CompiledGraph core::render::RenderGraph::Compile(std::span<uint32_
             }
             subResourceMap[ToPropertyID(locTexture.name)] = subResources.size();
             subResources.push_back(SubResource{.textureDesc = locTexture.textureDesc});
+            subResourceNames.push_back(locTexture.name);
+        }
+        for (const auto& locBuffer : ctx.m_declaredBuffers) {
+            if (subResourceMap.contains(ToPropertyID(locBuffer.name))) {
+                assert(false && "Pass declared a buffer twice!");
+                continue;
+            }
+            subResourceMap[ToPropertyID(locBuffer.name)] = subResources.size();
+            subResources.push_back(SubResource{
+                .kind = SubResource::Kind::Buffer,
+                .bufferDesc = locBuffer.bufferDesc,
+                .imported = locBuffer.imported,
+                .actualResource =
+                    locBuffer.imported
+                        ? vra.GetExternalBufferHandle(ToPropertyID(locBuffer.name))
+                        : UINT32_MAX,
+            });
+            subResourceNames.push_back(locBuffer.name);
         }
     }
 
     for (uint32_t passId : passes) {
-        const PassSetupContext& ctx = setupContexts[passId];
+        const PassSetupContext& ctx = *setupContexts[passId];
 
         auto GetGlobalResource = [&](const std::string& name) -> uint32_t {
             auto it = subResourceMap.find(ToPropertyID(name));
@@ -129,7 +581,9 @@ core::render::CompiledGraph core::render::RenderGraph::Compile(std::span<uint32_
         for (auto& colorAttach : ctx.m_colorAttachments) {
             LocalTexture locTex = ctx.m_requiredTextures[colorAttach.virTextureHandle.index];
             uint32_t virRsrcIndex = GetGlobalResource(locTex.name);
-            subResources[virRsrcIndex].writePassInfos.push_back({passId});
+            subResources[virRsrcIndex].writePassInfos.push_back(
+                {.passId = passId,
+                 .preservesContents = colorAttach.attachemntInfo.loadOp == wgpu::LoadOp::Load});
             virtualPasses[passId].color.push_back(
                 {.colorAttachementsVirTextureIndex = virRsrcIndex,
                  .colorAttachResourcePropertyID = ToPropertyID(locTex.name),
@@ -142,7 +596,11 @@ core::render::CompiledGraph core::render::RenderGraph::Compile(std::span<uint32_
             LocalTexture locTex =
                 ctx.m_requiredTextures[ctx.m_depthStencilAttachment->virTextureHandle.index];
             uint32_t virRsrcIndex = GetGlobalResource(locTex.name);
-            subResources[virRsrcIndex].writePassInfos.push_back({passId});
+            const DepthStencilAttachmentInfo& info = ctx.m_depthStencilAttachment->attachmentInfo;
+            subResources[virRsrcIndex].writePassInfos.push_back(
+                {.passId = passId,
+                 .preservesContents = info.depthLoadOp == wgpu::LoadOp::Load ||
+                                      info.stencilLoadOp == wgpu::LoadOp::Load});
             virtualPasses[passId].depthStencil = VirtualDepthDtencilAttach{
                 .virTextureIndex = virRsrcIndex,
                 .depthStencilResourcePropertyID = ToPropertyID(locTex.name),
@@ -153,62 +611,216 @@ core::render::CompiledGraph core::render::RenderGraph::Compile(std::span<uint32_
 
         for (auto& read : ctx.m_readTextures) {
             LocalTexture locTex = ctx.m_requiredTextures[read.virTexture.index];
-            uint32_t virRsrcIndex = GetGlobalResource(locTex.name);
+            auto it = subResourceMap.find(ToPropertyID(locTex.name));
+            if (it == subResourceMap.end()) {
+                // The producer is not part of this pass list; the pass can't run.
+                viable[passId] = false;
+                report.missingResources.push_back(locTex.name);
+                continue;
+            }
+            uint32_t virRsrcIndex = it->second;
             subResources[virRsrcIndex].readPassInfos.push_back({passId});
             virtualPasses[passId].readInfos.push_back(
                 {.virTextureIndex = virRsrcIndex,
                  .bindingResourcePropertyId = ToPropertyID(locTex.name),
                  .viewDesc = read.viewDesc});
         }
+
+        // Reads of a missing storage resource cull the pass like sampled reads do. A write
+        // produces a new version; ReadWrite also consumes the previous one.
+        auto AddStorageAccess = [&](const std::string& name, StorageAccess access) {
+            auto it = subResourceMap.find(ToPropertyID(name));
+            if (it == subResourceMap.end()) {
+                viable[passId] = false;
+                report.missingResources.push_back(name);
+                return;
+            }
+            uint32_t virRsrcIndex = it->second;
+            if (access != StorageAccess::Write) {
+                subResources[virRsrcIndex].readPassInfos.push_back({passId});
+            }
+            if (access != StorageAccess::Read) {
+                subResources[virRsrcIndex].writePassInfos.push_back(
+                    {.passId = passId, .preservesContents = access == StorageAccess::ReadWrite});
+            }
+            virtualPasses[passId].storageInfos.push_back({
+                .virResourceIndex = virRsrcIndex,
+                .bindingResourcePropertyId = ToPropertyID(name),
+                .access = access,
+            });
+        };
+        for (const auto& storage : ctx.m_storageTextures) {
+            AddStorageAccess(ctx.m_requiredTextures[storage.resource.index].name, storage.access);
+        }
+        for (const auto& storage : ctx.m_storageBuffers) {
+            AddStorageAccess(ctx.m_requiredBuffers[storage.resource.index].name, storage.access);
+        }
+
+        auto AddExport = [&](const std::string& name) {
+            uint32_t virRsrcIndex = GetGlobalResource(name);
+            if (std::ranges::find(compiledGraph.exportedResources, virRsrcIndex) ==
+                compiledGraph.exportedResources.end()) {
+                compiledGraph.exportedResources.push_back(virRsrcIndex);
+            }
+        };
+        for (Handle exported : ctx.m_exportedTextures) {
+            AddExport(ctx.m_requiredTextures[exported.index].name);
+        }
+        for (Handle exported : ctx.m_exportedBuffers) {
+            AddExport(ctx.m_requiredBuffers[exported.index].name);
+        }
+    }
+
+    std::array<uint32_t, PassManager::kMaxPasses> listPosition{};
+    for (uint32_t i = 0; i < passes.size(); ++i) {
+        listPosition[passes[i]] = i;
     }
 
+    // Pass list order is program order: a read sees the latest version written by a pass listed
+    // before it. A read listed before every writer sees the first version, so single-writer graphs
+    // keep working regardless of list order.
     for (uint32_t i = 0; i < subResources.size(); ++i) {
-        const auto resource = subResources[i];
-        if (resource.writePassInfos.size() > 1) {
-            assert(
-                false &&
-                "Currently we only support one writer for the scene color. Multiple writers will "
-                "cause conflict. We will support multiple writers in the future.");
+        SubResource& resource = subResources[i];
+        if (resource.writePassInfos.empty() && resource.imported) {
+            // Whoever owns the buffer filled it before the graph runs.
+            continue;
         }
         if (resource.writePassInfos.empty()) {
-            // TODO!(Sunghyun) return unexpected behavior here.
-            // We should return an error or unexpected behavior instead of silently ignoring it.
-            assert(false && "No pass writes to this resource!");
+            // Nothing produces the texture, so whoever reads it is culled instead of sampling
+            // garbage. An unread, unwritten declaration is simply never allocated.
+            for (auto readPassInfo : resource.readPassInfos) {
+                viable[readPassInfo.passId] = false;
+            }
+            if (!resource.readPassInfos.empty()) {
+                report.missingResources.push_back(subResourceNames[i]);
+            }
             continue;
         }
-        uint32_t writePassId = resource.writePassInfos[0].passId;
-        VirtualPassNode& writePassNode = virtualPasses[writePassId];
 
-        for (auto readPassInfo : resource.readPassInfos) {
-            writePassNode.successorNodes.push_back(readPassInfo.passId);
+        const auto& writes = resource.writePassInfos;
+        for (auto& readPassInfo : resource.readPassInfos) {
+            // An imported buffer read before its first writer sees the external contents, so the
+            // writer has to wait for it.
+            if (resource.imported &&
+                listPosition[readPassInfo.passId] <= listPosition[writes[0].passId]) {
+                readPassInfo.version = 0;
+                if (readPassInfo.passId != writes[0].passId) {
+                    virtualPasses[writes[0].passId].orderPredecessorNodes.push_back(
+                        readPassInfo.passId);
+                }
+                continue;
+            }
+            uint32_t writeIdx = 0;
+            for (uint32_t w = 1; w < writes.size(); ++w) {
+                if (listPosition[writes[w].passId] < listPosition[readPassInfo.passId]) {
+                    writeIdx = w;
+                }
+            }
+            readPassInfo.version = writeIdx + 1;
+
+            const uint32_t writePassId = writes[writeIdx].passId;
+            if (writePassId == readPassInfo.passId) {
+                continue;
+            }
+            virtualPasses[writePassId].successorNodes.push_back(readPassInfo.passId);
             virtualPasses[readPassInfo.passId].predecessorNodes.push_back(writePassId);
         }
+
+        for (uint32_t w = 1; w < writes.size(); ++w) {
+            const uint32_t prevWriter = writes[w - 1].passId;
+            const uint32_t writer = writes[w].passId;
+            if (writes[w].preservesContents) {
+                virtualPasses[prevWriter].successorNodes.push_back(writer);
+                virtualPasses[writer].predecessorNodes.push_back(prevWriter);
+            } else {
+                virtualPasses[writer].orderPredecessorNodes.push_back(prevWriter);
+            }
+            // Readers of the replaced version have to run before it is overwritten.
+            for (const auto& readPassInfo : resource.readPassInfos) {
+                if (readPassInfo.version == w && readPassInfo.passId != writer) {
+                    virtualPasses[writer].orderPredecessorNodes.push_back(readPassInfo.passId);
+                }
+            }
+        }
     }
 
-    const auto& sceneColorWriters =
-        subResources[PassSetupContext::kSceneColorHandle.index].writePassInfos;
-    assert(!sceneColorWriters.empty() && "No pass writes to SceneColor!");
-    uint32_t sceneColorPassId = sceneColorWriters.empty() ? 0 : sceneColorWriters[0].passId;
+    // Propagate non-viability down the dependency edges until it settles.
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (uint32_t passId : passes) {
+            auto isDead = [&viable](uint32_t predecessor) { return !viable[predecessor]; };
+            if (viable[passId] &&
+                std::ranges::any_of(virtualPasses[passId].predecessorNodes, isDead)) {
+                viable[passId] = false;
+                changed = true;
+            }
+        }
+    }
 
-    std::array<bool, 255> visited{};
-    std::array<bool, 255> onStack{};
+    // Graph outputs are SceneColor and every exported resource, as left by their last viable
+    // writer. Only that writer and the versions it transitively consumes survive.
+    std::vector<uint32_t> rootPasses;
+    auto AddRootsWriting = [&](uint32_t resourceIdx) {
+        const auto& writes = subResources[resourceIdx].writePassInfos;
+        for (auto it = writes.rbegin(); it != writes.rend(); ++it) {
+            if (viable[it->passId]) {
+                rootPasses.push_back(it->passId);
+                break;
+            }
+        }
+    };
+    AddRootsWriting(PassSetupContext::kSceneColorHandle.index);
+    for (uint32_t exported : compiledGraph.exportedResources) {
+        AddRootsWriting(exported);
+    }
+    assert(!rootPasses.empty() && "No live pass writes to SceneColor or an exported resource!");
+
+    // Liveness only follows consumed versions; ordering edges never keep a pass alive.
+    std::array<bool, PassManager::kMaxPasses> live{};
+    std::vector<uint32_t> liveStack = rootPasses;
+    while (!liveStack.empty()) {
+        const uint32_t nodeId = liveStack.back();
+        liveStack.pop_back();
+        if (live[nodeId]) {
+            continue;
+        }
+        live[nodeId] = true;
+        for (auto predecessor : virtualPasses[nodeId].predecessorNodes) {
+            liveStack.push_back(predecessor);
+        }
+    }
+
+    std::array<bool, PassManager::kMaxPasses> visited{};
+    std::array<bool, PassManager::kMaxPasses> onStack{};
     std::vector<uint32_t> executionOrder;
 
     std::function<void(uint32_t)> dfs = [&](uint32_t nodeId) {
         visited[nodeId] = true;
         onStack[nodeId] = true;
-        for (auto predecessor : virtualPasses[nodeId].predecessorNodes) {
+        auto visitPredecessor = [&](uint32_t predecessor) {
+            if (!live[predecessor]) {
+                return;
+            }
             if (!visited[predecessor]) {
                 dfs(predecessor);
             } else if (onStack[predecessor]) {
                 assert(false && "Cycle detected in render graph!");
             }
-        }
+        };
+        std::ranges::for_each(virtualPasses[nodeId].predecessorNodes, visitPredecessor);
+        std::ranges::for_each(virtualPasses[nodeId].orderPredecessorNodes, visitPredecessor);
         onStack[nodeId] = false;
         executionOrder.push_back(nodeId);
     };
 
-    dfs(sceneColorPassId);
+    // Walking in pass list order keeps independent passes in the order they were listed.
+    for (uint32_t passId : passes) {
+        if (!live[passId]) {
+            report.culledPasses.push_back(passId);
+        } else if (!visited[passId]) {
+            dfs(passId);
+        }
+    }
     compiledGraph.executionOrder = std::move(executionOrder);
 
     struct ResourceUsageInfo {
@@ -240,14 +852,44 @@ core::render::CompiledGraph core::render::RenderGraph::Compile(std::span<uint32_
             resourceUsageInfo[readInfo.virTextureIndex].lastUse =
                 std::max(resourceUsageInfo[readInfo.virTextureIndex].lastUse, i);
         }
+        for (const auto& storage : virtualPasses[nodeId].storageInfos) {
+            resourceUsageInfo[storage.virResourceIndex].firstUse =
+                std::min(resourceUsageInfo[storage.virResourceIndex].firstUse, i);
+            resourceUsageInfo[storage.virResourceIndex].lastUse =
+                std::max(resourceUsageInfo[storage.virResourceIndex].lastUse, i);
+        }
+    }
+
+    // Exported resources must not be aliased by anything later in the graph.
+    const int32_t lastStep = static_cast<int32_t>(compiledGraph.executionOrder.size()) - 1;
+    for (uint32_t exported : compiledGraph.exportedResources) {
+        if (resourceUsageInfo[exported].firstUse != INT32_MAX) {
+            resourceUsageInfo[exported].lastUse = lastStep;
+        }
+    }
+
+    vra.BeginAllocationScope();
+    for (uint32_t resrcIdx = PassSetupContext::kSceneColorHandle.index + 1;
+         resrcIdx < resourceUsageInfo.size(); ++resrcIdx) {
+        if (resourceUsageInfo[resrcIdx].firstUse == INT32_MAX) {
+            report.culledResources.push_back(subResourceNames[resrcIdx]);
+        } else if (subResources[resrcIdx].imported) {
+            continue;
+        } else if (subResources[resrcIdx].kind == SubResource::Kind::Buffer) {
+            vra.ReserveBuffer(subResources[resrcIdx].bufferDesc);
+        } else {
+            vra.Reserve(subResources[resrcIdx].textureDesc);
+        }
     }
 
     for (uint32_t step = 0; step < compiledGraph.executionOrder.size(); ++step) {
         for (uint32_t resrcIdx = PassSetupContext::kSceneColorHandle.index + 1;
              resrcIdx < resourceUsageInfo.size(); ++resrcIdx) {
             const auto& sub = subResources[resrcIdx];
-            if (resourceUsageInfo[resrcIdx].firstUse == step) {
-                TransientResourcePool::Handle actual = vra.Attache(sub.textureDesc);
+            if (resourceUsageInfo[resrcIdx].firstUse == step && !sub.imported) {
+                TransientResourcePool::Handle actual = sub.kind == SubResource::Kind::Buffer
+                                                           ? vra.AttacheBuffer(sub.bufferDesc)
+                                                           : vra.Attache(sub.textureDesc);
                 subResources[resrcIdx].actualResource = actual;
             }
         }
@@ -255,8 +897,12 @@ core::render::CompiledGraph core::render::RenderGraph::Compile(std::span<uint32_
         for (uint32_t resrcIdx = PassSetupContext::kSceneColorHandle.index + 1;
              resrcIdx < resourceUsageInfo.size(); ++resrcIdx) {
             const auto& sub = subResources[resrcIdx];
-            if (resourceUsageInfo[resrcIdx].lastUse == step) {
-                vra.Release(sub.textureDesc, sub.actualResource);
+            if (resourceUsageInfo[resrcIdx].lastUse == step && !sub.imported) {
+                if (sub.kind == SubResource::Kind::Buffer) {
+                    vra.ReleaseBuffer(sub.actualResource);
+                } else {
+                    vra.Release(sub.textureDesc, sub.actualResource);
+                }
             }
         }
     }
@@ -264,16 +910,8 @@ core::render::CompiledGraph core::render::RenderGraph::Compile(std::span<uint32_
     for (uint32_t step = 0; step < compiledGraph.executionOrder.size(); ++step) {
         uint32_t nodeIdx = compiledGraph.executionOrder[step];
 
-        wgpu::BindGroup passBindGroup = nullptr;
-        std::optional<wgpu::BindGroupLayout> layout =
-            shaderManager->GetPassBindGroupLayout(nodeIdx);
-        if (layout.has_value()) {
-            std::span<const ShaderAssetFormat::Binding> bindingInfo =
-                shaderManager->GetPassBindGroupInfo(nodeIdx);
-            ResourceResolver resolver(virtualPasses[nodeIdx], subResourceMap, subResources, &vra);
-            passBindGroup = BindGroupFactory::Create(m_device, layout.value(), bindingInfo,
-                                                     RenderGraphProvider{&resolver});
-        }
+        wgpu::BindGroup passBindGroup = GetOrCreatePassBindGroup(
+            nodeIdx, virtualPasses[nodeIdx], subResourceMap, subResources, shaderManager, vra);
 
         std::vector<RenderNode::ColorAttach> colorAttachments =
             virtualPasses[nodeIdx].color |
@@ -295,6 +933,7 @@ core::render::CompiledGraph core::render::RenderGraph::Compile(std::span<uint32_
                 });
         RenderNode node{
             .pass = passManager->GetPass(nodeIdx),
+            .type = passManager->GetPass(nodeIdx)->GetType(),
             .attachments = std::move(colorAttachments),
             .depthStencilAttachment = depthAttach,
             .m_bindGroup = passBindGroup,
@@ -305,6 +944,10 @@ core::render::CompiledGraph core::render::RenderGraph::Compile(std::span<uint32_
 
     compiledGraph.subResources = std::move(subResources);
     compiledGraph.subResourceMap = std::move(subResourceMap);
+    compiledGraph.memoryStats = vra.GetMemoryStats();
+    for (uint32_t nodeIdx : compiledGraph.executionOrder) {
+        compiledGraph.passNodes[nodeIdx] = std::move(virtualPasses[nodeIdx]);
+    }
 
     return compiledGraph;
 }
@@ -323,19 +966,29 @@ wgpu::TextureView core::render::ResourceResolver::GetTextureView(PropertyId id)
     uint32_t virRsourceIndex = m_subResourceMap.at(id);
     const SubResource& subResource = m_subResources[virRsourceIndex];
 
-    wgpu::Texture texture = m_resourcePool->Get(subResource.actualResource);
-
     auto it =
         std::ranges::find(m_passNode.readInfos, id, &VirtualReadInfo::bindingResourcePropertyId);
     if (it == m_passNode.readInfos.end()) {
-        assert(false);
+        assert(std::ranges::contains(m_passNode.storageInfos, id,
+                                     &VirtualStorageInfo::bindingResourcePropertyId) &&
+               "Pass did not register the texture!");
+        return m_resourcePool->GetView(subResource.actualResource);
     }
 
-    const auto optViewDesc = it->viewDesc;
+    const auto& optViewDesc = it->viewDesc;
     const auto* viewPtr = optViewDesc.has_value() ? &(*optViewDesc) : nullptr;
-    return texture.CreateView(viewPtr);
+    return m_resourcePool->GetView(subResource.actualResource, viewPtr);
 }
 
 wgpu::TextureView core::render::RenderGraphProvider::GetTextureView(PropertyId id) {
     return resolver->GetTextureView(id);
 }
+
+wgpu::Buffer core::render::ResourceResolver::GetBuffer(PropertyId id) const {
+    assert(std::ranges::contains(m_passNode.storageInfos, id,
+                                 &VirtualStorageInfo::bindingResourcePropertyId) &&
+           "Pass did not register the buffer!");
+    const SubResource& subResource = m_subResources[m_subResourceMap.at(id)];
+    assert(subResource.kind == SubResource::Kind::Buffer);
+    return m_resourcePool->GetBuffer(subResource.actualResource);
+}
@@ -2,7 +2,9 @@
 
 #include <webgpu/webgpu_cpp.h>
 #include <array>
+#include <optional>
 #include <span>
+#include <unordered_map>
 #include <vector>
 
 #include "IRenderPass.h"
@@ -16,18 +18,27 @@ struct RenderQueue {
     std::array<std::vector<RenderIntent>, PassManager::kMaxPasses> renderIntents;
     std::array<wgpu::RenderPipeline, PassManager::kMaxPasses> proceduralPipelines;
     std::span<const glm::mat4x4> transforms;
+    // transforms[dirtyTransformBegin, dirtyTransformEnd) changed since the last frame.
+    uint32_t dirtyTransformBegin = 0;
+    uint32_t dirtyTransformEnd = 0;
     CameraUniformData cameraData;
+    // Render units SceneCuller dropped because they were outside the view frustum.
+    uint32_t culledRenderUnits = 0;
 
     void Clear() {
         for (uint32_t i = 0; i < PassManager::kMaxPasses; ++i) {
             renderIntents[i].clear();
         }
         transforms = {};
+        dirtyTransformBegin = 0;
+        dirtyTransformEnd = 0;
+        culledRenderUnits = 0;
     }
 };
 
 struct RenderNode {
     IRenderPass* pass = nullptr;
+    PassType type = PassType::Render;
     struct ColorAttach {
         uint32_t resourceIdx;
         ColorAttachmentInfo colorAttach;
@@ -41,24 +52,138 @@ struct RenderNode {
     wgpu::BindGroup m_bindGroup = nullptr;
 };
 
+// Allocation identity of a transient texture. Requests that resolve to the same key can share one
+// physical texture whenever their lifetimes do not overlap, regardless of usage.
+struct TransientTextureKey {
+    wgpu::TextureFormat format = wgpu::TextureFormat::Undefined;
+    wgpu::TextureDimension dimension = wgpu::TextureDimension::Undefined;
+    wgpu::Extent3D size;
+    uint32_t mipLevelCount = 1;
+    uint32_t sampleCount = 1;
+    // Zero for fixed Extent3D requests. Relative textures are kept apart from fixed ones of the
+    // same resolved size because only they are reallocated on resize.
+    RelativeSize relativeSize;
+    // Formats the texture may be viewed as. A texture created without a cast format cannot serve
+    // a request that needs it, and Resize re-creates textures from the key alone.
+    std::vector<wgpu::TextureFormat> viewFormats;
+
+    bool IsSizeDependent() const { return relativeSize.widthRatio != 0.0f; }
+
+    bool operator==(const TransientTextureKey& other) const {
+        return format == other.format && dimension == other.dimension &&
+               size.width == other.size.width && size.height == other.size.height &&
+               size.depthOrArrayLayers == other.size.depthOrArrayLayers &&
+               mipLevelCount == other.mipLevelCount && sampleCount == other.sampleCount &&
+               relativeSize == other.relativeSize && viewFormats == other.viewFormats;
+    }
+};
+
+struct TransientTextureKeyHash {
+    std::size_t operator()(const TransientTextureKey& key) const;
+};
+
+struct TransientMemoryStats {
+    // Bytes needed if every transient request got its own texture or buffer.
+    uint64_t naiveBytes = 0;
+    // Largest footprint of simultaneously live physical textures and buffers.
+    uint64_t peakBytes = 0;
+    // Every physical resource owned by the pool, including ones idle in free buckets.
+    uint64_t allocatedBytes = 0;
+    uint32_t requestCount = 0;
+    uint32_t physicalTextureCount = 0;
+    uint32_t physicalBufferCount = 0;
+};
+
 class TransientResourcePool {
   public:
     TransientResourcePool(Device* device);
     using Handle = uint32_t;
+
+    // Starts a new allocation sweep; stats returned by GetMemoryStats() cover the sweep only.
+    void BeginAllocationScope();
+    // Announces a request ahead of the sweep so the first texture created for its bucket carries
+    // the union of usages of every request that may alias onto it.
+    void Reserve(const TextureDescriptor& desc);
     TransientResourcePool::Handle Attache(const TextureDescriptor& desc);
     void Release(const TextureDescriptor& desc, TransientResourcePool::Handle handle);
+    TransientMemoryStats GetMemoryStats() const;
+    // Physical textures created over the pool's lifetime, including Resize reallocations.
+    uint64_t GetCreatedTextureCount() const { return m_createdTextureCount; }
+
+    // Re-resolves RelativeSize textures against the new surface size and recreates them in place,
+    // so handles held by compiled graphs stay valid. Fixed Extent3D textures are left untouched.
+    // Returns the number of textures that were reallocated.
+    uint32_t Resize(uint32_t width, uint32_t height);
+    // Surface size RelativeSize textures are currently resolved against.
+    uint32_t GetWidth() const { return m_config.width; }
+    uint32_t GetHeight() const { return m_config.height; }
+
+    // Buffers have their own handles. Buffers of the same size alias whenever their lifetimes do
+    // not overlap, the way textures with the same key do.
+    void ReserveBuffer(const BufferDescriptor& desc);
+    TransientResourcePool::Handle AttacheBuffer(const BufferDescriptor& desc);
+    void ReleaseBuffer(TransientResourcePool::Handle handle);
+    wgpu::Buffer GetBuffer(TransientResourcePool::Handle handle) const {
+        return m_buffers[handle].buffer;
+    }
+    // Handle of the buffer imported under id, the same for every graph compiled against the
+    // pool. It is null until InjectExternalBuffer supplies it.
+    TransientResourcePool::Handle GetExternalBufferHandle(PropertyId id);
+    // Buffers owned by someone else may be replaced between frames, e.g. when they grow.
+    void InjectExternalBuffer(PropertyId id, wgpu::Buffer externalBuffer);
 
     static constexpr Handle kSurfaceTextureIndex = 0;
 
     wgpu::Texture Get(uint32_t);
+    // Returns a cached view of the texture behind handle. Views live as long as the backing
+    // texture, so the same (handle, descriptor) pair never creates a second view.
+    wgpu::TextureView GetView(uint32_t handle, const wgpu::TextureViewDescriptor* desc = nullptr);
     void InjectExternalResource(uint32_t handle, wgpu::Texture externalTexture);
 
   private:
+    struct CachedView {
+        std::optional<wgpu::TextureViewDescriptor> desc;
+        wgpu::TextureView view;
+    };
+
+    struct PhysicalTexture {
+        wgpu::Texture texture;
+        std::vector<CachedView> views;
+        TransientTextureKey key;
+        wgpu::TextureUsage usage = wgpu::TextureUsage::None;
+        uint64_t byteSize = 0;
+        bool active = false;
+    };
+
+    struct PhysicalBuffer {
+        wgpu::Buffer buffer;
+        uint64_t size = 0;
+        wgpu::BufferUsage usage = wgpu::BufferUsage::None;
+        bool active = false;
+        // Imported buffers are never aliased and don't count towards the memory stats.
+        bool external = false;
+    };
+
+    TransientTextureKey ResolveKey(const TextureDescriptor& desc) const;
+    wgpu::Extent3D ResolveRelativeSize(const RelativeSize& relativeSize) const;
+    wgpu::Texture CreatePhysicalTexture(const TransientTextureKey& key, wgpu::TextureUsage usage);
+
     Device* m_device;
     wgpu::SurfaceConfiguration m_config;
-    std::vector<wgpu::Texture> m_textures;
-    std::multimap<TextureDescriptor, uint32_t> m_activeResources;
-    std::multimap<TextureDescriptor, uint32_t> m_freeResources;
+    std::vector<PhysicalTexture> m_textures;
+    std::unordered_map<TransientTextureKey, std::vector<Handle>, TransientTextureKeyHash>
+        m_freeBuckets;
+    std::unordered_map<TransientTextureKey, wgpu::TextureUsage, TransientTextureKeyHash>
+        m_bucketUsages;
+    std::vector<PhysicalBuffer> m_buffers;
+    // Keyed by buffer size.
+    std::unordered_map<uint64_t, std::vector<Handle>> m_freeBufferBuckets;
+    std::unordered_map<uint64_t, wgpu::BufferUsage> m_bufferBucketUsages;
+    std::unordered_map<PropertyId, Handle> m_externalBuffers;
+
+    uint64_t m_liveBytes = 0;
+    TransientMemoryStats m_stats;
+    uint64_t m_createdTextureCount = 0;
 };
 
 struct VirtualColorAttach {
@@ -79,14 +204,26 @@ struct VirtualReadInfo {
     std::optional<wgpu::TextureViewDescriptor> viewDesc;
 };
 
+struct VirtualStorageInfo {
+    uint32_t virResourceIndex;
+    core::PropertyId bindingResourcePropertyId;
+    StorageAccess access;
+};
+
 struct VirtualPassNode {
     std::vector<VirtualColorAttach> color;
     std::optional<VirtualDepthDtencilAttach> depthStencil;
 
     std::vector<VirtualReadInfo> readInfos;
+    // Storage textures and buffers, in registration order.
+    std::vector<VirtualStorageInfo> storageInfos;
 
+    // Producers of the texture versions this pass consumes. Only these keep a pass alive.
     std::vector<uint32_t> successorNodes;
     std::vector<uint32_t> predecessorNodes;
+    // Passes that must run earlier but whose output this pass does not consume: the previous
+    // writer of a texture it overwrites, and readers of the version it replaces.
+    std::vector<uint32_t> orderPredecessorNodes;
 
     PassTargetState targetState;
 };
@@ -103,7 +240,9 @@ class ResourceResolver {
                      const std::unordered_map<PropertyId, uint32_t>& blackBourd,
                      std::span<const SubResource> subResource,
                      TransientResourcePool* resourcePool);
+    // Sampled reads get the view they registered, storage textures the default view.
     wgpu::TextureView GetTextureView(PropertyId id) const;
+    wgpu::Buffer GetBuffer(PropertyId id) const;
 };
 
 struct RenderGraphProvider {
@@ -113,6 +252,17 @@ struct RenderGraphProvider {
 
 static_assert(BindGroupResourceProvider<RenderGraphProvider>);
 
+// What Compile dropped. Passes are culled when nothing they write reaches SceneColor or an
+// exported resource, or when they read a texture or buffer no live pass produces. A compute pass
+// is only kept alive by passes that consume its storage outputs, or by exporting them.
+struct GraphCompileReport {
+    std::vector<uint32_t> culledPasses;
+    // Declared textures and buffers no live pass touches. They are never allocated.
+    std::vector<std::string> culledResources;
+    // Resources read by some pass but never written (or never declared) in this graph.
+    std::vector<std::string> missingResources;
+};
+
 struct CompiledGraph {
     std::vector<uint32_t> executionOrder;
     std::array<RenderNode, PassManager::kMaxPasses> renderNodes{};
@@ -120,6 +270,15 @@ struct CompiledGraph {
 
     std::vector<SubResource> subResources;
     std::unordered_map<PropertyId, uint32_t> subResourceMap;
+    // Kept so pass bind groups can be re-resolved without recompiling, e.g. after a resize.
+    std::array<VirtualPassNode, PassManager::kMaxPasses> passNodes{};
+
+    // Indices into subResources of textures and buffers exported with
+    // PassSetupContext::ExportTexture and ExportBuffer.
+    std::vector<uint32_t> exportedResources;
+
+    TransientMemoryStats memoryStats;
+    GraphCompileReport report;
 };
 
 class RenderGraph {
@@ -129,12 +288,106 @@ class RenderGraph {
     RenderGraph(RenderGraph&& rhs) noexcept = default;
     RenderGraph& operator=(RenderGraph&& rhs) noexcept = default;
 
-    CompiledGraph Compile(std::span<uint32_t> passes,
-                          PassManager* passManager,
-                          ShaderManager* shaderManager,
-                          TransientResourcePool& vra);
+    // Compiled graphs are cached by the pass list and the setup each pass declared, so switching
+    // back to a recently used pass list is a lookup. At most kMaxCompiledGraphs are kept; the least
+    // recently compiled one is dropped first, which invalidates references to it. On a miss only
+    // passes that were never set up run IRenderPass::Setup, and pass bind groups whose resolved
+    // inputs did not change are reused. Passes that contribute to neither SceneColor nor an
+    // exported resource are culled, together with the textures only they use; see
+    // CompiledGraph::report.
+    static constexpr size_t kMaxCompiledGraphs = 8;
+    const CompiledGraph& Compile(std::span<uint32_t> passes,
+                                 PassManager* passManager,
+                                 ShaderManager* shaderManager,
+                                 TransientResourcePool& vra);
+
+    // True when Compile would return a cached graph for the pass list without running any Setup.
+    bool IsCompiled(std::span<const uint32_t> passes) const;
+
+    // Forces IRenderPass::Setup to run again for the pass on the next Compile. Graphs compiled
+    // from the old setup can no longer be hit, but stay cached, and references to them valid,
+    // until they are evicted like any other.
+    void InvalidatePass(uint32_t passId);
+    void InvalidateAll();
+
+    // Rebinds the pass bind groups of every cached graph after transient textures were
+    // reallocated. Nodes whose inputs did not change keep their bind group, and bind groups that
+    // still reference released textures are dropped.
+    void RefreshBindGroups(ShaderManager* shaderManager, TransientResourcePool& vra);
 
   private:
+    struct CachedSetup {
+        PassSetupContext context;
+        // Unique per Setup call, so it identifies the context without comparing it.
+        uint64_t generation = 0;
+    };
+
+    // The exact inputs of a compiled graph. Hashing only picks the bucket; lookups compare keys.
+    struct GraphKey {
+        std::vector<uint32_t> passes;
+        std::vector<uint64_t> setupGenerations;
+        bool operator==(const GraphKey& other) const = default;
+    };
+    struct GraphKeyHash {
+        size_t operator()(const GraphKey& key) const;
+    };
+    struct CachedGraph {
+        CompiledGraph graph;
+        uint64_t lastUsed = 0;
+    };
+
+    // Everything a pass bind group is created from.
+    struct PassBindGroupKey {
+        struct Read {
+            PropertyId propertyId;
+            WGPUTexture texture;
+            std::optional<wgpu::TextureViewDescriptor> viewDesc;
+            bool operator==(const Read& other) const;
+        };
+        // Storage textures bind their default view and storage buffers the whole buffer, so the
+        // handle, offset and size identify the binding.
+        struct Storage {
+            PropertyId propertyId;
+            WGPUTexture texture = nullptr;
+            WGPUBuffer buffer = nullptr;
+            uint64_t offset = 0;
+            uint64_t size = 0;
+            bool operator==(const Storage& other) const = default;
+        };
+        uint32_t passId = 0;
+        WGPUBindGroupLayout layout = nullptr;
+        std::vector<Read> reads;
+        std::vector<Storage> storages;
+        bool operator==(const PassBindGroupKey& other) const = default;
+    };
+    struct PassBindGroupKeyHash {
+        size_t operator()(const PassBindGroupKey& key) const;
+    };
+    using BindGroupCache =
+        std::unordered_map<PassBindGroupKey, wgpu::BindGroup, PassBindGroupKeyHash>;
+
+    const CachedSetup& GetOrSetupPass(uint32_t passId, PassManager* passManager);
+    wgpu::BindGroup GetOrCreatePassBindGroup(
+        uint32_t passId,
+        const VirtualPassNode& passNode,
+        const std::unordered_map<PropertyId, uint32_t>& subResourceMap,
+        std::span<const SubResource> subResources,
+        ShaderManager* shaderManager,
+        TransientResourcePool& vra,
+        BindGroupCache* outUsed = nullptr);
+    CompiledGraph Build(std::span<uint32_t> passes,
+                        PassManager* passManager,
+                        ShaderManager* shaderManager,
+                        TransientResourcePool& vra);
+    // Drops the least recently used graphs beyond kMaxCompiledGraphs, and the bind groups only
+    // they referenced.
+    void EvictCompiledGraphs();
+
     Device* m_device;
+    std::array<std::optional<CachedSetup>, PassManager::kMaxPasses> m_setupCache;
+    uint64_t m_nextSetupGeneration = 0;
+    std::unordered_map<GraphKey, CachedGraph, GraphKeyHash> m_compiledCache;
+    uint64_t m_compileCounter = 0;
+    BindGroupCache m_bindGroupCache;
 };
 }  // namespace core::render
@@ -1,29 +1,15 @@
 #include "DeferredGBufferPass.h"
+#include "DrawIntents.h"
 
 void core::render::pass::DeferredGBufferPass::Execute(wgpu::RenderPassEncoder encoder,
                                                       const PassExecuteContext& executeContext) {
-    wgpu::RenderPipeline pipeline = nullptr;
-    wgpu::BindGroup materialBindGroup;
-    for (uint32_t i = 0; i < executeContext.intents.size(); ++i) {
-        const RenderIntent& intent = executeContext.intents[i];
-
-        if (pipeline.Get() != intent.pipeline.Get()) {
-            pipeline = intent.pipeline;
-            encoder.SetPipeline(pipeline);
-        }
-        for (uint32_t j = 0; j < intent.bufferRange.size(); ++j) {
-            const auto bufferRange = intent.bufferRange[j];
-            encoder.SetVertexBuffer(j, intent.vertexBuffer, bufferRange.offset, bufferRange.size);
-        }
-        encoder.SetIndexBuffer(intent.indexBuffer, wgpu::IndexFormat::Uint32);
-
-        if (materialBindGroup.Get() != intent.bindGroup.Get()) {
-            materialBindGroup = intent.bindGroup;
-            encoder.SetBindGroup(BindSlot::Material, materialBindGroup);
-        }
+    DrawIntents(encoder, executeContext.intents, executeContext.indirectBuffer);
+}
 
-        encoder.DrawIndexed(intent.subMeshInfo.indexCount, 1, intent.subMeshInfo.indexStart);
-    }
+void core::render::pass::DeferredGBufferPass::ExecuteBundle(
+    wgpu::RenderBundleEncoder encoder,
+    const PassExecuteContext& executeContext) {
+    DrawIntents(encoder, executeContext.intents, executeContext.indirectBuffer);
 }
 
 void core::render::pass::DeferredGBufferPass::Setup(core::render::PassSetupContext& context) {
@@ -67,3 +53,9 @@ void core::render::pass::DeferredGBufferPass::Setup(core::render::PassSetupConte
     context.RegisterPassOutputs({{albedoHandle}, {materialHandle}, {normalHandle}},
                                 DepthStencilAttachment{depthStencilHandle});
 }
+
+void core::render::pass::DeferredGBufferPass::CountCommands(
+    CountingEncoder& encoder,
+    const PassExecuteContext& executeContext) const {
+    DrawIntents(encoder, executeContext.intents, executeContext.indirectBuffer);
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include <webgpu/webgpu_cpp.h>
+#include "../backend/RenderBundleCache.h"
 #include "../graph/IRenderPass.h"
 
 namespace core::render::pass {
@@ -9,6 +10,16 @@ class DeferredGBufferPass : public core::render::IRenderPass {
     void Execute(wgpu::RenderPassEncoder encoder,
                  const PassExecuteContext& executeContext) override;
 
+    bool SupportsBundleRecording() const override { return true; }
+    void ExecuteBundle(wgpu::RenderBundleEncoder encoder,
+                       const PassExecuteContext& executeContext) override;
+    RenderBundleCache* GetBundleCache() override { return &m_bundleCache; }
+    void CountCommands(CountingEncoder& encoder,
+                       const PassExecuteContext& executeContext) const override;
+
     void Setup(PassSetupContext& context) override;
+
+  private:
+    RenderBundleCache m_bundleCache;
 };
 }  // namespace core::render::pass
@@ -1,4 +1,5 @@
 #include "DeferredLightingPass.h"
+#include "../backend/CountingEncoder.h"
 
 void core::render::pass::DeferredLightingPass::Execute(wgpu::RenderPassEncoder encoder,
                                                        const PassExecuteContext& executeContext) {
@@ -21,3 +22,10 @@ void core::render::pass::DeferredLightingPass::Setup(core::render::PassSetupCont
 
     context.RegisterPassOutputs({{PassSetupContext::kSceneColorHandle}});
 }
+
+void core::render::pass::DeferredLightingPass::CountCommands(
+    CountingEncoder& encoder,
+    const PassExecuteContext& executeContext) const {
+    encoder.SetPipeline(executeContext.proceduralPipeline);
+    encoder.Draw(3, 1, 0, 0);
+}
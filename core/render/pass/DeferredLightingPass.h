@@ -11,5 +11,7 @@ class DeferredLightingPass : public core::render::IRenderPass {
                  const PassExecuteContext& executeContext) override;
 
     void Setup(PassSetupContext& context) override;
+    void CountCommands(CountingEncoder& encoder,
+                       const PassExecuteContext& executeContext) const override;
 };
 }  // namespace core::render::pass
@@ -0,0 +1,46 @@
+#pragma once
+#include <webgpu/webgpu_cpp.h>
+#include <span>
+#include "../backend/CountingEncoder.h"
+#include "../backend/GpuCuller.h"
+#include "../graph/IRenderPass.h"
+
+namespace core::render::pass {
+
+// Shared draw loop for passes that render sorted mesh intents. Works with both
+// wgpu::RenderPassEncoder and wgpu::RenderBundleEncoder, which expose the same draw API, and with
+// CountingEncoder. With an indirect buffer the instance counts come from GpuCuller instead.
+template <typename Encoder>
+void DrawIntents(Encoder& encoder,
+                 std::span<const RenderIntent> intents,
+                 const wgpu::Buffer& indirectBuffer = nullptr) {
+    wgpu::RenderPipeline pipeline = nullptr;
+    wgpu::BindGroup materialBindGroup = nullptr;
+    for (uint32_t i = 0; i < intents.size(); ++i) {
+        const RenderIntent& intent = intents[i];
+
+        if (pipeline.Get() != intent.pipeline.Get()) {
+            pipeline = intent.pipeline;
+            encoder.SetPipeline(pipeline);
+        }
+        for (uint32_t j = 0; j < intent.bufferRange.size(); ++j) {
+            const auto bufferRange = intent.bufferRange[j];
+            encoder.SetVertexBuffer(j, intent.vertexBuffer, bufferRange.offset, bufferRange.size);
+        }
+        encoder.SetIndexBuffer(intent.indexBuffer, wgpu::IndexFormat::Uint32);
+
+        if (materialBindGroup.Get() != intent.bindGroup.Get()) {
+            materialBindGroup = intent.bindGroup;
+            encoder.SetBindGroup(BindSlot::Material, materialBindGroup);
+        }
+
+        if (indirectBuffer != nullptr) {
+            encoder.DrawIndexedIndirect(indirectBuffer,
+                                        intent.indirectIndex * sizeof(DrawIndexedIndirectArgs));
+        } else {
+            encoder.DrawIndexed(intent.subMeshInfo.indexCount, intent.instanceCount,
+                                intent.subMeshInfo.indexStart, 0, intent.firstInstance);
+        }
+    }
+}
+}  // namespace core::render::pass
@@ -1,4 +1,5 @@
 #include "ForwardRenderPass.h"
+#include "DrawIntents.h"
 
 void core::render::pass::ForwardRenderPass::Setup(core::render::PassSetupContext& context) {
     Handle depthStencilHandle = context.DeclareTexture(
@@ -15,25 +16,17 @@ void core::render::pass::ForwardRenderPass::Setup(core::render::PassSetupContext
 
 void core::render::pass::ForwardRenderPass::Execute(wgpu::RenderPassEncoder encoder,
                                                     const PassExecuteContext& executeContext) {
-    wgpu::RenderPipeline pipeline = nullptr;
-    wgpu::BindGroup materialBindGroup = nullptr;
-    for (uint32_t i = 0; i < executeContext.intents.size(); ++i) {
-        const auto& intent = executeContext.intents[i];
+    DrawIntents(encoder, executeContext.intents, executeContext.indirectBuffer);
+}
 
-        if (pipeline.Get() != intent.pipeline.Get()) {
-            pipeline = intent.pipeline;
-            encoder.SetPipeline(pipeline);
-        }
-        for (uint32_t j = 0; j < intent.bufferRange.size(); ++j) {
-            const auto bufferRange = intent.bufferRange[j];
-            encoder.SetVertexBuffer(j, intent.vertexBuffer, bufferRange.offset, bufferRange.size);
-        }
-        encoder.SetIndexBuffer(intent.indexBuffer, wgpu::IndexFormat::Uint32);
-        if (materialBindGroup.Get() != intent.bindGroup.Get()) {
-            materialBindGroup = intent.bindGroup;
-            encoder.SetBindGroup(BindSlot::Material, materialBindGroup);
-        }
+void core::render::pass::ForwardRenderPass::ExecuteBundle(
+    wgpu::RenderBundleEncoder encoder,
+    const PassExecuteContext& executeContext) {
+    DrawIntents(encoder, executeContext.intents, executeContext.indirectBuffer);
+}
 
-        encoder.DrawIndexed(intent.subMeshInfo.indexCount, 1, intent.subMeshInfo.indexStart);
-    }
+void core::render::pass::ForwardRenderPass::CountCommands(
+    CountingEncoder& encoder,
+    const PassExecuteContext& executeContext) const {
+    DrawIntents(encoder, executeContext.intents, executeContext.indirectBuffer);
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include <webgpu/webgpu_cpp.h>
+#include "../backend/RenderBundleCache.h"
 #include "../graph/IRenderPass.h"
 
 namespace core::render::pass {
@@ -11,5 +12,15 @@ class ForwardRenderPass : public core::render::IRenderPass {
 
     void Execute(wgpu::RenderPassEncoder encoder,
                  const PassExecuteContext& executeContext) override;
+
+    bool SupportsBundleRecording() const override { return true; }
+    void ExecuteBundle(wgpu::RenderBundleEncoder encoder,
+                       const PassExecuteContext& executeContext) override;
+    RenderBundleCache* GetBundleCache() override { return &m_bundleCache; }
+    void CountCommands(CountingEncoder& encoder,
+                       const PassExecuteContext& executeContext) const override;
+
+  private:
+    RenderBundleCache m_bundleCache;
 };
 }  // namespace core::render::pass
@@ -0,0 +1,21 @@
+#include "GpuCullingPass.h"
+#include "../graph/RenderGraph.h"
+
+void core::render::pass::GpuCullingPass::Setup(core::render::PassSetupContext& context) {
+    Handle transforms = context.ImportBuffer(kTransformsName);
+    Handle visibleInstances = context.ImportBuffer(kVisibleInstancesName);
+
+    context.RegisterStorageBuffer(transforms, StorageAccess::Read);
+    context.RegisterStorageBuffer(visibleInstances, StorageAccess::Write);
+    context.ExportBuffer(visibleInstances);
+}
+
+void core::render::pass::GpuCullingPass::ExecuteCompute(
+    wgpu::ComputePassEncoder encoder,
+    const ComputeExecuteContext& executeContext) {
+    if (m_culler == nullptr) {
+        return;
+    }
+    m_culler->Dispatch(encoder, executeContext.resources.GetBuffer(ToPropertyID(kTransformsName)),
+                       executeContext.resources.GetBuffer(ToPropertyID(kVisibleInstancesName)));
+}
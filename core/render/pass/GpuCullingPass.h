@@ -0,0 +1,27 @@
+#pragma once
+#include <webgpu/webgpu_cpp.h>
+#include "../backend/GpuCuller.h"
+#include "../graph/IRenderPass.h"
+
+namespace core::render::pass {
+// Runs GpuCuller's dispatch as a graph node. The transform and visible instance buffers belong
+// to InstanceBuffer and are imported; the visible instance list is exported, since the draws
+// that consume it read it through the instance bind group rather than the graph. SceneRenderer
+// lists the pass first whenever GPU culling is enabled.
+class GpuCullingPass : public core::render::IComputePass {
+  public:
+    static constexpr const char* kTransformsName = "InstanceTransforms";
+    static constexpr const char* kVisibleInstancesName = "VisibleInstances";
+
+    GpuCullingPass() = default;
+
+    void SetCuller(GpuCuller* culler) { m_culler = culler; }
+
+    void Setup(PassSetupContext& context) override;
+    void ExecuteCompute(wgpu::ComputePassEncoder encoder,
+                        const ComputeExecuteContext& executeContext) override;
+
+  private:
+    GpuCuller* m_culler = nullptr;
+};
+}  // namespace core::render::pass
@@ -3,13 +3,24 @@
 #include "render.h"
 #include <dawn/webgpu_cpp.h>
 #include <magic_enum/magic_enum.hpp>
+#include <optional>
 #include <print>
+#include <vector>
 #include "util.h"
+#include "util/CpuProfiler.h"
 
 namespace core {
 namespace render {
 
-std::unique_ptr<Device> core::render::Device::Create(Window& window) {
+namespace {
+struct DeviceContext {
+    wgpu::Instance instance;
+    wgpu::Adapter adapter;
+    wgpu::Device device;
+};
+
+// Returns nullopt when no adapter or device could be created; the reason is printed.
+std::optional<DeviceContext> RequestAdapterAndDevice(bool forceFallbackAdapter) {
     const auto features = wgpu::InstanceFeatureName::TimedWaitAny;
     wgpu::InstanceDescriptor descriptor = {.requiredFeatureCount = 1,
                                            .requiredFeatures = &features};
@@ -18,21 +29,36 @@ std::unique_ptr<Device> core::render::Device::Create(Window& window) {
     wgpu::Adapter adapter;
     const wgpu::RequestAdapterOptions option{
         .powerPreference = wgpu::PowerPreference::Undefined,
-        .forceFallbackAdapter = false,
+        .forceFallbackAdapter = forceFallbackAdapter,
     };
     wgpu::Future f1 = instance.RequestAdapter(
         &option, wgpu::CallbackMode::WaitAnyOnly,
         [&](wgpu::RequestAdapterStatus status, wgpu::Adapter a, wgpu::StringView message) {
             if (status != wgpu::RequestAdapterStatus::Success) {
                 std::println("RequestAdapter: {}", message.data);
-                exit(0);
+                return;
             }
             adapter = std::move(a);
         });
     instance.WaitAny(f1, UINT64_MAX);
+    if (adapter == nullptr) {
+        return std::nullopt;
+    }
 
+    // ImplicitDeviceSynchronization lets worker threads record render bundles against the same
+    // device; TimestampQuery backs the GPU profiler; IndirectFirstInstance lets GPU culling draw
+    // batches that start past instance 0. All are optional.
+    std::vector<wgpu::FeatureName> requiredFeatures;
+    for (wgpu::FeatureName feature : {wgpu::FeatureName::ImplicitDeviceSynchronization,
+                                      wgpu::FeatureName::TimestampQuery,
+                                      wgpu::FeatureName::IndirectFirstInstance}) {
+        if (adapter.HasFeature(feature)) {
+            requiredFeatures.push_back(feature);
+        }
+    }
     wgpu::DeviceDescriptor deviceDescriptor{
-
+        .requiredFeatureCount = requiredFeatures.size(),
+        .requiredFeatures = requiredFeatures.data(),
     };
 
     wgpu::Device device;
@@ -45,11 +71,29 @@ std::unique_ptr<Device> core::render::Device::Create(Window& window) {
         [&](wgpu::RequestDeviceStatus status, wgpu::Device d, wgpu::StringView message) {
             if (status != wgpu::RequestDeviceStatus::Success) {
                 std::println("RequestDevice: {}", message.data);
-                exit(0);
+                return;
             }
             device = std::move(d);
         });
     instance.WaitAny(f2, UINT64_MAX);
+    if (device == nullptr) {
+        return std::nullopt;
+    }
+
+    return DeviceContext{
+        .instance = std::move(instance),
+        .adapter = std::move(adapter),
+        .device = std::move(device),
+    };
+}
+}  // namespace
+
+std::unique_ptr<Device> core::render::Device::Create(Window& window) {
+    auto context = RequestAdapterAndDevice(false);
+    if (!context.has_value()) {
+        return nullptr;
+    }
+    auto& [instance, adapter, device] = *context;
 
     wgpu::Surface surface = core::util::CreateSurfaceForWGPU(instance, window);
     wgpu::SurfaceCapabilities capabilities;
@@ -67,6 +111,38 @@ std::unique_ptr<Device> core::render::Device::Create(Window& window) {
     return std::unique_ptr<Device>(new Device(instance, adapter, device, surface, config));
 }
 
+std::unique_ptr<Device> core::render::Device::CreateHeadless(const HeadlessSpec& spec) {
+    auto context = RequestAdapterAndDevice(spec.forceFallbackAdapter);
+    if (!context.has_value()) {
+        return nullptr;
+    }
+    auto& [instance, adapter, device] = *context;
+
+    // Mirror a surface configuration so everything that sizes itself from the surface
+    // (RelativeSize targets, depth buffers, projection) keeps working unchanged.
+    wgpu::SurfaceConfiguration config{
+        .device = device,
+        .format = spec.format,
+        .usage = wgpu::TextureUsage::RenderAttachment,
+        .width = spec.width,
+        .height = spec.height,
+        .presentMode = wgpu::PresentMode::Fifo,
+    };
+
+    const wgpu::TextureDescriptor offscreenDesc{
+        .label = "OffscreenColor",
+        .usage = wgpu::TextureUsage::RenderAttachment | wgpu::TextureUsage::TextureBinding |
+                 wgpu::TextureUsage::CopySrc,
+        .dimension = wgpu::TextureDimension::e2D,
+        .size = {spec.width, spec.height, 1},
+        .format = spec.format,
+    };
+    wgpu::Texture offscreenTexture = device.CreateTexture(&offscreenDesc);
+
+    return std::unique_ptr<Device>(
+        new Device(instance, adapter, device, nullptr, config, offscreenTexture));
+}
+
 wgpu::ShaderModule Device::CreateShaderModuleFromWGSL(const std::string_view wgslCode) {
     wgpu::ShaderSourceWGSL wgslSource{{.code = wgpu::StringView(wgslCode)}};
     wgpu::ShaderModuleDescriptor descriptor{
@@ -99,6 +175,7 @@ wgpu::Buffer core::render::Device::CreateBufferFromData(const void* data,
     };
     wgpu::Buffer buffer = m_device.CreateBuffer(&bufferDesc);
     m_device.GetQueue().WriteBuffer(buffer, 0, data, size);
+    m_writeBufferBytes += size;
 
     return buffer;
 }
@@ -128,8 +205,24 @@ wgpu::RenderPipeline Device::CreateRenderPipeline(
     return pipeline;
 }
 
-void Device::WriteBuffer(const GpuBuffer& buffer, uint64_t offset, void* data, uint64_t size) {
-    m_device.GetQueue().WriteBuffer(buffer.GetHandle(), offset, data, size);
+wgpu::ComputePipeline Device::CreateComputePipeline(
+    const wgpu::ComputePipelineDescriptor& descriptor) {
+    return m_device.CreateComputePipeline(&descriptor);
+}
+
+void Device::WriteBuffer(const GpuBuffer& buffer,
+                         uint64_t offset,
+                         const void* data,
+                         uint64_t size) {
+    WriteBuffer(buffer.GetHandle(), offset, data, size);
+}
+
+void Device::WriteBuffer(const wgpu::Buffer& buffer,
+                         uint64_t offset,
+                         const void* data,
+                         uint64_t size) {
+    m_device.GetQueue().WriteBuffer(buffer, offset, data, size);
+    m_writeBufferBytes += size;
 }
 
 wgpu::Texture Device::CreateTexture(const wgpu::TextureDescriptor& descriptor) {
@@ -141,17 +234,22 @@ wgpu::Texture Device::CreateTextureFromData(const wgpu::TextureDescriptor& descr
                                             const wgpu::TexelCopyBufferLayout& layout,
                                             std::span<const uint8_t> data) {
     wgpu::Texture texture = m_device.CreateTexture(&descriptor);
+    WriteTexture(texture, 0, layout, data, descriptor.size);
+    return texture;
+}
 
+void Device::WriteTexture(const wgpu::Texture& texture,
+                          uint32_t mipLevel,
+                          const wgpu::TexelCopyBufferLayout& layout,
+                          std::span<const uint8_t> data,
+                          const wgpu::Extent3D& size) {
     wgpu::TexelCopyTextureInfo destination{
         .texture = texture,
-        .mipLevel = 0,
+        .mipLevel = mipLevel,
         .origin = {0, 0, 0},
         .aspect = wgpu::TextureAspect::All,
     };
-
-    m_device.GetQueue().WriteTexture(&destination, data.data(), data.size_bytes(), &layout,
-                                     &descriptor.size);
-    return texture;
+    m_device.GetQueue().WriteTexture(&destination, data.data(), data.size_bytes(), &layout, &size);
 }
 
 // template GpuTexture Device::CreateTexture<uint16_t>(const wgpu::TextureDescriptor& desc,
@@ -164,16 +262,78 @@ wgpu::Texture Device::CreateTextureFromData(const wgpu::TextureDescriptor& descr
 //                                                  core::memory::StridedSpan<const float> data);
 
 void Device::Present() {
+    ENGINE_PROFILE_SCOPE("Device::Present");
+    if (IsHeadless() || !m_textureAcquired) {
+        return;
+    }
     m_surface.Present();
+    m_textureAcquired = false;
+    if (m_reconfigureAfterPresent) {
+        m_reconfigureAfterPresent = false;
+        m_surface.Configure(&m_surfaceConfig);
+    }
 }
+
+void Device::Resize(uint32_t width, uint32_t height) {
+    m_surfaceConfig.width = width;
+    m_surfaceConfig.height = height;
+
+    if (IsHeadless()) {
+        const wgpu::TextureDescriptor offscreenDesc{
+            .label = "OffscreenColor",
+            .usage = m_offscreenTexture.GetUsage(),
+            .dimension = wgpu::TextureDimension::e2D,
+            .size = {width, height, 1},
+            .format = m_surfaceConfig.format,
+        };
+        m_offscreenTexture = m_device.CreateTexture(&offscreenDesc);
+        return;
+    }
+    m_textureAcquired = false;
+    m_reconfigureAfterPresent = false;
+    m_surface.Configure(&m_surfaceConfig);
+}
+
+void Device::WaitIdle() {
+    wgpu::Future future = m_device.GetQueue().OnSubmittedWorkDone(
+        wgpu::CallbackMode::WaitAnyOnly,
+        [](wgpu::QueueWorkDoneStatus status, wgpu::StringView message) {
+            if (status != wgpu::QueueWorkDoneStatus::Success) {
+                std::println("OnSubmittedWorkDone: {}", message.data);
+            }
+        });
+    m_instance.WaitAny(future, UINT64_MAX);
+}
+
 wgpu::Texture Device::GetCurrentTexture() {
+    if (IsHeadless()) {
+        return m_offscreenTexture;
+    }
     wgpu::SurfaceTexture surfaceTexture;
     m_surface.GetCurrentTexture(&surfaceTexture);
-    return surfaceTexture.texture;
+    switch (surfaceTexture.status) {
+        case wgpu::SurfaceGetCurrentTextureStatus::SuccessOptimal:
+            m_textureAcquired = true;
+            return surfaceTexture.texture;
+        case wgpu::SurfaceGetCurrentTextureStatus::SuccessSuboptimal:
+            m_textureAcquired = true;
+            m_reconfigureAfterPresent = true;
+            return surfaceTexture.texture;
+        case wgpu::SurfaceGetCurrentTextureStatus::Outdated:
+        case wgpu::SurfaceGetCurrentTextureStatus::Lost:
+            m_surface.Configure(&m_surfaceConfig);
+            return nullptr;
+        case wgpu::SurfaceGetCurrentTextureStatus::Timeout:
+            return nullptr;
+        default:
+            std::println("GetCurrentTexture: {}", magic_enum::enum_name(surfaceTexture.status));
+            return nullptr;
+    }
 }
 
 wgpu::TextureView Device::GetCurrentTextureView() {
-    return GetCurrentTexture().CreateView();
+    wgpu::Texture texture = GetCurrentTexture();
+    return texture != nullptr ? texture.CreateView() : nullptr;
 }
 
 }  // namespace render
@@ -23,6 +23,15 @@ struct CameraUniformData {
     glm::vec4 position;
 };
 
+struct HeadlessSpec {
+    uint32_t width = 1280;
+    uint32_t height = 720;
+    wgpu::TextureFormat format = wgpu::TextureFormat::RGBA8Unorm;
+    // Dawn's fallback adapter is a CPU implementation (SwiftShader) and works without a GPU or
+    // display, which is what CI and render-farm nodes have.
+    bool forceFallbackAdapter = true;
+};
+
 template <typename T>
 concept TextureDataFormat = std::same_as<T, uint8_t> || std::same_as<T, uint16_t> ||
                             std::same_as<T, uint32_t> || std::same_as<T, float>;
@@ -30,15 +39,38 @@ concept TextureDataFormat = std::same_as<T, uint8_t> || std::same_as<T, uint16_t
 class Device {
   public:
     Device() = delete;
+    // Both factories return nullptr when no adapter or device is available.
     static std::unique_ptr<Device> Create(Window& window);
+    // Creates a device without a window or surface. Frames are rendered into an owned offscreen
+    // color target which stands in for the surface texture.
+    static std::unique_ptr<Device> CreateHeadless(const HeadlessSpec& spec);
     ~Device() = default;
 
+    // No-op when GetCurrentTexture did not hand out a texture this frame.
     void Present();
+    // Reconfigures the surface, or recreates the offscreen target in headless mode.
+    void Resize(uint32_t width, uint32_t height);
+    // Blocks until all work submitted to the queue so far has finished on the GPU.
+    void WaitIdle();
+    // Fires ready AllowProcessEvents callbacks, such as buffer map completions. Never blocks.
+    void ProcessEvents() { m_instance.ProcessEvents(); }
+
+    bool IsHeadless() const { return m_surface == nullptr; }
+    // True when the device may be used from several threads at once.
+    bool SupportsMultithreading() const {
+        return m_device.HasFeature(wgpu::FeatureName::ImplicitDeviceSynchronization);
+    }
+    // True when indirect draws may use a non-zero firstInstance; without it WebGPU requires 0.
+    bool SupportsIndirectFirstInstance() const {
+        return m_device.HasFeature(wgpu::FeatureName::IndirectFirstInstance);
+    }
 
     const wgpu::Device& GetDevice() { return m_device; }
     const wgpu::SurfaceConfiguration& GetSurfaceConfig() { return m_surfaceConfig; }
 
     wgpu::TextureView GetCurrentTextureView();
+    // Returns nullptr when no texture could be acquired this frame; the frame should be skipped.
+    // An outdated or lost surface is reconfigured so the next frame can acquire again.
     wgpu::Texture GetCurrentTexture();
 
     wgpu::ShaderModule CreateShaderModuleFromWGSL(const std::string_view wgslCode);
@@ -52,31 +84,48 @@ class Device {
 
     GpuPipelineLayout CreatePipelineLayout(const wgpu::PipelineLayoutDescriptor& descriptor);
     wgpu::RenderPipeline CreateRenderPipeline(const wgpu::RenderPipelineDescriptor& descriptor);
+    wgpu::ComputePipeline CreateComputePipeline(const wgpu::ComputePipelineDescriptor& descriptor);
 
     wgpu::Texture CreateTexture(const wgpu::TextureDescriptor& descriptor);
     wgpu::Texture CreateTextureFromData(const wgpu::TextureDescriptor& descriptor,
                                         const wgpu::TexelCopyBufferLayout& layout,
                                         std::span<const uint8_t> data);
+    void WriteTexture(const wgpu::Texture& texture,
+                      uint32_t mipLevel,
+                      const wgpu::TexelCopyBufferLayout& layout,
+                      std::span<const uint8_t> data,
+                      const wgpu::Extent3D& size);
 
-    void WriteBuffer(const GpuBuffer& buffer, uint64_t offset, void* data, uint64_t size);
+    void WriteBuffer(const GpuBuffer& buffer, uint64_t offset, const void* data, uint64_t size);
+    void WriteBuffer(const wgpu::Buffer& buffer, uint64_t offset, const void* data, uint64_t size);
+    // Bytes uploaded through WriteBuffer and CreateBufferFromData since the device was created.
+    uint64_t GetWriteBufferBytes() const { return m_writeBufferBytes; }
 
   private:
     Device(wgpu::Instance instance,
            wgpu::Adapter adapter,
            wgpu::Device device,
            wgpu::Surface surface,
-           wgpu::SurfaceConfiguration surfaceConfig)
+           wgpu::SurfaceConfiguration surfaceConfig,
+           wgpu::Texture offscreenTexture = nullptr)
         : m_instance(instance),
           m_adapter(adapter),
           m_device(device),
           m_surface(surface),
-          m_surfaceConfig(surfaceConfig) {}
+          m_surfaceConfig(surfaceConfig),
+          m_offscreenTexture(offscreenTexture) {}
 
     wgpu::Instance m_instance;
     wgpu::Adapter m_adapter;
     wgpu::Device m_device;
     wgpu::Surface m_surface;
     wgpu::SurfaceConfiguration m_surfaceConfig;
+    // Only set in headless mode, where it replaces the surface texture.
+    wgpu::Texture m_offscreenTexture;
+    bool m_textureAcquired = false;
+    // Set when the acquired texture was suboptimal; the surface is reconfigured after Present.
+    bool m_reconfigureAfterPresent = false;
+    mutable uint64_t m_writeBufferBytes = 0;
 };
 
 bool IsSRGB(wgpu::TextureFormat format);
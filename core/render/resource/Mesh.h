@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <limits>
 
 #include <MeshAssetFormat.h>
 
@@ -24,6 +25,16 @@ struct Mesh {
         return meshAssetFormat->subMeshes[index];
     }
 
+    // (center, radius) in object space. Meshes without bounds get an infinite sphere, so they are
+    // never culled.
+    glm::vec4 GetBoundingSphere(uint32_t index) const {
+        if (index >= meshAssetFormat->subMeshBounds.size()) {
+            return glm::vec4(0.0f, 0.0f, 0.0f, std::numeric_limits<float>::infinity());
+        }
+        const MeshAssetFormat::SubMeshBounds& bounds = meshAssetFormat->subMeshBounds[index];
+        return glm::vec4(bounds.sphereCenter, bounds.sphereRadius);
+    }
+
     const MeshAssetFormat::MeshVertexState& GetVertexState(uint32_t index) const {
         return meshAssetFormat->states[index];
     }
@@ -1,6 +1,7 @@
 #include <memory>
 
 #include "MeshManager.h"
+#include "util/MappedFile.h"
 
 core::Handle core::render::MeshManager::LoadMesh(const importer::MeshResult& meshResult) {
     if (m_meshCache.find(meshResult.assetPath) != m_meshCache.end()) {
@@ -8,26 +9,52 @@ core::Handle core::render::MeshManager::LoadMesh(const importer::MeshResult& mes
     }
 
     const MeshAssetFormat& meshAssetFormat = meshResult.meshAsset;
+    return CreateMesh(meshResult.assetPath, meshAssetFormat, meshAssetFormat.vertexData,
+                      meshAssetFormat.indexData);
+}
+
+std::expected<core::Handle, core::Error> core::render::MeshManager::LoadMesh(
+    const std::filesystem::path& filepath) {
+    const AssetPath assetPath{filepath.string()};
+    if (m_meshCache.find(assetPath) != m_meshCache.end()) {
+        return m_meshCache[assetPath];
+    }
+
+    auto file = util::MappedFile::Open(filepath);
+    if (!file) {
+        return std::unexpected(file.error());
+    }
+    auto mapped = MappedMeshAsset::LoadFromMemory(file->GetBytes());
+    if (!mapped) {
+        return std::unexpected(mapped.error());
+    }
+    return CreateMesh(assetPath, std::move(mapped->format), mapped->vertexData,
+                      mapped->indexData);
+}
 
-    wgpu::Buffer vertexBuffer = m_device->CreateBufferFromData(
-        meshAssetFormat.vertexData.data(), meshAssetFormat.vertexData.size(),
-        wgpu::BufferUsage::Vertex | wgpu::BufferUsage::CopyDst);
-    wgpu::Buffer indexBuffer = m_device->CreateBufferFromData(
-        meshAssetFormat.indexData.data(), meshAssetFormat.indexData.size() * sizeof(uint32_t),
-        wgpu::BufferUsage::Index | wgpu::BufferUsage::CopyDst);
+core::Handle core::render::MeshManager::CreateMesh(const AssetPath& assetPath,
+                                                   MeshAssetFormat meshAssetFormat,
+                                                   std::span<const std::byte> vertexData,
+                                                   std::span<const uint32_t> indexData) {
+    wgpu::Buffer vertexBuffer =
+        m_device->CreateBufferFromData(vertexData.data(), vertexData.size_bytes(),
+                                       wgpu::BufferUsage::Vertex | wgpu::BufferUsage::CopyDst);
+    wgpu::Buffer indexBuffer =
+        m_device->CreateBufferFromData(indexData.data(), indexData.size_bytes(),
+                                       wgpu::BufferUsage::Index | wgpu::BufferUsage::CopyDst);
 
     std::vector<uint8_t> globalVertexStateIds;
-    for (const auto& state : meshResult.meshAsset.states) {
+    for (const auto& state : meshAssetFormat.states) {
         globalVertexStateIds.push_back(m_vertexLayoutManager->GetVertexStateID(state));
     }
 
     Mesh mesh{
         .vertexBuffer = vertexBuffer,
         .indexBuffer = indexBuffer,
-        .meshAssetFormat = std::make_unique<MeshAssetFormat>(meshResult.meshAsset),
+        .meshAssetFormat = std::make_unique<MeshAssetFormat>(std::move(meshAssetFormat)),
         .globalVertexStateIds = std::move(globalVertexStateIds),
     };
     Handle handle = m_assetManager->StoreMesh(std::move(mesh));
-    m_meshCache[meshResult.assetPath] = handle;
+    m_meshCache[assetPath] = handle;
     return handle;
 }
@@ -1,4 +1,9 @@
 #pragma once
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <span>
+
 #include "AssetManager.h"
 #include "MeshAssetFormat.h"
 #include "VertexLayoutManager.h"
@@ -20,6 +25,9 @@ class MeshManager {
           m_vertexLayoutManager(vertexLayoutManager) {}
 
     Handle LoadMesh(const importer::MeshResult& meshAssetFormat);
+    // Loads a .mesh file written by assetBaker. The file is mapped and its index and vertex data
+    // are uploaded straight from the mapping, which is closed again before returning.
+    std::expected<Handle, Error> LoadMesh(const std::filesystem::path& filepath);
     Handle GetMeshHandle(const AssetPath& assetPath) const {
         auto it = m_meshCache.find(assetPath);
         if (it != m_meshCache.end()) {
@@ -32,6 +40,11 @@ class MeshManager {
     }
 
   private:
+    Handle CreateMesh(const AssetPath& assetPath,
+                      MeshAssetFormat meshAssetFormat,
+                      std::span<const std::byte> vertexData,
+                      std::span<const uint32_t> indexData);
+
     Device* m_device = nullptr;
     AssetManager* m_assetManager = nullptr;
     VertexLayoutManager* m_vertexLayoutManager = nullptr;
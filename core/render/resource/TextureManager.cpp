@@ -1,6 +1,7 @@
 #include "TextureManager.h"
 #include "TextureAssetFormat.h"
 #include "render/util.h"
+#include "util/MappedFile.h"
 
 namespace core::render {
 TextureManager::TextureManager(Device* device, AssetManager* assetRepo)
@@ -18,7 +19,29 @@ Handle TextureManager::LoadTexture(const core::importer::TextureResult& assetRes
     }
 
     const TextureAssetFormat& assetData = assetResult.textureAsset;
+    return CreateTexture(assetResult.assetPath, assetData, assetData.pixelData);
+}
+
+std::expected<Handle, Error> TextureManager::LoadTexture(const std::filesystem::path& filepath) {
+    const AssetPath assetPath{filepath.string()};
+    if (m_textureCache.find(assetPath) != m_textureCache.end()) {
+        return m_textureCache[assetPath];
+    }
+
+    auto file = core::util::MappedFile::Open(filepath);
+    if (!file) {
+        return std::unexpected(file.error());
+    }
+    auto mapped = MappedTextureAsset::LoadFromMemory(file->GetBytes());
+    if (!mapped) {
+        return std::unexpected(mapped.error());
+    }
+    return CreateTexture(assetPath, mapped->format, mapped->pixelData);
+}
 
+Handle TextureManager::CreateTexture(const AssetPath& assetPath,
+                                     const TextureAssetFormat& assetData,
+                                     std::span<const uint8_t> pixelData) {
     wgpu::TextureDescriptor desc{
         .usage = wgpu::TextureUsage::CopyDst | wgpu::TextureUsage::TextureBinding,
         .dimension = util::ConvertTextureDimensionWgpu(assetData.dimension),
@@ -27,20 +50,28 @@ Handle TextureManager::LoadTexture(const core::importer::TextureResult& assetRes
         .mipLevelCount = assetData.mips,
     };
 
-    wgpu::Texture wgpuTexture = m_device->CreateTextureFromData(
-        desc,
-        wgpu::TexelCopyBufferLayout{
-            .bytesPerRow = assetData.channel * assetData.width,
-            .rowsPerImage = assetData.height,
-        },
-        std::span<const uint8_t>((assetData.pixelData.data()), assetData.pixelData.size()));
+    wgpu::Texture wgpuTexture = m_device->CreateTexture(desc);
+    for (uint32_t level = 0; level < assetData.mips; ++level) {
+        const TextureAssetFormat::MipLevel mip = assetData.GetMipLevel(level);
+        // Failed imports come through as empty textures.
+        if (mip.offset + mip.size > pixelData.size()) {
+            break;
+        }
+        m_device->WriteTexture(wgpuTexture, level,
+                               wgpu::TexelCopyBufferLayout{
+                                   .bytesPerRow = mip.bytesPerRow,
+                                   .rowsPerImage = mip.height,
+                               },
+                               pixelData.subspan(mip.offset, mip.size),
+                               {mip.width, mip.height, assetData.depth});
+    }
 
     render::Texture texture(wgpuTexture);
     texture.CreateDefaultView(nullptr);
     texture.SetDesc(desc.usage, desc.dimension, desc.format, desc.size, assetData.mips);
 
     Handle handle = m_assetRepo->StoreTexture(std::move(texture));
-    m_textureCache[assetResult.assetPath] = handle;
+    m_textureCache[assetPath] = handle;
     return handle;
 }
 
@@ -1,4 +1,8 @@
 #pragma once
+#include <expected>
+#include <filesystem>
+#include <span>
+
 #include "AssetManager.h"
 #include "Texture.h"
 #include "import/Importer.h"
@@ -10,6 +14,9 @@ class TextureManager {
     TextureManager(Device* device, AssetManager* assetRepo);
 
     Handle LoadTexture(const core::importer::TextureResult& assetResult);
+    // Loads a .tex file written by assetBaker, uploading every mip level straight from a mapping
+    // of the file.
+    std::expected<Handle, Error> LoadTexture(const std::filesystem::path& filepath);
 
     AssetView<Texture> GetTexture(Handle textureHandle) {
         return m_assetRepo->GetTexture(textureHandle);
@@ -17,6 +24,10 @@ class TextureManager {
     AssetView<Texture> GetTexture(const AssetPath& assetPath);
 
   private:
+    Handle CreateTexture(const AssetPath& assetPath,
+                         const TextureAssetFormat& assetData,
+                         std::span<const uint8_t> pixelData);
+
     static inline TextureAssetFormat kDefaultTextureAsset{
         .width = 1,
         .height = 1,
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "util/CpuProfiler.h"
+
+// CpuProfiler::CollectEvents and captures. The profiler is global and other tests record zones
+// too, so every test records on a thread of its own under zone names no one else uses.
+
+namespace {
+using namespace core::util;
+
+void RecordOnNewThread(const std::function<void()>& record) {
+    std::thread thread(record);
+    thread.join();
+}
+
+std::vector<TraceEvent> EventsNamed(const std::vector<TraceEvent>& events,
+                                    const std::string& name) {
+    std::vector<TraceEvent> named;
+    std::ranges::copy_if(events, std::back_inserter(named),
+                         [&name](const TraceEvent& event) { return event.name == name; });
+    return named;
+}
+}  // namespace
+
+TEST(CpuProfilerTest, NestedZonesAreContained) {
+    RecordOnNewThread([] {
+        const CpuZoneScope outer("CpuProfilerTest.Outer");
+        const CpuZoneScope inner("CpuProfilerTest.Inner");
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    });
+
+    const std::vector<TraceEvent> events = CpuProfiler::CollectEvents();
+    const std::vector<TraceEvent> outer = EventsNamed(events, "CpuProfilerTest.Outer");
+    const std::vector<TraceEvent> inner = EventsNamed(events, "CpuProfilerTest.Inner");
+    ASSERT_EQ(outer.size(), 1u);
+    ASSERT_EQ(inner.size(), 1u);
+
+    EXPECT_EQ(outer[0].category, "cpu");
+    EXPECT_EQ(outer[0].threadId, inner[0].threadId);
+    EXPECT_GE(inner[0].durationUs, 1000.0);
+    EXPECT_LE(outer[0].startUs, inner[0].startUs);
+    EXPECT_GE(outer[0].startUs + outer[0].durationUs, inner[0].startUs + inner[0].durationUs);
+}
+
+TEST(CpuProfilerTest, RingKeepsMostRecentZones) {
+    constexpr uint64_t kOverflow = 100;
+    RecordOnNewThread([] {
+        for (uint64_t i = 0; i < CpuProfiler::kZonesPerThread + kOverflow; ++i) {
+            CpuProfiler::Record("CpuProfilerTest.Wrap", i * 1000, i * 1000 + 500);
+        }
+    });
+
+    const std::vector<TraceEvent> wrapped =
+        EventsNamed(CpuProfiler::CollectEvents(), "CpuProfilerTest.Wrap");
+    // The oldest kOverflow zones were overwritten. The oldest slot left is also the one the
+    // thread writes next, so it is dropped as possibly torn; the rest come back oldest first.
+    ASSERT_EQ(wrapped.size(), CpuProfiler::kZonesPerThread - 1);
+    for (size_t i = 0; i < wrapped.size(); ++i) {
+        ASSERT_DOUBLE_EQ(wrapped[i].startUs, static_cast<double>(i + kOverflow + 1)) << "at " << i;
+        ASSERT_DOUBLE_EQ(wrapped[i].durationUs, 0.5) << "at " << i;
+    }
+}
+
+TEST(CpuProfilerTest, CollectSkipsZonesEndingBeforeSince) {
+    RecordOnNewThread([] {
+        CpuProfiler::Record("CpuProfilerTest.Since", 0, 1000);
+        CpuProfiler::Record("CpuProfilerTest.Since", 1000, 2000);
+        // Starts before sinceNs but ends after it, so it is kept.
+        CpuProfiler::Record("CpuProfilerTest.Since", 1500, 3000);
+    });
+
+    const std::vector<TraceEvent> since =
+        EventsNamed(CpuProfiler::CollectEvents(2000), "CpuProfilerTest.Since");
+    ASSERT_EQ(since.size(), 2u);
+    EXPECT_DOUBLE_EQ(since[0].startUs, 1.0);
+    EXPECT_DOUBLE_EQ(since[1].startUs, 1.5);
+}
+
+TEST(CpuProfilerTest, CaptureKeepsOnlyZonesEndingInside) {
+    RecordOnNewThread([] { const CpuZoneScope zone("CpuProfilerTest.BeforeCapture"); });
+    CpuProfiler::BeginCapture();
+    RecordOnNewThread([] { const CpuZoneScope zone("CpuProfilerTest.InCapture"); });
+    CpuProfiler::EndCapture();
+    RecordOnNewThread([] { const CpuZoneScope zone("CpuProfilerTest.AfterCapture"); });
+
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "CpuProfilerTest.json";
+    ASSERT_TRUE(CpuProfiler::WriteChromeTrace(path).has_value());
+    std::stringstream trace;
+    trace << std::ifstream(path).rdbuf();
+    std::filesystem::remove(path);
+
+    EXPECT_EQ(trace.str().find("CpuProfilerTest.BeforeCapture"), std::string::npos);
+    EXPECT_NE(trace.str().find("CpuProfilerTest.InCapture"), std::string::npos);
+    EXPECT_EQ(trace.str().find("CpuProfilerTest.AfterCapture"), std::string::npos);
+}
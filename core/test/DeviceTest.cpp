@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+#include "render/render.h"
+
+// The headless Device: frames go to the owned offscreen target, Present is a no-op and Resize
+// recreates the target at the new size.
+
+namespace {
+using namespace core;
+using namespace core::render;
+
+constexpr uint32_t kBytesPerRow = 256;  // Copy row pitch; covers every width used below.
+
+void Clear(Device& device, const wgpu::Color& color) {
+    const wgpu::RenderPassColorAttachment attachment{
+        .view = device.GetCurrentTextureView(),
+        .loadOp = wgpu::LoadOp::Clear,
+        .storeOp = wgpu::StoreOp::Store,
+        .clearValue = color,
+    };
+    const wgpu::RenderPassDescriptor passDesc{
+        .colorAttachmentCount = 1,
+        .colorAttachments = &attachment,
+    };
+    const wgpu::Device& d = device.GetDevice();
+    wgpu::CommandEncoder encoder = d.CreateCommandEncoder();
+    encoder.BeginRenderPass(&passDesc).End();
+    wgpu::CommandBuffer commands = encoder.Finish();
+    d.GetQueue().Submit(1, &commands);
+}
+
+// Reads back the texel at (x, y) of the current texture.
+std::array<uint8_t, 4> ReadTexel(Device& device, uint32_t x, uint32_t y) {
+    wgpu::Buffer readback = device.CreateBuffer(wgpu::BufferDescriptor{
+        .usage = wgpu::BufferUsage::MapRead | wgpu::BufferUsage::CopyDst,
+        .size = kBytesPerRow,
+    });
+    const wgpu::TexelCopyTextureInfo source{
+        .texture = device.GetCurrentTexture(),
+        .origin = {x, y, 0},
+    };
+    const wgpu::TexelCopyBufferInfo destination{
+        .layout = {.bytesPerRow = kBytesPerRow, .rowsPerImage = 1},
+        .buffer = readback,
+    };
+    const wgpu::Extent3D texel{1, 1, 1};
+    const wgpu::Device& d = device.GetDevice();
+    wgpu::CommandEncoder encoder = d.CreateCommandEncoder();
+    encoder.CopyTextureToBuffer(&source, &destination, &texel);
+    wgpu::CommandBuffer commands = encoder.Finish();
+    d.GetQueue().Submit(1, &commands);
+
+    auto done = std::make_shared<bool>(false);
+    readback.MapAsync(wgpu::MapMode::Read, 0, kBytesPerRow, wgpu::CallbackMode::AllowProcessEvents,
+                      [done](wgpu::MapAsyncStatus, wgpu::StringView) { *done = true; });
+    device.WaitIdle();
+    while (!*done) {
+        device.ProcessEvents();
+        std::this_thread::yield();
+    }
+
+    std::array<uint8_t, 4> texelBytes{};
+    if (const void* mapped = readback.GetConstMappedRange(0, texelBytes.size())) {
+        std::memcpy(texelBytes.data(), mapped, texelBytes.size());
+    }
+    readback.Unmap();
+    return texelBytes;
+}
+}  // namespace
+
+class DeviceTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        device = Device::CreateHeadless(HeadlessSpec{.width = 64, .height = 64});
+        if (device == nullptr) {
+            GTEST_SKIP() << "No WebGPU adapter available";
+        }
+    }
+
+    std::unique_ptr<Device> device;
+};
+
+TEST_F(DeviceTest, RendersIntoOffscreenTarget) {
+    EXPECT_TRUE(device->IsHeadless());
+    const wgpu::Texture target = device->GetCurrentTexture();
+    ASSERT_NE(target.Get(), nullptr);
+    EXPECT_EQ(device->GetCurrentTexture().Get(), target.Get());
+    EXPECT_EQ(target.GetWidth(), 64u);
+    EXPECT_EQ(target.GetHeight(), 64u);
+    EXPECT_EQ(target.GetFormat(), device->GetSurfaceConfig().format);
+
+    Clear(*device, {1.0, 0.0, 0.0, 1.0});
+    EXPECT_EQ(ReadTexel(*device, 63, 63), (std::array<uint8_t, 4>{255, 0, 0, 255}));
+
+    // Presenting neither drops nor replaces the target.
+    device->Present();
+    EXPECT_EQ(device->GetCurrentTexture().Get(), target.Get());
+    EXPECT_EQ(ReadTexel(*device, 0, 0), (std::array<uint8_t, 4>{255, 0, 0, 255}));
+}
+
+TEST_F(DeviceTest, ResizeRecreatesOffscreenTarget) {
+    const wgpu::Texture before = device->GetCurrentTexture();
+    device->Resize(32, 16);
+
+    EXPECT_EQ(device->GetSurfaceConfig().width, 32u);
+    EXPECT_EQ(device->GetSurfaceConfig().height, 16u);
+    const wgpu::Texture after = device->GetCurrentTexture();
+    ASSERT_NE(after.Get(), nullptr);
+    EXPECT_NE(after.Get(), before.Get());
+    EXPECT_EQ(after.GetWidth(), 32u);
+    EXPECT_EQ(after.GetHeight(), 16u);
+    EXPECT_EQ(after.GetUsage(), before.GetUsage());
+
+    Clear(*device, {0.0, 0.0, 1.0, 1.0});
+    EXPECT_EQ(ReadTexel(*device, 31, 15), (std::array<uint8_t, 4>{0, 0, 255, 255}));
+}
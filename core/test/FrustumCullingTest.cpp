@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "render/FrustumCulling.h"
+
+// FrustumCuller::Cull against a scalar reference in double precision. Counts that aren't a
+// multiple of the SIMD width exercise the scalar tail; spheres that touch a plane within
+// rounding are skipped because either answer is correct for them.
+
+namespace {
+using namespace core::render;
+
+enum class Expected : uint8_t { Hidden, Visible, Ambiguous };
+
+struct TestSphere {
+    glm::mat4x4 model;
+    glm::vec4 local;
+};
+
+Frustum MakeFrustum() {
+    const glm::vec3 eye(0.0f, 2.0f, 0.0f);
+    const glm::mat4x4 view =
+        glm::lookAtRH(eye, eye + glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const glm::mat4x4 proj = glm::perspectiveRH(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+    return Frustum::FromViewProj(proj * view);
+}
+
+Expected Reference(const Frustum& frustum, const TestSphere& sphere) {
+    const glm::mat4x4& m = sphere.model;
+    double center[3];
+    for (int row = 0; row < 3; ++row) {
+        center[row] = double(m[0][row]) * sphere.local.x + double(m[1][row]) * sphere.local.y +
+                      double(m[2][row]) * sphere.local.z + double(m[3][row]);
+    }
+    double scaleSq = 0.0;
+    for (int column = 0; column < 3; ++column) {
+        const glm::dvec3 axis(m[column]);
+        scaleSq = std::max(scaleSq, glm::dot(axis, axis));
+    }
+    const double radius = sphere.local.w * std::sqrt(scaleSq);
+
+    constexpr double kTolerance = 1e-3;
+    Expected result = Expected::Visible;
+    for (const glm::vec4& plane : frustum.planes) {
+        const double distance = plane.x * center[0] + plane.y * center[1] +
+                                plane.z * center[2] + plane.w + radius;
+        if (distance < -kTolerance) {
+            return Expected::Hidden;
+        }
+        if (distance <= kTolerance) {
+            result = Expected::Ambiguous;
+        }
+    }
+    return result;
+}
+
+// Positions span well beyond the frustum so both outcomes are common.
+std::vector<TestSphere> RandomSpheres(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-60.0f, 60.0f);
+    std::uniform_real_distribution<float> depth(-120.0f, 20.0f);
+    std::uniform_real_distribution<float> scale(0.25f, 4.0f);
+    std::uniform_real_distribution<float> radius(0.0f, 3.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+
+    std::vector<TestSphere> spheres(count);
+    for (TestSphere& sphere : spheres) {
+        glm::mat4x4 model =
+            glm::translate(glm::mat4x4(1.0f), glm::vec3(position(rng), position(rng), depth(rng)));
+        model = glm::rotate(model, angle(rng), glm::normalize(glm::vec3(1.0f, 2.0f, 3.0f)));
+        model = glm::scale(model, glm::vec3(scale(rng), scale(rng), scale(rng)));
+        sphere.model = model;
+        sphere.local = glm::vec4(position(rng) * 0.05f, position(rng) * 0.05f,
+                                 position(rng) * 0.05f, radius(rng));
+    }
+    return spheres;
+}
+
+void ExpectMatchesReference(FrustumCuller& culler, const Frustum& frustum,
+                            const std::vector<TestSphere>& spheres) {
+    culler.Reset(frustum);
+    for (const TestSphere& sphere : spheres) {
+        culler.AddSphere(sphere.model, sphere.local);
+    }
+    ASSERT_EQ(culler.GetSphereCount(), spheres.size());
+
+    const std::span<const uint8_t> visible = culler.Cull();
+    ASSERT_EQ(visible.size(), spheres.size());
+    for (size_t i = 0; i < spheres.size(); ++i) {
+        const Expected expected = Reference(frustum, spheres[i]);
+        if (expected != Expected::Ambiguous) {
+            ASSERT_EQ(visible[i], expected == Expected::Visible ? 1 : 0)
+                << "sphere " << i << " of " << spheres.size();
+        }
+    }
+}
+}  // namespace
+
+TEST(FrustumCullingTest, KnownSpheres) {
+    const Frustum frustum = MakeFrustum();
+    const glm::mat4x4 identity(1.0f);
+    FrustumCuller culler;
+    culler.Reset(frustum);
+    culler.AddSphere(identity, glm::vec4(0.0f, 2.0f, -10.0f, 1.0f));   // straight ahead
+    culler.AddSphere(identity, glm::vec4(0.0f, 2.0f, 10.0f, 1.0f));    // behind the camera
+    culler.AddSphere(identity, glm::vec4(0.0f, 2.0f, -200.0f, 1.0f));  // past the far plane
+    culler.AddSphere(identity, glm::vec4(0.0f, 2.0f, -0.5f, 1.0f));    // straddles near
+    // Off to the side, but scaled up enough to reach into the frustum.
+    const glm::mat4x4 stretched = glm::scale(identity, glm::vec3(32.0f, 1.0f, 1.0f));
+    culler.AddSphere(identity, glm::vec4(40.0f, 2.0f, -10.0f, 1.0f));
+    culler.AddSphere(stretched, glm::vec4(40.0f / 32.0f, 2.0f, -10.0f, 1.0f));
+
+    const std::span<const uint8_t> visible = culler.Cull();
+    EXPECT_EQ(std::vector<uint8_t>(visible.begin(), visible.end()),
+              (std::vector<uint8_t>{1, 0, 0, 1, 0, 1}));
+}
+
+TEST(FrustumCullingTest, RandomSpheresMatchScalarReference) {
+    const Frustum frustum = MakeFrustum();
+    FrustumCuller culler;
+    // Around multiples of 4 and 8 so both SIMD widths get every tail length.
+    for (size_t count : {0, 1, 3, 4, 5, 7, 8, 9, 11, 15, 16, 17, 1000, 1003, 4099}) {
+        ExpectMatchesReference(culler, frustum, RandomSpheres(count, uint32_t(count) + 1));
+    }
+}
+
+TEST(FrustumCullingTest, ReusedCullerShrinks) {
+    const Frustum frustum = MakeFrustum();
+    FrustumCuller culler;
+    ExpectMatchesReference(culler, frustum, RandomSpheres(2053, 11));
+    ExpectMatchesReference(culler, frustum, RandomSpheres(6, 12));
+    ExpectMatchesReference(culler, frustum, {});
+    ExpectMatchesReference(culler, frustum, RandomSpheres(13, 13));
+}
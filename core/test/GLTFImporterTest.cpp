@@ -0,0 +1,319 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "import/GLTFImporter.h"
+
+// GLTFImporter::ImportFromFile on one quad stored three ways: as a data URI, which tinygltf
+// decodes, and as an external .bin and a .glb BIN chunk, which are mapped. The mapped paths
+// must import exactly what the data URI path does.
+
+namespace {
+using namespace core;
+using namespace core::importer;
+
+// Offsets into the buffer. Positions and normals are interleaved; the leading padding keeps
+// every view away from offset 0.
+constexpr size_t kInterleavedOffset = 8;
+constexpr size_t kTexCoordOffset = kInterleavedOffset + (4 * 24);
+constexpr size_t kShortIndexOffset = kTexCoordOffset + (4 * 8);
+constexpr size_t kIntIndexOffset = kShortIndexOffset + 12;
+constexpr size_t kBufferSize = kIntIndexOffset + 12;
+
+const std::vector<glm::vec3> kPositions{
+    {-1.0f, -1.0f, 0.0f}, {1.0f, -1.0f, 0.0f}, {1.0f, 1.0f, 0.0f}, {-1.0f, 1.0f, 0.0f}};
+const std::vector<uint16_t> kShortIndices{0, 1, 2, 0, 2, 3};
+const std::vector<uint32_t> kIntIndices{0, 1, 3};
+
+template <typename T>
+void Write(std::vector<uint8_t>& bytes, size_t offset, const T& value) {
+    std::memcpy(bytes.data() + offset, &value, sizeof(T));
+}
+
+std::vector<uint8_t> MakeBuffer() {
+    std::vector<uint8_t> bytes(kBufferSize, 0);
+    for (size_t i = 0; i < kPositions.size(); ++i) {
+        Write(bytes, kInterleavedOffset + (i * 24), kPositions[i]);
+        Write(bytes, kInterleavedOffset + (i * 24) + 12, glm::vec3(0.0f, 0.0f, 1.0f));
+        Write(bytes, kTexCoordOffset + (i * 8), glm::vec2(kPositions[i]) * 0.5f + 0.5f);
+    }
+    for (size_t i = 0; i < kShortIndices.size(); ++i) {
+        Write(bytes, kShortIndexOffset + (i * 2), kShortIndices[i]);
+    }
+    for (size_t i = 0; i < kIntIndices.size(); ++i) {
+        Write(bytes, kIntIndexOffset + (i * 4), kIntIndices[i]);
+    }
+    return bytes;
+}
+
+std::string EncodeBase64(const std::vector<uint8_t>& bytes) {
+    constexpr const char* kAlphabet =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string encoded;
+    for (size_t i = 0; i < bytes.size(); i += 3) {
+        const uint32_t b0 = bytes[i];
+        const uint32_t b1 = i + 1 < bytes.size() ? bytes[i + 1] : 0;
+        const uint32_t b2 = i + 2 < bytes.size() ? bytes[i + 2] : 0;
+        const uint32_t triple = (b0 << 16) | (b1 << 8) | b2;
+        encoded += kAlphabet[(triple >> 18) & 63];
+        encoded += kAlphabet[(triple >> 12) & 63];
+        encoded += i + 1 < bytes.size() ? kAlphabet[(triple >> 6) & 63] : '=';
+        encoded += i + 2 < bytes.size() ? kAlphabet[triple & 63] : '=';
+    }
+    return encoded;
+}
+
+// One mesh with two primitives: an indexed quad with normals and texture coordinates, and a
+// position-only triangle with 32-bit indices. A buffer without a uri is the GLB BIN chunk.
+nlohmann::json MakeDocument(const std::optional<std::string>& bufferUri) {
+    nlohmann::json buffer{{"byteLength", kBufferSize}};
+    if (bufferUri.has_value()) {
+        buffer["uri"] = *bufferUri;
+    }
+    const nlohmann::json quad{
+        {"attributes", {{"POSITION", 0}, {"NORMAL", 1}, {"TEXCOORD_0", 2}}}, {"indices", 3}};
+    const nlohmann::json triangle{{"attributes", {{"POSITION", 0}}}, {"indices", 4}};
+    const nlohmann::json mesh{{"primitives", nlohmann::json::array({quad, triangle})}};
+    const nlohmann::json node{{"mesh", 0}};
+    const nlohmann::json scene{{"nodes", nlohmann::json::array({0})}};
+    return nlohmann::json{
+        {"asset", {{"version", "2.0"}}},
+        {"buffers", nlohmann::json::array({buffer})},
+        {"bufferViews",
+         {
+             {{"buffer", 0}, {"byteOffset", kInterleavedOffset}, {"byteLength", 4 * 24},
+              {"byteStride", 24}},
+             {{"buffer", 0}, {"byteOffset", kTexCoordOffset}, {"byteLength", 4 * 8}},
+             {{"buffer", 0}, {"byteOffset", kShortIndexOffset}, {"byteLength", 12}},
+             {{"buffer", 0}, {"byteOffset", kIntIndexOffset}, {"byteLength", 12}},
+         }},
+        {"accessors",
+         {
+             {{"bufferView", 0}, {"componentType", TINYGLTF_COMPONENT_TYPE_FLOAT}, {"count", 4},
+              {"type", "VEC3"}, {"min", {-1, -1, 0}}, {"max", {1, 1, 0}}},
+             {{"bufferView", 0}, {"byteOffset", 12},
+              {"componentType", TINYGLTF_COMPONENT_TYPE_FLOAT}, {"count", 4}, {"type", "VEC3"}},
+             {{"bufferView", 1}, {"componentType", TINYGLTF_COMPONENT_TYPE_FLOAT}, {"count", 4},
+              {"type", "VEC2"}},
+             {{"bufferView", 2}, {"componentType", TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT},
+              {"count", 6}, {"type", "SCALAR"}},
+             {{"bufferView", 3}, {"componentType", TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT},
+              {"count", 3}, {"type", "SCALAR"}},
+         }},
+        {"meshes", nlohmann::json::array({mesh})},
+        {"nodes", nlohmann::json::array({node})},
+        {"scenes", nlohmann::json::array({scene})},
+        {"scene", 0},
+    };
+}
+
+void WriteFile(const std::filesystem::path& path, const std::vector<uint8_t>& bytes) {
+    std::ofstream(path, std::ios::binary)
+        .write(reinterpret_cast<const char*>(bytes.data()), std::streamsize(bytes.size()));
+}
+
+void WriteText(const std::filesystem::path& path, const std::string& text) {
+    WriteFile(path, std::vector<uint8_t>(text.begin(), text.end()));
+}
+
+void AppendU32(std::vector<uint8_t>& bytes, uint32_t value) {
+    const size_t offset = bytes.size();
+    bytes.resize(offset + 4);
+    Write(bytes, offset, value);
+}
+
+// Both chunks are padded to 4 bytes, the JSON one with spaces as the spec asks.
+std::vector<uint8_t> MakeGlb(std::string json, std::vector<uint8_t> bin) {
+    json.resize((json.size() + 3) & ~size_t(3), ' ');
+    bin.resize((bin.size() + 3) & ~size_t(3), 0);
+    std::vector<uint8_t> glb;
+    AppendU32(glb, 0x46546C67);  // "glTF"
+    AppendU32(glb, 2);
+    AppendU32(glb, uint32_t(12 + 8 + json.size() + 8 + bin.size()));
+    AppendU32(glb, uint32_t(json.size()));
+    AppendU32(glb, 0x4E4F534A);  // "JSON"
+    glb.insert(glb.end(), json.begin(), json.end());
+    AppendU32(glb, uint32_t(bin.size()));
+    AppendU32(glb, 0x004E4942);  // "BIN\0"
+    glb.insert(glb.end(), bin.begin(), bin.end());
+    return glb;
+}
+
+void ExpectSameMesh(const MeshAssetFormat& actual, const MeshAssetFormat& expected) {
+    EXPECT_EQ(actual.states, expected.states);
+    ASSERT_EQ(actual.bufferRanges.size(), expected.bufferRanges.size());
+    for (size_t i = 0; i < actual.bufferRanges.size(); ++i) {
+        EXPECT_EQ(actual.bufferRanges[i].offset, expected.bufferRanges[i].offset);
+        EXPECT_EQ(actual.bufferRanges[i].size, expected.bufferRanges[i].size);
+    }
+    ASSERT_EQ(actual.subMeshes.size(), expected.subMeshes.size());
+    for (size_t i = 0; i < actual.subMeshes.size(); ++i) {
+        EXPECT_EQ(actual.subMeshes[i].indexCount, expected.subMeshes[i].indexCount);
+        EXPECT_EQ(actual.subMeshes[i].indexStart, expected.subMeshes[i].indexStart);
+        EXPECT_EQ(actual.subMeshes[i].stateIndex, expected.subMeshes[i].stateIndex);
+        EXPECT_EQ(actual.subMeshes[i].bufferRangeStart, expected.subMeshes[i].bufferRangeStart);
+        EXPECT_EQ(actual.subMeshes[i].bufferRangeCount, expected.subMeshes[i].bufferRangeCount);
+    }
+    ASSERT_EQ(actual.subMeshBounds.size(), expected.subMeshBounds.size());
+    for (size_t i = 0; i < actual.subMeshBounds.size(); ++i) {
+        EXPECT_EQ(actual.subMeshBounds[i].aabbMin, expected.subMeshBounds[i].aabbMin);
+        EXPECT_EQ(actual.subMeshBounds[i].aabbMax, expected.subMeshBounds[i].aabbMax);
+        EXPECT_EQ(actual.subMeshBounds[i].sphereRadius, expected.subMeshBounds[i].sphereRadius);
+    }
+    EXPECT_EQ(actual.indexData, expected.indexData);
+    EXPECT_EQ(actual.vertexData, expected.vertexData);
+}
+
+// A model for ImportMesh with one position-only primitive over the quad buffer.
+tinygltf::Model MakeModel() {
+    const nlohmann::json document = MakeDocument(std::nullopt);
+    tinygltf::Model model;
+    for (const nlohmann::json& entry : document["bufferViews"]) {
+        tinygltf::BufferView view;
+        view.buffer = entry["buffer"];
+        view.byteOffset = entry["byteOffset"];
+        view.byteLength = entry["byteLength"];
+        view.byteStride = entry.value("byteStride", 0);
+        model.bufferViews.push_back(view);
+    }
+    tinygltf::Accessor positions;
+    positions.bufferView = 0;
+    positions.componentType = TINYGLTF_COMPONENT_TYPE_FLOAT;
+    positions.type = TINYGLTF_TYPE_VEC3;
+    positions.count = 4;
+    tinygltf::Accessor indices;
+    indices.bufferView = 2;
+    indices.componentType = TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT;
+    indices.type = TINYGLTF_TYPE_SCALAR;
+    indices.count = 6;
+    model.accessors = {positions, indices};
+
+    tinygltf::Primitive primitive;
+    primitive.attributes["POSITION"] = 0;
+    primitive.indices = 1;
+    tinygltf::Mesh mesh;
+    mesh.primitives.push_back(primitive);
+    model.meshes.push_back(mesh);
+    return model;
+}
+}  // namespace
+
+class GLTFImporterTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        directory = std::filesystem::temp_directory_path() / "GLTFImporterTest";
+        std::filesystem::create_directories(directory);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(directory); }
+
+    MeshAssetFormat ImportQuad(const std::filesystem::path& path) {
+        auto resultOrError = GLTFImporter::ImportFromFile(path.string());
+        if (!resultOrError.has_value() || resultOrError->meshes.size() != 1) {
+            ADD_FAILURE() << "no mesh imported from " << path;
+            return {};
+        }
+        EXPECT_EQ(resultOrError->modelAsset.nodes.size(), 1u);
+        return resultOrError->meshes[0].meshAsset;
+    }
+
+    std::filesystem::path directory;
+    const std::vector<uint8_t> buffer = MakeBuffer();
+};
+
+TEST_F(GLTFImporterTest, DataUriImportsTheQuad) {
+    const std::filesystem::path path = directory / "quad.gltf";
+    WriteText(path,
+              MakeDocument("data:application/octet-stream;base64," + EncodeBase64(buffer)).dump());
+    const MeshAssetFormat mesh = ImportQuad(path);
+
+    ASSERT_EQ(mesh.subMeshes.size(), 2u);
+    EXPECT_EQ(mesh.indexData, (std::vector<uint32_t>{0, 1, 2, 0, 2, 3, 0, 1, 3}));
+    EXPECT_EQ(mesh.subMeshes[1].indexStart, 6u);
+    ASSERT_EQ(mesh.states.size(), 2u);
+    EXPECT_TRUE(mesh.states[0].HasAttribute(Semantic::TexCoord0));
+    EXPECT_FALSE(mesh.states[1].HasAttribute(Semantic::TexCoord0));
+
+    // The position slot of the first primitive comes out of the interleaved view unstrided.
+    ASSERT_GE(mesh.vertexData.size(), kPositions.size() * sizeof(glm::vec3));
+    std::vector<glm::vec3> positions(kPositions.size());
+    std::memcpy(positions.data(), mesh.vertexData.data(), positions.size() * sizeof(glm::vec3));
+    EXPECT_EQ(positions, kPositions);
+    EXPECT_EQ(mesh.subMeshBounds[0].aabbMin, glm::vec3(-1.0f, -1.0f, 0.0f));
+    EXPECT_EQ(mesh.subMeshBounds[0].aabbMax, glm::vec3(1.0f, 1.0f, 0.0f));
+}
+
+TEST_F(GLTFImporterTest, ExternalBinMatchesDataUri) {
+    const std::filesystem::path dataUriPath = directory / "quad.gltf";
+    WriteText(dataUriPath,
+              MakeDocument("data:application/octet-stream;base64," + EncodeBase64(buffer)).dump());
+    // The space in the name checks that the uri is percent-decoded.
+    const std::filesystem::path binPath = directory / "quad data.bin";
+    WriteFile(binPath, buffer);
+    const std::filesystem::path gltfPath = directory / "quad_external.gltf";
+    WriteText(gltfPath, MakeDocument("quad%20data.bin").dump());
+
+    ExpectSameMesh(ImportQuad(gltfPath), ImportQuad(dataUriPath));
+}
+
+TEST_F(GLTFImporterTest, GlbMatchesDataUri) {
+    const std::filesystem::path dataUriPath = directory / "quad.gltf";
+    WriteText(dataUriPath,
+              MakeDocument("data:application/octet-stream;base64," + EncodeBase64(buffer)).dump());
+    const std::filesystem::path glbPath = directory / "quad.glb";
+    WriteFile(glbPath, MakeGlb(MakeDocument(std::nullopt).dump(), buffer));
+
+    ExpectSameMesh(ImportQuad(glbPath), ImportQuad(dataUriPath));
+}
+
+TEST_F(GLTFImporterTest, MissingBinFails) {
+    const std::filesystem::path gltfPath = directory / "quad_missing.gltf";
+    WriteText(gltfPath, MakeDocument("missing.bin").dump());
+    EXPECT_FALSE(GLTFImporter::ImportFromFile(gltfPath.string()).has_value());
+}
+
+TEST_F(GLTFImporterTest, TruncatedGlbFails) {
+    std::vector<uint8_t> glb = MakeGlb(MakeDocument(std::nullopt).dump(), buffer);
+    glb.resize(glb.size() - 16);
+    // The header still claims the full length, so the BIN chunk runs past the end.
+    const std::filesystem::path glbPath = directory / "truncated.glb";
+    WriteFile(glbPath, glb);
+    EXPECT_FALSE(GLTFImporter::ImportFromFile(glbPath.string()).has_value());
+}
+
+TEST(GLTFImporterMeshTest, IndexAccessorWithoutBufferViewFails) {
+    tinygltf::Model model = MakeModel();
+    const std::vector<uint8_t> buffer = MakeBuffer();
+    const GLTFBufferSpans buffers{buffer};
+
+    ASSERT_TRUE(GLTFImporter::ImportMesh(model, buffers, model.meshes[0]).has_value());
+
+    model.accessors[1].bufferView = -1;
+    EXPECT_FALSE(GLTFImporter::ImportMesh(model, buffers, model.meshes[0]).has_value());
+    model.accessors[1].bufferView = int(model.bufferViews.size());
+    EXPECT_FALSE(GLTFImporter::ImportMesh(model, buffers, model.meshes[0]).has_value());
+}
+
+TEST(GLTFImporterMeshTest, IndexBufferViewWithoutBufferFails) {
+    tinygltf::Model model = MakeModel();
+    const std::vector<uint8_t> buffer = MakeBuffer();
+    const GLTFBufferSpans buffers{buffer};
+
+    model.bufferViews[2].buffer = 1;
+    EXPECT_FALSE(GLTFImporter::ImportMesh(model, buffers, model.meshes[0]).has_value());
+    model.bufferViews[2].buffer = -1;
+    EXPECT_FALSE(GLTFImporter::ImportMesh(model, buffers, model.meshes[0]).has_value());
+}
+
+TEST(GLTFImporterMeshTest, IndexAccessorPastItsBufferFails) {
+    tinygltf::Model model = MakeModel();
+    const std::vector<uint8_t> buffer = MakeBuffer();
+    const GLTFBufferSpans buffers{std::span<const uint8_t>(buffer).first(kShortIndexOffset + 6)};
+
+    EXPECT_FALSE(GLTFImporter::ImportMesh(model, buffers, model.meshes[0]).has_value());
+}
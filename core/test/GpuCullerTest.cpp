@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "render/backend/GpuCuller.h"
+
+// GpuCuller on a headless device: dispatches the culling shader for a fixed scene and reads
+// the indirect arguments back. Survivors are appended with an atomic, so only the counts are
+// deterministic, not the order of the visible instance list.
+
+namespace {
+using namespace core;
+using namespace core::render;
+
+// Camera at the origin looking down -Z.
+Frustum MakeFrustum() {
+    const glm::mat4x4 view = glm::lookAtRH(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f),
+                                           glm::vec3(0.0f, 1.0f, 0.0f));
+    const glm::mat4x4 proj = glm::perspectiveRH(glm::radians(60.0f), 1.0f, 0.1f, 100.0f);
+    return Frustum::FromViewProj(proj * view);
+}
+
+RenderIntent MakeIntent(uint32_t indexCount, uint32_t indexStart, uint32_t firstInstance,
+                        uint32_t instanceCount, glm::vec4 sphere) {
+    RenderIntent intent{};
+    intent.subMeshInfo.indexCount = indexCount;
+    intent.subMeshInfo.indexStart = indexStart;
+    intent.firstInstance = firstInstance;
+    intent.instanceCount = instanceCount;
+    intent.boundingSphere = sphere;
+    return intent;
+}
+}  // namespace
+
+class GpuCullerTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        device = Device::CreateHeadless(HeadlessSpec{.width = 64, .height = 64});
+        if (device == nullptr) {
+            GTEST_SKIP() << "No WebGPU adapter available";
+        }
+        culler = std::make_unique<GpuCuller>(device.get());
+
+        const std::vector<glm::vec3> positions{
+            {0.0f, 0.0f, -10.0f},    // 0: ahead
+            {0.0f, 0.0f, 10.0f},     // 1: behind the camera
+            {0.0f, 0.0f, -5.0f},     // 2: ahead
+            {100.0f, 0.0f, -10.0f},  // 3: far to the right
+            {0.0f, 0.0f, -500.0f},   // 4: past the far plane
+            {2.0f, 0.0f, -20.0f},    // 5: ahead
+        };
+        std::vector<glm::mat4x4> models;
+        for (const glm::vec3& position : positions) {
+            models.push_back(glm::translate(glm::mat4x4(1.0f), position));
+        }
+        transforms = device->CreateBufferFromData(
+            models.data(), models.size() * sizeof(glm::mat4x4), wgpu::BufferUsage::Storage);
+        visibleInstances = device->CreateBuffer(wgpu::BufferDescriptor{
+            .usage = wgpu::BufferUsage::Storage,
+            .size = instances.size() * sizeof(uint32_t),
+        });
+    }
+
+    std::vector<DrawIndexedIndirectArgs> CullFrame() {
+        const glm::vec4 unitSphere(0.0f, 0.0f, 0.0f, 1.0f);
+        std::vector<RenderIntent> intents{
+            MakeIntent(36, 0, 0, 3, unitSphere),
+            MakeIntent(12, 36, 3, 2, unitSphere),
+            MakeIntent(6, 48, 5, 1, unitSphere),
+            // No bounds: never culled, even behind the camera.
+            MakeIntent(3, 54, 6, 1,
+                       glm::vec4(0.0f, 0.0f, 0.0f, std::numeric_limits<float>::infinity())),
+        };
+
+        culler->Reset(MakeFrustum());
+        culler->AddDraws(intents, instances);
+        EXPECT_EQ(culler->GetDrawCount(), intents.size());
+        EXPECT_EQ(culler->GetCandidateCount(), instances.size());
+        for (uint32_t i = 0; i < intents.size(); ++i) {
+            EXPECT_EQ(intents[i].indirectIndex, i);
+        }
+
+        culler->Upload();
+        const wgpu::Device& d = device->GetDevice();
+        wgpu::CommandEncoder encoder = d.CreateCommandEncoder();
+        wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+        culler->Dispatch(pass, transforms, visibleInstances);
+        pass.End();
+        wgpu::CommandBuffer commands = encoder.Finish();
+        d.GetQueue().Submit(1, &commands);
+        return culler->ReadbackDrawArgs();
+    }
+
+    // Transform indices as InstanceBatcher would lay them out for the intents of CullFrame.
+    const std::vector<uint32_t> instances{0, 1, 2, 3, 4, 5, 1};
+    std::unique_ptr<Device> device;
+    std::unique_ptr<GpuCuller> culler;
+    wgpu::Buffer transforms;
+    wgpu::Buffer visibleInstances;
+};
+
+TEST_F(GpuCullerTest, CountsVisibleInstancesPerDraw) {
+    const std::vector<DrawIndexedIndirectArgs> args = CullFrame();
+
+    ASSERT_EQ(args.size(), 4u);
+    EXPECT_EQ(args[0].instanceCount, 2u);
+    EXPECT_EQ(args[1].instanceCount, 0u);
+    EXPECT_EQ(args[2].instanceCount, 1u);
+    EXPECT_EQ(args[3].instanceCount, 1u);
+
+    // Everything but the count comes from the intent unchanged.
+    EXPECT_EQ(args[1].indexCount, 12u);
+    EXPECT_EQ(args[1].firstIndex, 36u);
+    EXPECT_EQ(args[1].baseVertex, 0);
+    EXPECT_EQ(args[1].firstInstance, 3u);
+    EXPECT_EQ(args[3].firstInstance, 6u);
+}
+
+TEST_F(GpuCullerTest, CountsRestartEveryFrame) {
+    CullFrame();
+    const std::vector<DrawIndexedIndirectArgs> args = CullFrame();
+
+    ASSERT_EQ(args.size(), 4u);
+    EXPECT_EQ(args[0].instanceCount, 2u);
+    EXPECT_EQ(args[2].instanceCount, 1u);
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <optional>
+
+#include "render/backend/GpuProfiler.h"
+
+// GpuProfiler on a headless device: profiles frames of one empty render pass and polls until
+// the readback resolves. Without TimestampQuery the profiler must stay off and skip frames.
+
+namespace {
+using namespace core;
+using namespace core::render;
+
+constexpr uint32_t kPassId = 3;
+}  // namespace
+
+class GpuProfilerTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        device = Device::CreateHeadless(HeadlessSpec{.width = 64, .height = 64});
+        if (device == nullptr) {
+            GTEST_SKIP() << "No WebGPU adapter available";
+        }
+        profiler = std::make_unique<GpuProfiler>(device.get(), &passManager);
+        profiler->SetEnabled(true);
+    }
+
+    // Returns whether the profiler handed out timestamp writes for the pass.
+    bool RenderFrame() {
+        profiler->BeginFrame();
+        const wgpu::PassTimestampWrites* timestampWrites = profiler->WriteNode(kPassId);
+
+        const wgpu::RenderPassColorAttachment attachment{
+            .view = device->GetCurrentTextureView(),
+            .loadOp = wgpu::LoadOp::Clear,
+            .storeOp = wgpu::StoreOp::Store,
+        };
+        const wgpu::RenderPassDescriptor passDesc{
+            .colorAttachmentCount = 1,
+            .colorAttachments = &attachment,
+            .timestampWrites = timestampWrites,
+        };
+        const wgpu::Device& d = device->GetDevice();
+        wgpu::CommandEncoder encoder = d.CreateCommandEncoder();
+        encoder.BeginRenderPass(&passDesc).End();
+        profiler->EndFrame(encoder);
+        wgpu::CommandBuffer commands = encoder.Finish();
+        d.GetQueue().Submit(1, &commands);
+        profiler->AfterSubmit();
+        return timestampWrites != nullptr;
+    }
+
+    PassManager passManager;
+    std::unique_ptr<Device> device;
+    std::unique_ptr<GpuProfiler> profiler;
+};
+
+TEST_F(GpuProfilerTest, ResolvesNodeTimings) {
+    if (!profiler->IsSupported()) {
+        GTEST_SKIP() << "Adapter lacks TimestampQuery";
+    }
+    EXPECT_TRUE(profiler->IsEnabled());
+    EXPECT_FALSE(profiler->GetTiming(kPassId).has_value());
+
+    ASSERT_TRUE(RenderFrame());
+    // Readbacks resolve in a later BeginFrame, once the map callback has fired.
+    for (int frame = 0; frame < 100 && !profiler->GetTiming(kPassId).has_value(); ++frame) {
+        device->WaitIdle();
+        RenderFrame();
+    }
+
+    const std::optional<GpuPassTiming> timing = profiler->GetTiming(kPassId);
+    ASSERT_TRUE(timing.has_value());
+    EXPECT_GE(timing->sampleCount, 1u);
+    EXPECT_GE(timing->lastMs, 0.0f);
+    EXPECT_FALSE(profiler->GetTiming(kPassId + 1).has_value());
+
+    // Every readback buffer was unmapped again, so profiling keeps going.
+    const uint64_t samples = timing->sampleCount;
+    for (int frame = 0; frame < 100 && profiler->GetTiming(kPassId)->sampleCount == samples;
+         ++frame) {
+        device->WaitIdle();
+        RenderFrame();
+    }
+    EXPECT_GT(profiler->GetTiming(kPassId)->sampleCount, samples);
+}
+
+TEST_F(GpuProfilerTest, UnsupportedDeviceSkipsFrames) {
+    if (profiler->IsSupported()) {
+        GTEST_SKIP() << "Adapter supports TimestampQuery";
+    }
+    EXPECT_FALSE(profiler->IsEnabled());
+    for (int frame = 0; frame < 4; ++frame) {
+        EXPECT_FALSE(RenderFrame());
+    }
+    EXPECT_FALSE(profiler->GetTiming(kPassId).has_value());
+}
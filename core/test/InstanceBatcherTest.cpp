@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+#include "render/InstanceBatcher.h"
+
+// InstanceBatcher::Batch on hand-made intents. Without a device every GPU handle is null, so
+// draws are told apart by their submesh range alone.
+
+namespace {
+using namespace core::render;
+
+struct Draw {
+    uint32_t indexStart;
+    uint32_t transformIndex;
+};
+
+std::vector<RenderIntent> MakeIntents(const std::vector<Draw>& draws) {
+    std::vector<RenderIntent> intents(draws.size());
+    for (size_t i = 0; i < draws.size(); ++i) {
+        intents[i].transformIndex = draws[i].transformIndex;
+        intents[i].subMeshInfo.indexStart = draws[i].indexStart;
+        intents[i].subMeshInfo.indexCount = 36;
+        intents[i].sortKey = draws[i].indexStart;
+    }
+    return intents;
+}
+
+std::vector<uint32_t> Instances(const InstanceBatcher& batcher) {
+    return {batcher.GetInstances().begin(), batcher.GetInstances().end()};
+}
+
+void ExpectDraw(const RenderIntent& intent, uint32_t indexStart, uint32_t firstInstance,
+                uint32_t instanceCount) {
+    EXPECT_EQ(intent.subMeshInfo.indexStart, indexStart);
+    EXPECT_EQ(intent.firstInstance, firstInstance);
+    EXPECT_EQ(intent.instanceCount, instanceCount);
+}
+}  // namespace
+
+TEST(InstanceBatcherTest, MergesRunsOfSameDraw) {
+    InstanceBatcher batcher;
+    std::vector<RenderIntent> intents =
+        MakeIntents({{0, 10}, {0, 11}, {0, 12}, {36, 20}, {36, 21}});
+
+    batcher.Batch(intents);
+
+    ASSERT_EQ(intents.size(), 2u);
+    ExpectDraw(intents[0], 0, 0, 3);
+    ExpectDraw(intents[1], 36, 3, 2);
+    // The run keeps the transform of its first intent; the rest are only instances.
+    EXPECT_EQ(intents[0].transformIndex, 10u);
+    EXPECT_EQ(intents[1].transformIndex, 20u);
+    EXPECT_EQ(Instances(batcher), (std::vector<uint32_t>{10, 11, 12, 20, 21}));
+}
+
+TEST(InstanceBatcherTest, MergeRunsOffKeepsSingleDraws) {
+    InstanceBatcher batcher;
+    std::vector<RenderIntent> intents = MakeIntents({{0, 10}, {0, 11}, {36, 20}});
+
+    batcher.Batch(intents, false);
+
+    ASSERT_EQ(intents.size(), 3u);
+    ExpectDraw(intents[0], 0, 0, 1);
+    ExpectDraw(intents[1], 0, 1, 1);
+    ExpectDraw(intents[2], 36, 2, 1);
+    EXPECT_EQ(Instances(batcher), (std::vector<uint32_t>{10, 11, 20}));
+}
+
+TEST(InstanceBatcherTest, DifferentDrawBreaksRun) {
+    InstanceBatcher batcher;
+    std::vector<RenderIntent> intents = MakeIntents({{0, 1}, {0, 2}, {36, 3}, {0, 4}, {0, 5}});
+
+    batcher.Batch(intents);
+
+    // Only adjacent intents merge, so the draw after the interruption starts a new run.
+    ASSERT_EQ(intents.size(), 3u);
+    ExpectDraw(intents[0], 0, 0, 2);
+    ExpectDraw(intents[1], 36, 2, 1);
+    ExpectDraw(intents[2], 0, 3, 2);
+    EXPECT_EQ(Instances(batcher), (std::vector<uint32_t>{1, 2, 3, 4, 5}));
+}
+
+TEST(InstanceBatcherTest, PassesShareInstanceListUntilReset) {
+    InstanceBatcher batcher;
+    std::vector<RenderIntent> first = MakeIntents({{0, 7}, {0, 8}});
+    std::vector<RenderIntent> second = MakeIntents({{0, 9}});
+
+    batcher.Batch(first);
+    batcher.Batch(second);
+
+    // The second pass appends after the first, even for an identical draw.
+    ExpectDraw(first[0], 0, 0, 2);
+    ASSERT_EQ(second.size(), 1u);
+    ExpectDraw(second[0], 0, 2, 1);
+    EXPECT_EQ(Instances(batcher), (std::vector<uint32_t>{7, 8, 9}));
+
+    batcher.Reset();
+    std::vector<RenderIntent> next = MakeIntents({{0, 9}});
+    batcher.Batch(next);
+    ExpectDraw(next[0], 0, 0, 1);
+    EXPECT_EQ(Instances(batcher), (std::vector<uint32_t>{9}));
+}
@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "util/JobSystem.h"
+
+// JobSystem under load from workers, nested jobs and outside threads, and the rule that Wait
+// leaves background jobs to idle workers and RunPendingJob.
+
+namespace {
+using namespace core::util;
+
+// Spins without helping the job system, so only workers can make progress.
+void SpinUntil(const std::atomic<bool>& flag) {
+    while (!flag.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+}
+
+// Counts a node of a binary tree of jobs in which every job submits its children.
+void SubmitTree(JobSystem& jobs, JobCounter& counter, std::atomic<uint32_t>& visited,
+                uint32_t depth) {
+    visited.fetch_add(1, std::memory_order_relaxed);
+    if (depth == 0) {
+        return;
+    }
+    for (int child = 0; child < 2; ++child) {
+        jobs.Submit(
+            [&jobs, &counter, &visited, depth] { SubmitTree(jobs, counter, visited, depth - 1); },
+            &counter);
+    }
+}
+}  // namespace
+
+TEST(JobSystemTest, WaitLeavesBackgroundJobsAlone) {
+    JobSystem jobs(1);
+    std::atomic<bool> blockerStarted = false;
+    std::atomic<bool> release = false;
+    std::atomic<bool> backgroundRan = false;
+    std::thread::id backgroundThread;
+
+    // Keeps the only worker busy, so queued jobs can only run on this thread.
+    jobs.SubmitBackground([&] {
+        blockerStarted.store(true, std::memory_order_release);
+        SpinUntil(release);
+    });
+    SpinUntil(blockerStarted);
+    jobs.SubmitBackground([&] {
+        backgroundThread = std::this_thread::get_id();
+        backgroundRan.store(true, std::memory_order_release);
+    });
+
+    JobCounter counter;
+    std::atomic<uint32_t> ran = 0;
+    for (int i = 0; i < 64; ++i) {
+        jobs.Submit([&ran] { ran.fetch_add(1, std::memory_order_relaxed); }, &counter);
+    }
+    jobs.Wait(counter);
+    EXPECT_EQ(ran.load(), 64u);
+    EXPECT_FALSE(backgroundRan.load());
+
+    jobs.ParallelFor(1000, [](uint32_t) {});
+    EXPECT_FALSE(backgroundRan.load());
+
+    // RunPendingJob is the one way for a non-worker to pick it up.
+    EXPECT_TRUE(jobs.RunPendingJob());
+    EXPECT_TRUE(backgroundRan.load());
+    EXPECT_EQ(backgroundThread, std::this_thread::get_id());
+    release.store(true, std::memory_order_release);
+}
+
+TEST(JobSystemTest, IdleWorkersRunBackgroundJobs) {
+    JobSystem jobs(2);
+    JobCounter counter;
+    std::atomic<uint32_t> ran = 0;
+    for (int i = 0; i < 100; ++i) {
+        jobs.SubmitBackground([&ran] { ran.fetch_add(1, std::memory_order_relaxed); }, &counter);
+    }
+    while (!counter.IsDone()) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(ran.load(), 100u);
+}
+
+TEST(JobSystemTest, BackgroundJobsRunInlineWithoutWorkers) {
+    JobSystem jobs(0);
+    bool ran = false;
+    jobs.SubmitBackground([&ran] { ran = true; });
+    EXPECT_TRUE(ran);
+    EXPECT_FALSE(jobs.RunPendingJob());
+}
+
+TEST(JobSystemTest, StressParallelForNestedInJobs) {
+    JobSystem jobs(4);
+    constexpr uint32_t kOuter = 64;
+    constexpr uint32_t kInner = 1000;
+    for (int round = 0; round < 20; ++round) {
+        std::vector<std::atomic<uint32_t>> hits(kOuter * kInner);
+        jobs.ParallelFor(kOuter, [&](uint32_t outer) {
+            jobs.ParallelFor(
+                kInner,
+                [&](uint32_t inner) {
+                    hits[outer * kInner + inner].fetch_add(1, std::memory_order_relaxed);
+                },
+                16);
+        });
+        for (const std::atomic<uint32_t>& hit : hits) {
+            ASSERT_EQ(hit.load(), 1u);
+        }
+    }
+}
+
+TEST(JobSystemTest, StressJobsSubmittingJobs) {
+    JobSystem jobs(4);
+    for (int round = 0; round < 20; ++round) {
+        JobCounter counter;
+        std::atomic<uint32_t> visited = 0;
+        jobs.Submit([&] { SubmitTree(jobs, counter, visited, 12); }, &counter);
+        jobs.Wait(counter);
+        ASSERT_EQ(visited.load(), (1u << 13) - 1);
+    }
+}
+
+TEST(JobSystemTest, StressTaskGraphOrder) {
+    JobSystem jobs(4);
+    // Layers of tasks where every task depends on all tasks of the previous layer.
+    constexpr uint32_t kLayers = 8;
+    constexpr uint32_t kWidth = 16;
+    std::vector<std::atomic<uint32_t>> finishedPerLayer(kLayers);
+    std::atomic<bool> orderViolated = false;
+
+    TaskGraph graph;
+    std::vector<TaskGraph::TaskId> previous;
+    for (uint32_t layer = 0; layer < kLayers; ++layer) {
+        std::vector<TaskGraph::TaskId> current;
+        for (uint32_t i = 0; i < kWidth; ++i) {
+            const TaskGraph::TaskId task = graph.AddTask([&, layer] {
+                if (layer > 0 && finishedPerLayer[layer - 1].load() != kWidth) {
+                    orderViolated = true;
+                }
+                finishedPerLayer[layer].fetch_add(1);
+            });
+            for (TaskGraph::TaskId before : previous) {
+                graph.AddDependency(before, task);
+            }
+            current.push_back(task);
+        }
+        previous = std::move(current);
+    }
+
+    for (int round = 0; round < 50; ++round) {
+        for (std::atomic<uint32_t>& finished : finishedPerLayer) {
+            finished = 0;
+        }
+        jobs.Run(graph);
+        for (const std::atomic<uint32_t>& finished : finishedPerLayer) {
+            ASSERT_EQ(finished.load(), kWidth);
+        }
+    }
+    EXPECT_FALSE(orderViolated.load());
+}
+
+TEST(JobSystemTest, StressOutsideThreadsWithBackgroundLoad) {
+    JobSystem jobs(3);
+    JobCounter backgroundCounter;
+    std::atomic<uint32_t> backgroundRan = 0;
+    for (int i = 0; i < 200; ++i) {
+        jobs.SubmitBackground(
+            [&backgroundRan] { backgroundRan.fetch_add(1, std::memory_order_relaxed); },
+            &backgroundCounter);
+    }
+
+    // Non-worker threads share one deque; each waits on its own jobs only.
+    std::atomic<uint32_t> total = 0;
+    std::vector<std::jthread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int round = 0; round < 50; ++round) {
+                JobCounter counter;
+                std::atomic<uint32_t> ran = 0;
+                for (int i = 0; i < 32; ++i) {
+                    jobs.Submit([&ran] { ran.fetch_add(1, std::memory_order_relaxed); },
+                                &counter);
+                }
+                jobs.Wait(counter);
+                EXPECT_EQ(ran.load(), 32u);
+                total.fetch_add(ran.load(), std::memory_order_relaxed);
+            }
+        });
+    }
+    threads.clear();
+    EXPECT_EQ(total.load(), 4u * 50u * 32u);
+
+    while (!backgroundCounter.IsDone()) {
+        jobs.RunPendingJob();
+    }
+    EXPECT_EQ(backgroundRan.load(), 200u);
+}
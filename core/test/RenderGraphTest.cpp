@@ -0,0 +1,323 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Application.h"
+#include "render/SceneRenderer.h"
+#include "render/graph/RenderGraph.h"
+
+// RenderGraph::Compile on a headless device. The test passes only declare resources in Setup;
+// nothing is executed, so no shaders are needed.
+
+namespace {
+using namespace core;
+using namespace core::render;
+
+template <void (*SetupFn)(PassSetupContext&)>
+class ScriptedPass : public IRenderPass {
+  public:
+    void Execute(wgpu::RenderPassEncoder, const PassExecuteContext&) override {}
+    void Setup(PassSetupContext& context) override { SetupFn(context); }
+};
+
+TextureDescriptor ColorTarget(const std::string& label) {
+    return TextureDescriptor{
+        .label = label,
+        .usage = wgpu::TextureUsage::RenderAttachment | wgpu::TextureUsage::TextureBinding,
+        .dimension = wgpu::TextureDimension::e2D,
+        .size = RelativeSize{1.0f, 1.0f},
+        .format = wgpu::TextureFormat::RGBA8Unorm,
+    };
+}
+
+void WriteSceneColor(PassSetupContext& context) {
+    context.RegisterPassOutputs({{PassSetupContext::kSceneColorHandle}});
+}
+
+void WriteDead(PassSetupContext& context) {
+    context.RegisterPassOutputs({{context.DeclareTexture("Dead", ColorTarget("Dead"))}});
+}
+
+void ReadDeadWriteDeadOut(PassSetupContext& context) {
+    context.RegisterTextureRead(context.GetResourceHandle("Dead"));
+    context.RegisterPassOutputs({{context.DeclareTexture("DeadOut", ColorTarget("DeadOut"))}});
+}
+
+void ReadMissingWriteSceneColor(PassSetupContext& context) {
+    context.RegisterTextureRead(context.GetResourceHandle("Missing"));
+    context.RegisterPassOutputs({{PassSetupContext::kSceneColorHandle}});
+}
+
+void WriteExported(PassSetupContext& context) {
+    Handle exported = context.DeclareTexture("Exported", ColorTarget("Exported"));
+    context.RegisterPassOutputs({{exported}});
+    context.ExportTexture(exported);
+}
+
+int countedSetups = 0;
+
+void CountedWriteSceneColor(PassSetupContext& context) {
+    ++countedSetups;
+    WriteSceneColor(context);
+}
+
+void DeclareAndWriteA(PassSetupContext& context) {
+    context.RegisterPassOutputs({{context.DeclareTexture("A", ColorTarget("A"))}});
+}
+
+void OverwriteA(PassSetupContext& context) {
+    context.RegisterPassOutputs({{context.GetResourceHandle("A")}});
+}
+
+void AccumulateA(PassSetupContext& context) {
+    context.RegisterPassOutputs(
+        {{context.GetResourceHandle("A"), ColorAttachmentInfo{.loadOp = wgpu::LoadOp::Load}}});
+}
+
+void ReadAWriteSceneColor(PassSetupContext& context) {
+    context.RegisterTextureRead(context.GetResourceHandle("A"));
+    context.RegisterPassOutputs({{PassSetupContext::kSceneColorHandle}});
+}
+
+void ReadAWriteExported(PassSetupContext& context) {
+    context.RegisterTextureRead(context.GetResourceHandle("A"));
+    WriteExported(context);
+}
+
+void UpdateImportedBuffer(PassSetupContext& context) {
+    Handle imported = context.ImportBuffer("Imported");
+    context.RegisterStorageBuffer(imported, StorageAccess::ReadWrite);
+    context.ExportBuffer(imported);
+}
+
+void WriteImportedBuffer(PassSetupContext& context) {
+    Handle imported = context.ImportBuffer("Imported");
+    context.RegisterStorageBuffer(imported, StorageAccess::Write);
+    context.ExportBuffer(imported);
+}
+
+void ReadImportedBufferWriteSceneColor(PassSetupContext& context) {
+    context.RegisterStorageBuffer(context.ImportBuffer("Imported"), StorageAccess::Read);
+    context.RegisterPassOutputs({{PassSetupContext::kSceneColorHandle}});
+}
+}  // namespace
+
+class RenderGraphTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        device = Device::CreateHeadless(HeadlessSpec{.width = 64, .height = 64});
+        if (device == nullptr) {
+            GTEST_SKIP() << "No WebGPU adapter available";
+        }
+        assetManager = std::make_unique<AssetManager>(AssetManager::Create());
+        renderer = std::make_unique<SceneRenderer>(device.get(), assetManager.get(), &jobSystem,
+                                                   Application::GetGlobalLayouDesc());
+        vra = std::make_unique<TransientResourcePool>(device.get());
+        graph = std::make_unique<RenderGraph>(device.get());
+    }
+
+    template <void (*SetupFn)(PassSetupContext&)>
+    uint32_t Register(const std::string& name) {
+        return renderer->GetPassManager()->RegisterPass<ScriptedPass<SetupFn>>(name);
+    }
+
+    const CompiledGraph& Compile(std::vector<uint32_t> passes) {
+        return graph->Compile(passes, renderer->GetPassManager(), renderer->GetShaderManager(),
+                              *vra);
+    }
+
+    bool IsCompiled(std::vector<uint32_t> passes) const { return graph->IsCompiled(passes); }
+
+    static const SubResource& Resource(const CompiledGraph& compiled, const std::string& name) {
+        return compiled.subResources[compiled.subResourceMap.at(ToPropertyID(name))];
+    }
+
+    static uint32_t ReadVersion(const SubResource& resource, uint32_t passId) {
+        auto it = std::ranges::find(resource.readPassInfos, passId, &SubResource::ReadInfo::passId);
+        return it != resource.readPassInfos.end() ? it->version : 0;
+    }
+
+    static size_t Position(const CompiledGraph& compiled, uint32_t passId) {
+        return std::ranges::find(compiled.executionOrder, passId) -
+               compiled.executionOrder.begin();
+    }
+
+    static bool Contains(const std::vector<std::string>& names, const std::string& name) {
+        return std::ranges::find(names, name) != names.end();
+    }
+
+    util::JobSystem jobSystem{0};
+    std::unique_ptr<Device> device;
+    std::unique_ptr<AssetManager> assetManager;
+    std::unique_ptr<SceneRenderer> renderer;
+    std::unique_ptr<TransientResourcePool> vra;
+    std::unique_ptr<RenderGraph> graph;
+};
+
+TEST_F(RenderGraphTest, DeadBranchIsCulled) {
+    const uint32_t main = Register<WriteSceneColor>("Main");
+    const uint32_t producer = Register<WriteDead>("DeadProducer");
+    const uint32_t consumer = Register<ReadDeadWriteDeadOut>("DeadConsumer");
+
+    const CompiledGraph& compiled = Compile({producer, main, consumer});
+
+    EXPECT_EQ(compiled.executionOrder, std::vector<uint32_t>{main});
+    EXPECT_EQ(compiled.report.culledPasses, (std::vector<uint32_t>{producer, consumer}));
+    EXPECT_TRUE(Contains(compiled.report.culledResources, "Dead"));
+    EXPECT_TRUE(Contains(compiled.report.culledResources, "DeadOut"));
+    EXPECT_TRUE(compiled.report.missingResources.empty());
+    EXPECT_EQ(Resource(compiled, "Dead").actualResource, UINT32_MAX);
+    EXPECT_EQ(Resource(compiled, "DeadOut").actualResource, UINT32_MAX);
+    EXPECT_EQ(compiled.memoryStats.requestCount, 0u);
+}
+
+TEST_F(RenderGraphTest, ExportKeepsBranchAlive) {
+    const uint32_t main = Register<WriteSceneColor>("Main");
+    const uint32_t exporter = Register<WriteExported>("Exporter");
+
+    const CompiledGraph& compiled = Compile({main, exporter});
+
+    EXPECT_EQ(compiled.executionOrder, (std::vector<uint32_t>{main, exporter}));
+    EXPECT_TRUE(compiled.report.culledPasses.empty());
+    EXPECT_NE(Resource(compiled, "Exported").actualResource, UINT32_MAX);
+}
+
+TEST_F(RenderGraphTest, ReaderOfMissingResourceIsCulled) {
+    const uint32_t main = Register<WriteSceneColor>("Main");
+    const uint32_t reader = Register<ReadMissingWriteSceneColor>("Reader");
+
+    // Reader is the last SceneColor writer, but it can't run, so Main's output is presented.
+    const CompiledGraph& compiled = Compile({main, reader});
+
+    EXPECT_EQ(compiled.executionOrder, std::vector<uint32_t>{main});
+    EXPECT_EQ(compiled.report.culledPasses, std::vector<uint32_t>{reader});
+    EXPECT_TRUE(Contains(compiled.report.missingResources, "Missing"));
+}
+
+TEST_F(RenderGraphTest, WriteAfterWriteCreatesVersions) {
+    const uint32_t first = Register<DeclareAndWriteA>("First");
+    const uint32_t early = Register<ReadAWriteExported>("EarlyReader");
+    const uint32_t second = Register<OverwriteA>("Second");
+    const uint32_t late = Register<ReadAWriteSceneColor>("LateReader");
+
+    const CompiledGraph& compiled = Compile({first, early, second, late});
+    const SubResource& a = Resource(compiled, "A");
+
+    ASSERT_EQ(a.writePassInfos.size(), 2u);
+    EXPECT_EQ(a.writePassInfos[0].passId, first);
+    EXPECT_EQ(a.writePassInfos[1].passId, second);
+    EXPECT_FALSE(a.writePassInfos[1].preservesContents);
+    EXPECT_EQ(ReadVersion(a, early), 1u);
+    EXPECT_EQ(ReadVersion(a, late), 2u);
+
+    // The early reader has to sample version 1 before Second replaces it.
+    ASSERT_EQ(compiled.executionOrder.size(), 4u);
+    EXPECT_LT(Position(compiled, first), Position(compiled, early));
+    EXPECT_LT(Position(compiled, early), Position(compiled, second));
+    EXPECT_LT(Position(compiled, second), Position(compiled, late));
+}
+
+TEST_F(RenderGraphTest, OverwrittenVersionWithoutReadersIsCulled) {
+    const uint32_t first = Register<DeclareAndWriteA>("First");
+    const uint32_t second = Register<OverwriteA>("Second");
+    const uint32_t reader = Register<ReadAWriteSceneColor>("Reader");
+
+    const CompiledGraph& compiled = Compile({first, second, reader});
+
+    EXPECT_EQ(ReadVersion(Resource(compiled, "A"), reader), 2u);
+    EXPECT_EQ(compiled.executionOrder, (std::vector<uint32_t>{second, reader}));
+    EXPECT_EQ(compiled.report.culledPasses, std::vector<uint32_t>{first});
+}
+
+TEST_F(RenderGraphTest, PreservingWriteKeepsPreviousVersionAlive) {
+    const uint32_t first = Register<DeclareAndWriteA>("First");
+    const uint32_t accumulate = Register<AccumulateA>("Accumulate");
+    const uint32_t reader = Register<ReadAWriteSceneColor>("Reader");
+
+    const CompiledGraph& compiled = Compile({first, accumulate, reader});
+    const SubResource& a = Resource(compiled, "A");
+
+    // Accumulate loads version 1, so First stays alive although nobody samples it.
+    ASSERT_EQ(a.writePassInfos.size(), 2u);
+    EXPECT_TRUE(a.writePassInfos[1].preservesContents);
+    EXPECT_EQ(ReadVersion(a, reader), 2u);
+    EXPECT_TRUE(compiled.report.culledPasses.empty());
+    EXPECT_EQ(compiled.executionOrder, (std::vector<uint32_t>{first, accumulate, reader}));
+}
+
+TEST_F(RenderGraphTest, ExportedImportedBufferKeepsPassAlive) {
+    const uint32_t main = Register<WriteSceneColor>("Main");
+    const uint32_t updater = Register<UpdateImportedBuffer>("Updater");
+
+    // Nothing in the graph writes the buffer first, yet reading it doesn't cull Updater.
+    const CompiledGraph& compiled = Compile({updater, main});
+
+    EXPECT_EQ(compiled.executionOrder, (std::vector<uint32_t>{updater, main}));
+    EXPECT_TRUE(compiled.report.missingResources.empty());
+    EXPECT_EQ(Resource(compiled, "Imported").actualResource,
+              vra->GetExternalBufferHandle(ToPropertyID("Imported")));
+    EXPECT_EQ(compiled.memoryStats.requestCount, 0u);
+}
+
+TEST_F(RenderGraphTest, ReaderOfExternalContentsRunsBeforeFirstWriter) {
+    // Registered after the writer, but listed first, so it reads what the owner uploaded.
+    const uint32_t writer = Register<WriteImportedBuffer>("Writer");
+    const uint32_t reader = Register<ReadImportedBufferWriteSceneColor>("Reader");
+
+    const CompiledGraph& compiled = Compile({reader, writer});
+    const SubResource& imported = Resource(compiled, "Imported");
+
+    ASSERT_EQ(imported.writePassInfos.size(), 1u);
+    ASSERT_EQ(imported.readPassInfos.size(), 1u);
+    EXPECT_EQ(imported.readPassInfos[0].version, 0u);
+    EXPECT_TRUE(std::ranges::contains(compiled.passNodes[writer].orderPredecessorNodes, reader));
+    EXPECT_EQ(compiled.executionOrder, (std::vector<uint32_t>{reader, writer}));
+}
+
+TEST_F(RenderGraphTest, SamePassListIsCacheHit) {
+    const uint32_t main = Register<CountedWriteSceneColor>("Main");
+    countedSetups = 0;
+
+    EXPECT_FALSE(IsCompiled({main}));
+    const CompiledGraph& first = Compile({main});
+    EXPECT_TRUE(IsCompiled({main}));
+    const CompiledGraph& second = Compile({main});
+
+    EXPECT_EQ(&first, &second);
+    EXPECT_EQ(countedSetups, 1);
+}
+
+TEST_F(RenderGraphTest, InvalidatedSetupMissesCache) {
+    const uint32_t main = Register<CountedWriteSceneColor>("Main");
+    countedSetups = 0;
+    const CompiledGraph& first = Compile({main});
+
+    graph->InvalidatePass(main);
+    EXPECT_FALSE(IsCompiled({main}));
+    const CompiledGraph& second = Compile({main});
+
+    EXPECT_NE(&first, &second);
+    EXPECT_EQ(countedSetups, 2);
+    // The graph from the old setup is only unreachable, so references to it stay valid.
+    EXPECT_EQ(first.executionOrder, second.executionOrder);
+}
+
+TEST_F(RenderGraphTest, LeastRecentlyUsedGraphIsEvicted) {
+    std::vector<uint32_t> passes;
+    for (size_t i = 0; i <= RenderGraph::kMaxCompiledGraphs; ++i) {
+        passes.push_back(Register<WriteSceneColor>("Main" + std::to_string(i)));
+    }
+    for (size_t i = 0; i < RenderGraph::kMaxCompiledGraphs; ++i) {
+        Compile({passes[i]});
+    }
+    // Touching the oldest graph leaves the second one least recently used.
+    const CompiledGraph& touched = Compile({passes[0]});
+    Compile({passes.back()});
+
+    for (size_t i = 0; i < passes.size(); ++i) {
+        EXPECT_EQ(IsCompiled({passes[i]}), i != 1) << "pass list " << i;
+    }
+    EXPECT_EQ(&Compile({passes[0]}), &touched);
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "render/RenderIntentSort.h"
+
+// RenderIntentSorter against std::stable_sort. transformIndex carries each intent's original
+// position, so comparing it also checks that equal keys keep their order.
+
+namespace {
+using namespace core::render;
+
+std::vector<RenderIntent> MakeIntents(std::vector<uint64_t> keys) {
+    std::vector<RenderIntent> intents(keys.size());
+    for (uint32_t i = 0; i < keys.size(); ++i) {
+        intents[i].transformIndex = i;
+        intents[i].sortKey = keys[i];
+    }
+    return intents;
+}
+
+std::vector<uint64_t> RandomKeys(size_t count, uint64_t mask, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<uint64_t> keys(count);
+    for (uint64_t& key : keys) {
+        key = rng() & mask;
+    }
+    return keys;
+}
+
+void ExpectMatchesStableSort(RenderIntentSorter& sorter, std::vector<RenderIntent> intents) {
+    std::vector<RenderIntent> expected = intents;
+    std::ranges::stable_sort(expected, {}, &RenderIntent::sortKey);
+
+    sorter.Sort(intents);
+
+    ASSERT_EQ(intents.size(), expected.size());
+    for (size_t i = 0; i < intents.size(); ++i) {
+        ASSERT_EQ(intents[i].sortKey, expected[i].sortKey) << "at " << i;
+        ASSERT_EQ(intents[i].transformIndex, expected[i].transformIndex) << "at " << i;
+    }
+}
+}  // namespace
+
+TEST(RenderIntentSortTest, EmptyAndSingle) {
+    RenderIntentSorter sorter;
+    ExpectMatchesStableSort(sorter, {});
+    ExpectMatchesStableSort(sorter, MakeIntents({42}));
+}
+
+TEST(RenderIntentSortTest, AllKeysEqual) {
+    RenderIntentSorter sorter;
+    const std::vector<uint64_t> keys(1000, 0x1234'5678'9ABC'DEF0);
+    ExpectMatchesStableSort(sorter, MakeIntents(keys));
+}
+
+TEST(RenderIntentSortTest, AlreadySortedAndReversed) {
+    std::vector<uint64_t> keys(4096);
+    for (uint64_t i = 0; i < keys.size(); ++i) {
+        keys[i] = i * 0x0101'0101'0101ull;
+    }
+    RenderIntentSorter sorter;
+    ExpectMatchesStableSort(sorter, MakeIntents(keys));
+    std::ranges::reverse(keys);
+    ExpectMatchesStableSort(sorter, MakeIntents(keys));
+}
+
+TEST(RenderIntentSortTest, RandomFullWidthKeys) {
+    RenderIntentSorter sorter;
+    for (size_t count : {2, 3, 255, 256, 257, 10000, 100000}) {
+        ExpectMatchesStableSort(sorter, MakeIntents(RandomKeys(count, ~0ull, count)));
+    }
+}
+
+TEST(RenderIntentSortTest, FewDistinctKeysStayStable) {
+    RenderIntentSorter sorter;
+    // Eight distinct values, so every bucket holds long runs of equal keys.
+    ExpectMatchesStableSort(sorter, MakeIntents(RandomKeys(50000, 0x7ull << 44, 1)));
+    ExpectMatchesStableSort(sorter, MakeIntents(RandomKeys(50000, 0x7, 2)));
+}
+
+TEST(RenderIntentSortTest, OpaqueKeyLayout) {
+    // Only some byte positions vary, which exercises skipped passes.
+    std::mt19937_64 rng(7);
+    std::vector<uint64_t> keys(20000);
+    for (uint64_t& key : keys) {
+        key = RenderIntent::CreateOpaqueKey(rng() % 4, rng() % 16, rng() % 64, 0);
+    }
+    RenderIntentSorter sorter;
+    ExpectMatchesStableSort(sorter, MakeIntents(keys));
+}
+
+TEST(RenderIntentSortTest, ReusedSorterShrinksAndGrows) {
+    RenderIntentSorter sorter;
+    for (size_t count : {50000, 10, 0, 1, 70000, 300}) {
+        ExpectMatchesStableSort(sorter, MakeIntents(RandomKeys(count, 0xFFFF'FFFF, count + 3)));
+    }
+}
+
+TEST(RenderIntentSortTest, CallerBuffersAreKeptAcrossSizes) {
+    // Two queues of different sizes sorted alternately, like two passes sharing a sorter each
+    // frame. Sorting permutes in place, so neither queue is handed the other's buffer.
+    RenderIntentSorter sorter;
+    std::vector<RenderIntent> large = MakeIntents(RandomKeys(5000, ~0ull, 11));
+    std::vector<RenderIntent> small = MakeIntents(RandomKeys(40, ~0ull, 12));
+    const RenderIntent* largeData = large.data();
+    const RenderIntent* smallData = small.data();
+    const size_t largeCapacity = large.capacity();
+    const size_t smallCapacity = small.capacity();
+
+    for (uint64_t frame = 0; frame < 4; ++frame) {
+        for (std::vector<RenderIntent>* intents : {&large, &small}) {
+            const std::vector<uint64_t> keys = RandomKeys(intents->size(), ~0ull, frame);
+            for (size_t i = 0; i < intents->size(); ++i) {
+                (*intents)[i].sortKey = keys[i];
+            }
+            sorter.Sort(*intents);
+            ASSERT_TRUE(std::ranges::is_sorted(*intents, {}, &RenderIntent::sortKey));
+        }
+        EXPECT_EQ(large.data(), largeData);
+        EXPECT_EQ(small.data(), smallData);
+        EXPECT_EQ(large.capacity(), largeCapacity);
+        EXPECT_EQ(small.capacity(), smallCapacity);
+    }
+}
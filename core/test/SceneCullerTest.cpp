@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include <format>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Application.h"
+#include "Scene.h"
+#include "bench/GeneratedMesh.h"
+#include "import/GLTFImporter.h"
+#include "import/ShdrImporter.h"
+#include "render/SceneRenderer.h"
+
+// SceneCuller::ExtractRenderQueueParallel against ExtractRenderQueue on a headless device with
+// the forward pass shader baked next to the test. The scene spans several chunks, and the first
+// parallel extraction starts without pipelines, so every chunk is redone on the calling thread.
+
+namespace {
+using namespace core;
+using namespace core::render;
+
+constexpr uint32_t kMeshCount = 4;
+constexpr uint32_t kMaterialCount = 6;
+constexpr uint32_t kModelCount = SceneCuller::kUnitsPerChunk * 2 + 100;
+
+void ExpectSameQueue(const RenderQueue& actual, const RenderQueue& expected, uint32_t passId) {
+    EXPECT_EQ(actual.culledRenderUnits, expected.culledRenderUnits);
+    const std::vector<RenderIntent>& a = actual.renderIntents[passId];
+    const std::vector<RenderIntent>& e = expected.renderIntents[passId];
+    ASSERT_EQ(a.size(), e.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        ASSERT_EQ(a[i].transformIndex, e[i].transformIndex) << "at " << i;
+        ASSERT_EQ(a[i].sortKey, e[i].sortKey) << "at " << i;
+        ASSERT_EQ(a[i].pipeline.Get(), e[i].pipeline.Get()) << "at " << i;
+        ASSERT_EQ(a[i].bindGroup.Get(), e[i].bindGroup.Get()) << "at " << i;
+        ASSERT_EQ(a[i].vertexBuffer.Get(), e[i].vertexBuffer.Get()) << "at " << i;
+        ASSERT_EQ(a[i].subMeshInfo.indexStart, e[i].subMeshInfo.indexStart) << "at " << i;
+        ASSERT_EQ(a[i].subMeshInfo.indexCount, e[i].subMeshInfo.indexCount) << "at " << i;
+    }
+}
+}  // namespace
+
+class SceneCullerTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        device = Device::CreateHeadless(HeadlessSpec{.width = 64, .height = 64});
+        if (device == nullptr) {
+            GTEST_SKIP() << "No WebGPU adapter available";
+        }
+        assetManager = std::make_unique<AssetManager>(AssetManager::Create());
+        renderer = std::make_unique<SceneRenderer>(device.get(), assetManager.get(), &jobSystem,
+                                                   Application::GetGlobalLayouDesc());
+
+        auto shaderOrError = importer::ShdrImporter::ShdrImport(CORE_TEST_FORWARD_SHADER);
+        ASSERT_TRUE(shaderOrError.has_value());
+        renderer->GetShaderManager()->LoadShader(std::move(shaderOrError.value()));
+
+        std::vector<Handle> meshes;
+        for (uint32_t i = 0; i < kMeshCount; ++i) {
+            const tinygltf::Model gltf = bench::MakeGridModel(2 + i);
+            auto meshOrError = importer::GLTFImporter::ImportMesh(gltf, gltf.meshes[0]);
+            ASSERT_TRUE(meshOrError.has_value());
+            meshes.push_back(renderer->GetMeshManager()->LoadMesh(importer::MeshResult{
+                std::move(meshOrError.value()), AssetPath{std::format("test://mesh/{}", i)}}));
+        }
+        // Texture paths that do not resolve fall back to the default texture.
+        std::vector<Handle> materials;
+        const tinygltf::Model emptyGltf;
+        for (uint32_t i = 0; i < kMaterialCount; ++i) {
+            auto materialOrError =
+                importer::GLTFImporter::ImportMaterial(emptyGltf, tinygltf::Material{});
+            ASSERT_TRUE(materialOrError.has_value());
+            MaterialAssetFormat& material = materialOrError.value();
+            for (const char* slot : {"baseColorTexture", "metallicRoughnessTexture",
+                                     "normalTexture", "occlusionTexture", "emissiveTexture"}) {
+                material.SetTexture(slot, AssetPath{"test://texture/missing"});
+            }
+            materials.push_back(renderer->GetMaterialManager()->LoadMaterial(
+                importer::MaterialResult{std::move(material),
+                                         AssetPath{std::format("test://material/{}", i)}}));
+        }
+        for (Handle material : materials) {
+            renderer->GetBindGroupManager()->UpdateBindGroup(material);
+        }
+        renderer->GetMaterialManager()->ClearDirties();
+
+        passIds = {renderer->GetPassManager()->GetPassID("ForwardRenderPass")};
+        renderer->Setup(passIds);
+        scene = MakeScene(meshes, materials);
+    }
+
+    // Models scattered around a camera looking down -Z, so some of them are culled.
+    Scene MakeScene(const std::vector<Handle>& meshes, const std::vector<Handle>& materials) {
+        Scene newScene;
+        const glm::mat4x4 view = glm::lookAtRH(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f),
+                                               glm::vec3(0.0f, 1.0f, 0.0f));
+        const glm::mat4x4 proj = glm::perspectiveRH(glm::radians(60.0f), 1.0f, 0.1f, 200.0f);
+        newScene.cameraData = CameraUniformData{
+            .view = view,
+            .proj = proj,
+            .viewProj = proj * view,
+            .invViewProj = glm::inverse(proj * view),
+            .position = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f),
+        };
+
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<float> coordinate(-50.0f, 50.0f);
+        for (uint32_t i = 0; i < kModelCount; ++i) {
+            Model model;
+            model.renderUnits.push_back(RenderUnit{
+                .meshHandle = meshes[rng() % meshes.size()],
+                .materialHandle = materials[rng() % materials.size()],
+            });
+            Handle modelHandle = assetManager->StoreModel(std::move(model));
+            const glm::vec3 position(coordinate(rng), coordinate(rng), coordinate(rng));
+            newScene.AddModel(assetManager->GetModel(modelHandle),
+                              glm::translate(glm::mat4x4(1.0f), position));
+        }
+        return newScene;
+    }
+
+    void ExtractSerial(RenderQueue& queue) {
+        SceneCuller::ExtractRenderQueue(scene, passIds, assetManager.get(),
+                                        renderer->GetShaderManager(),
+                                        renderer->GetPipelineManager(),
+                                        renderer->GetBindGroupManager(),
+                                        renderer->GetPassTargetStates(), queue);
+    }
+
+    void ExtractParallel(RenderQueue& queue, bool frustumCulling = true) {
+        SceneCuller::ExtractRenderQueueParallel(
+            scene, passIds, assetManager.get(), renderer->GetShaderManager(),
+            renderer->GetPipelineManager(), renderer->GetBindGroupManager(),
+            renderer->GetPassTargetStates(), extractJobs, scratch, queue, frustumCulling);
+    }
+
+    util::JobSystem jobSystem{0};
+    util::JobSystem extractJobs{3};
+    std::unique_ptr<Device> device;
+    std::unique_ptr<AssetManager> assetManager;
+    std::unique_ptr<SceneRenderer> renderer;
+    std::vector<uint32_t> passIds;
+    Scene scene;
+    SceneCuller::ExtractScratch scratch;
+};
+
+TEST_F(SceneCullerTest, ParallelMatchesSerial) {
+    PipelineManager* pipelines = renderer->GetPipelineManager();
+    const uint64_t pipelinesBefore = pipelines->GetCreatedPipelineCount();
+
+    // Workers only find pipelines, so the first extraction creates them in the serial redo.
+    RenderQueue parallel;
+    ExtractParallel(parallel);
+    const uint64_t pipelinesCreated = pipelines->GetCreatedPipelineCount();
+    EXPECT_GT(pipelinesCreated, pipelinesBefore);
+
+    RenderQueue serial;
+    ExtractSerial(serial);
+    EXPECT_GT(serial.culledRenderUnits, 0u);
+    EXPECT_LT(serial.culledRenderUnits, kModelCount);
+    EXPECT_EQ(serial.renderIntents[passIds[0]].size() + serial.culledRenderUnits, kModelCount);
+    ExpectSameQueue(parallel, serial, passIds[0]);
+
+    // With every pipeline cached, no chunk is redone and the scratch buffers are reused.
+    RenderQueue again;
+    ExtractParallel(again);
+    ExpectSameQueue(again, serial, passIds[0]);
+    EXPECT_EQ(pipelines->GetCreatedPipelineCount(), pipelinesCreated);
+}
+
+TEST_F(SceneCullerTest, ParallelWithoutCullingExtractsEveryUnit) {
+    RenderQueue queue;
+    ExtractParallel(queue, false);
+
+    EXPECT_EQ(queue.culledRenderUnits, 0u);
+    const std::vector<RenderIntent>& intents = queue.renderIntents[passIds[0]];
+    ASSERT_EQ(intents.size(), kModelCount);
+    for (uint32_t i = 0; i < kModelCount; ++i) {
+        ASSERT_EQ(intents[i].transformIndex, i);
+    }
+}
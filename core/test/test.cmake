@@ -1 +0,0 @@
-add_executable(core_test "ShaderAssetLoad.cpp")
\ No newline at end of file
@@ -0,0 +1,42 @@
+#include <format>
+#include <fstream>
+
+#include "ChromeTrace.h"
+
+namespace {
+std::string EscapeJson(std::string_view text) {
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped.push_back('\\');
+        }
+        escaped.push_back(c);
+    }
+    return escaped;
+}
+}  // namespace
+
+std::expected<void, core::Error> core::util::WriteChromeTrace(const std::filesystem::path& filepath,
+                                                              std::span<const TraceEvent> events) {
+    std::ofstream file(filepath, std::ios::out | std::ios::trunc);
+    if (!file) {
+        return std::unexpected(Error::IO(std::format("Failed to open: {}.", filepath.string())));
+    }
+
+    file << "{\"traceEvents\":[";
+    for (size_t i = 0; i < events.size(); ++i) {
+        const TraceEvent& event = events[i];
+        file << std::format(
+            "{}\n{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},"
+            "\"pid\":{},\"tid\":{}}}",
+            i == 0 ? "" : ",", EscapeJson(event.name), EscapeJson(event.category), event.startUs,
+            event.durationUs, event.processId, event.threadId);
+    }
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    if (!file) {
+        return std::unexpected(Error::IO(std::format("Failed to write: {}.", filepath.string())));
+    }
+    return {};
+}
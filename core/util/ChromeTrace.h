@@ -0,0 +1,25 @@
+#pragma once
+#include <expected>
+#include <filesystem>
+#include <span>
+#include <string>
+
+#include "Common.h"
+
+namespace core::util {
+
+// A complete ("ph":"X") event of the Chrome trace event format, viewable in chrome://tracing or
+// Perfetto.
+struct TraceEvent {
+    std::string name;
+    std::string category;
+    double startUs = 0.0;
+    double durationUs = 0.0;
+    uint32_t processId = 0;
+    uint32_t threadId = 0;
+};
+
+std::expected<void, Error> WriteChromeTrace(const std::filesystem::path& filepath,
+                                            std::span<const TraceEvent> events);
+
+}  // namespace core::util
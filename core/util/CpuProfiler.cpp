@@ -0,0 +1,148 @@
+#include "CpuProfiler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+namespace {
+using core::util::CpuProfiler;
+
+// Slots are atomics so a capture can read a ring while its thread keeps writing; torn slots are
+// detected through the head index and dropped.
+struct ZoneSlot {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<uint64_t> startNs{0};
+    std::atomic<uint64_t> endNs{0};
+};
+
+struct ThreadRing {
+    uint32_t threadId = 0;
+    std::atomic<uint64_t> head{0};
+    std::unique_ptr<ZoneSlot[]> slots =
+        std::make_unique<ZoneSlot[]>(CpuProfiler::kZonesPerThread);
+};
+
+struct ProfilerState {
+    std::mutex mutex;
+    // Rings are shared so zones of threads that already exited can still be captured.
+    std::vector<std::shared_ptr<ThreadRing>> rings;
+
+    uint64_t captureStartNs = 0;
+    std::vector<core::util::TraceEvent> captured;
+};
+
+ProfilerState& GetState() {
+    static ProfilerState state;
+    return state;
+}
+
+ThreadRing& GetThreadRing() {
+    thread_local std::shared_ptr<ThreadRing> ring = [] {
+        auto newRing = std::make_shared<ThreadRing>();
+        ProfilerState& state = GetState();
+        std::lock_guard lock(state.mutex);
+        newRing->threadId = static_cast<uint32_t>(state.rings.size());
+        state.rings.push_back(newRing);
+        return newRing;
+    }();
+    return *ring;
+}
+}  // namespace
+
+uint64_t core::util::CpuProfiler::Now() {
+    static const auto origin = std::chrono::steady_clock::now();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now() - origin)
+                                     .count());
+}
+
+void core::util::CpuProfiler::Record(const char* name, uint64_t startNs, uint64_t endNs) {
+    ThreadRing& ring = GetThreadRing();
+    const uint64_t head = ring.head.load(std::memory_order_relaxed);
+    ZoneSlot& slot = ring.slots[head % kZonesPerThread];
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.startNs.store(startNs, std::memory_order_relaxed);
+    slot.endNs.store(endNs, std::memory_order_relaxed);
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+std::vector<core::util::TraceEvent> core::util::CpuProfiler::CollectEvents(uint64_t sinceNs) {
+    ProfilerState& state = GetState();
+    std::vector<std::shared_ptr<ThreadRing>> rings;
+    {
+        std::lock_guard lock(state.mutex);
+        rings = state.rings;
+    }
+
+    struct Zone {
+        const char* name;
+        uint64_t startNs;
+        uint64_t endNs;
+    };
+    std::vector<Zone> zones;
+    std::vector<TraceEvent> events;
+    for (const auto& ring : rings) {
+        const uint64_t head = ring->head.load(std::memory_order_acquire);
+        const uint64_t first = head > kZonesPerThread ? head - kZonesPerThread : 0;
+        zones.clear();
+        for (uint64_t i = first; i < head; ++i) {
+            const ZoneSlot& slot = ring->slots[i % kZonesPerThread];
+            zones.push_back(Zone{
+                .name = slot.name.load(std::memory_order_relaxed),
+                .startNs = slot.startNs.load(std::memory_order_relaxed),
+                .endNs = slot.endNs.load(std::memory_order_relaxed),
+            });
+        }
+
+        // The thread may have lapped the ring while it was read; skip every slot it could have
+        // overwritten, including the one it may be writing right now. The fence keeps the slot
+        // reads above from being reordered after the second head load.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t newHead = ring->head.load(std::memory_order_acquire);
+        const uint64_t firstValid = newHead >= kZonesPerThread ? newHead - kZonesPerThread + 1 : 0;
+        const size_t torn = static_cast<size_t>(std::clamp(firstValid, first, head) - first);
+
+        for (size_t i = torn; i < zones.size(); ++i) {
+            const Zone& zone = zones[i];
+            if (zone.endNs < sinceNs || zone.endNs < zone.startNs) {
+                continue;
+            }
+            events.push_back(TraceEvent{
+                .name = zone.name,
+                .category = "cpu",
+                .startUs = static_cast<double>(zone.startNs) * 1e-3,
+                .durationUs = static_cast<double>(zone.endNs - zone.startNs) * 1e-3,
+                .threadId = ring->threadId,
+            });
+        }
+    }
+    return events;
+}
+
+void core::util::CpuProfiler::BeginCapture() {
+    ProfilerState& state = GetState();
+    std::lock_guard lock(state.mutex);
+    state.captureStartNs = Now();
+    state.captured.clear();
+}
+
+void core::util::CpuProfiler::EndCapture() {
+    ProfilerState& state = GetState();
+    uint64_t captureStartNs = 0;
+    {
+        std::lock_guard lock(state.mutex);
+        captureStartNs = state.captureStartNs;
+    }
+    std::vector<TraceEvent> events = CollectEvents(captureStartNs);
+
+    std::lock_guard lock(state.mutex);
+    state.captured = std::move(events);
+}
+
+std::expected<void, core::Error> core::util::CpuProfiler::WriteChromeTrace(
+    const std::filesystem::path& filepath) {
+    ProfilerState& state = GetState();
+    std::lock_guard lock(state.mutex);
+    return util::WriteChromeTrace(filepath, state.captured);
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <expected>
+#include <filesystem>
+#include <vector>
+
+#include "Common.h"
+#include "util/ChromeTrace.h"
+
+namespace core::util {
+
+// Records named CPU zones into a fixed-size ring buffer per thread. Recording a zone costs two
+// clock reads and a handful of stores; nothing is allocated or locked after a thread's first
+// zone. The rings hold the most recent kZonesPerThread zones of every thread, so a capture can
+// only look back that far; once a ring has wrapped, its oldest slot is not collected since the
+// thread may be overwriting it. Zone names must outlive the profiler (string literals).
+class CpuProfiler {
+  public:
+    static constexpr size_t kZonesPerThread = 8192;
+
+    // Nanoseconds since the first call, on the clock zones are stamped with.
+    static uint64_t Now();
+    static void Record(const char* name, uint64_t startNs, uint64_t endNs);
+
+    // Zones that end between BeginCapture and EndCapture are kept for WriteChromeTrace.
+    static void BeginCapture();
+    static void EndCapture();
+    static std::expected<void, Error> WriteChromeTrace(const std::filesystem::path& filepath);
+
+    // Every zone still held by the ring buffers that ended at or after sinceNs.
+    static std::vector<TraceEvent> CollectEvents(uint64_t sinceNs = 0);
+};
+
+class CpuZoneScope {
+  public:
+    explicit CpuZoneScope(const char* name) : m_name(name), m_startNs(CpuProfiler::Now()) {}
+    ~CpuZoneScope() { CpuProfiler::Record(m_name, m_startNs, CpuProfiler::Now()); }
+
+    CpuZoneScope(const CpuZoneScope&) = delete;
+    CpuZoneScope& operator=(const CpuZoneScope&) = delete;
+
+  private:
+    const char* m_name;
+    uint64_t m_startNs;
+};
+
+}  // namespace core::util
+
+// Zones nest by scope. Without ENGINE_PROFILING the macros compile to nothing.
+#if defined(ENGINE_PROFILING)
+#define ENGINE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define ENGINE_PROFILE_CONCAT(a, b) ENGINE_PROFILE_CONCAT_IMPL(a, b)
+#define ENGINE_PROFILE_SCOPE(name) \
+    const ::core::util::CpuZoneScope ENGINE_PROFILE_CONCAT(profileZone, __LINE__)(name)
+#else
+#define ENGINE_PROFILE_SCOPE(name) static_cast<void>(0)
+#endif
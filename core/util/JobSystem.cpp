@@ -0,0 +1,273 @@
+#include "JobSystem.h"
+#include <algorithm>
+#include <cassert>
+#include <optional>
+
+namespace {
+// Deque of the calling thread, if it is a worker of t_jobSystem.
+thread_local const core::util::JobSystem* t_jobSystem = nullptr;
+thread_local uint32_t t_queueIndex = 0;
+}  // namespace
+
+core::util::TaskGraph::TaskId core::util::TaskGraph::AddTask(std::function<void()> fn) {
+    m_tasks.push_back(Task{.fn = std::move(fn), .successors = {}});
+    return static_cast<TaskId>(m_tasks.size() - 1);
+}
+
+void core::util::TaskGraph::AddDependency(TaskId before, TaskId after) {
+    assert(before < m_tasks.size() && after < m_tasks.size() && before != after &&
+           "Invalid task dependency");
+    m_tasks[before].successors.push_back(after);
+    ++m_tasks[after].dependencyCount;
+}
+
+void core::util::TaskGraph::Clear() {
+    m_tasks.clear();
+}
+
+core::util::JobSystem::JobSystem(uint32_t workerCount) {
+    m_queues.reserve(workerCount + 1);
+    for (uint32_t i = 0; i <= workerCount; ++i) {
+        m_queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    m_workers.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; ++i) {
+        m_workers.emplace_back([this, i] { WorkerLoop(i + 1); });
+    }
+}
+
+core::util::JobSystem::~JobSystem() {
+    {
+        std::lock_guard lock(m_sleepMutex);
+        m_stopping = true;
+    }
+    m_wakeWorkers.notify_all();
+    m_workers.clear();  // jthread joins on destruction
+}
+
+void core::util::JobSystem::WorkerLoop(uint32_t queueIndex) {
+    t_jobSystem = this;
+    t_queueIndex = queueIndex;
+    while (true) {
+        if (TryRunJob(queueIndex) || TryRunBackgroundJob()) {
+            continue;
+        }
+        std::unique_lock lock(m_sleepMutex);
+        m_sleepingWorkers.fetch_add(1);
+        m_wakeWorkers.wait(lock, [this] {
+            return m_stopping || m_queuedJobs.load() > 0 || m_queuedBackgroundJobs.load() > 0;
+        });
+        m_sleepingWorkers.fetch_sub(1);
+        if (m_stopping) {
+            return;
+        }
+    }
+}
+
+uint32_t core::util::JobSystem::GetQueueIndex() const {
+    return t_jobSystem == this ? t_queueIndex : 0;
+}
+
+void core::util::JobSystem::Push(Job job) {
+    WorkerQueue& queue = *m_queues[GetQueueIndex()];
+    {
+        std::lock_guard lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+    m_queuedJobs.fetch_add(1);
+    WakeWorkers(1);
+}
+
+void core::util::JobSystem::WakeWorkers(uint32_t jobCount) {
+    // The job count was raised before this load, and a worker registers as sleeping before it
+    // checks m_queuedJobs, so one of the two always sees the other.
+    if (m_sleepingWorkers.load() == 0) {
+        return;
+    }
+    {
+        std::lock_guard lock(m_sleepMutex);
+    }
+    if (jobCount == 1) {
+        m_wakeWorkers.notify_one();
+    } else {
+        m_wakeWorkers.notify_all();
+    }
+}
+
+bool core::util::JobSystem::TryRunJob(uint32_t queueIndex) {
+    if (m_queuedJobs.load(std::memory_order_relaxed) == 0) {
+        return false;
+    }
+
+    std::optional<Job> job;
+    {
+        WorkerQueue& own = *m_queues[queueIndex];
+        std::lock_guard lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+        }
+    }
+    const auto queueCount = static_cast<uint32_t>(m_queues.size());
+    for (uint32_t i = 1; !job.has_value() && i < queueCount; ++i) {
+        WorkerQueue& victim = *m_queues[(queueIndex + i) % queueCount];
+        std::lock_guard lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+        }
+    }
+    if (!job.has_value()) {
+        return false;
+    }
+    m_queuedJobs.fetch_sub(1);
+    RunJob(*job);
+    return true;
+}
+
+bool core::util::JobSystem::TryRunBackgroundJob() {
+    if (m_queuedBackgroundJobs.load(std::memory_order_relaxed) == 0) {
+        return false;
+    }
+    std::optional<Job> job;
+    {
+        std::lock_guard lock(m_backgroundQueue.mutex);
+        if (m_backgroundQueue.jobs.empty()) {
+            return false;
+        }
+        job = std::move(m_backgroundQueue.jobs.front());
+        m_backgroundQueue.jobs.pop_front();
+    }
+    m_queuedBackgroundJobs.fetch_sub(1);
+    RunJob(*job);
+    return true;
+}
+
+void core::util::JobSystem::RunJob(Job& job) {
+    job.fn();
+    if (job.counter != nullptr) {
+        job.counter->m_pending.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+void core::util::JobSystem::Submit(std::function<void()> fn, JobCounter* counter) {
+    if (counter != nullptr) {
+        counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    Push(Job{.fn = std::move(fn), .counter = counter});
+}
+
+void core::util::JobSystem::Wait(const JobCounter& counter) {
+    const uint32_t queueIndex = GetQueueIndex();
+    while (!counter.IsDone()) {
+        if (!TryRunJob(queueIndex)) {
+            // The remaining jobs are running on other threads.
+            std::this_thread::yield();
+        }
+    }
+}
+
+void core::util::JobSystem::SubmitBackground(std::function<void()> fn, JobCounter* counter) {
+    if (m_workers.empty()) {
+        fn();
+        return;
+    }
+    if (counter != nullptr) {
+        counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    {
+        std::lock_guard lock(m_backgroundQueue.mutex);
+        m_backgroundQueue.jobs.push_back(Job{.fn = std::move(fn), .counter = counter});
+    }
+    m_queuedBackgroundJobs.fetch_add(1);
+    WakeWorkers(1);
+}
+
+bool core::util::JobSystem::RunPendingJob() {
+    return TryRunJob(GetQueueIndex()) || TryRunBackgroundJob();
+}
+
+void core::util::JobSystem::ParallelFor(uint32_t count,
+                                        const std::function<void(uint32_t)>& fn,
+                                        uint32_t grainSize) {
+    grainSize = std::max(grainSize, 1u);
+    const uint32_t maxBatches = (GetWorkerCount() + 1) * kBatchesPerThread;
+    const uint32_t batchCount = std::min((count + grainSize - 1) / grainSize, maxBatches);
+    if (m_workers.empty() || batchCount <= 1) {
+        for (uint32_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    const uint32_t batchSize = (count + batchCount - 1) / batchCount;
+    const uint32_t jobCount = (count + batchSize - 1) / batchSize;
+    JobCounter counter;
+    counter.m_pending.store(jobCount, std::memory_order_relaxed);
+    {
+        // All batches go in at once, so workers are woken only once per loop.
+        WorkerQueue& queue = *m_queues[GetQueueIndex()];
+        std::lock_guard lock(queue.mutex);
+        for (uint32_t begin = 0; begin < count; begin += batchSize) {
+            const uint32_t end = std::min(count, begin + batchSize);
+            queue.jobs.push_back(Job{
+                .fn =
+                    [&fn, begin, end] {
+                        for (uint32_t i = begin; i < end; ++i) {
+                            fn(i);
+                        }
+                    },
+                .counter = &counter,
+            });
+        }
+    }
+    m_queuedJobs.fetch_add(jobCount);
+    WakeWorkers(jobCount);
+
+    Wait(counter);
+}
+
+void core::util::JobSystem::RunAsync(TaskGraph& graph, JobCounter& counter) {
+    const uint32_t taskCount = graph.GetTaskCount();
+    if (taskCount == 0) {
+        return;
+    }
+    graph.m_pendingDependencies = std::make_unique<std::atomic<uint32_t>[]>(taskCount);
+    for (uint32_t i = 0; i < taskCount; ++i) {
+        graph.m_pendingDependencies[i].store(graph.m_tasks[i].dependencyCount,
+                                             std::memory_order_relaxed);
+    }
+
+    // Every task is counted up front, so counter cannot reach zero while successors of a
+    // finished task are still to be queued.
+    counter.m_pending.fetch_add(taskCount, std::memory_order_relaxed);
+    bool hasRoot = false;
+    for (uint32_t i = 0; i < taskCount; ++i) {
+        if (graph.m_tasks[i].dependencyCount == 0) {
+            hasRoot = true;
+            Push(Job{
+                .fn = [this, &graph, i, &counter] { RunTask(graph, i, &counter); },
+                .counter = &counter,
+            });
+        }
+    }
+    assert(hasRoot && "TaskGraph dependencies form a cycle");
+}
+
+void core::util::JobSystem::Run(TaskGraph& graph) {
+    JobCounter counter;
+    RunAsync(graph, counter);
+    Wait(counter);
+}
+
+void core::util::JobSystem::RunTask(TaskGraph& graph, TaskGraph::TaskId task, JobCounter* counter) {
+    graph.m_tasks[task].fn();
+    for (TaskGraph::TaskId successor : graph.m_tasks[task].successors) {
+        if (graph.m_pendingDependencies[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            Push(Job{
+                .fn = [this, &graph, successor, counter] { RunTask(graph, successor, counter); },
+                .counter = counter,
+            });
+        }
+    }
+}
@@ -0,0 +1,131 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace core::util {
+
+// Counts unfinished jobs. Every job submitted with a counter increments it and decrements it
+// once the job returned.
+class JobCounter {
+  public:
+    JobCounter() = default;
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool IsDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+
+  private:
+    friend class JobSystem;
+    std::atomic<uint32_t> m_pending = 0;
+};
+
+// Tasks with dependencies between them, run as a whole by JobSystem::Run. A task starts once
+// every task it depends on finished. A graph can be run again once its last run finished.
+class TaskGraph {
+  public:
+    using TaskId = uint32_t;
+
+    TaskId AddTask(std::function<void()> fn);
+    // after starts only once before finished. Dependencies must not form a cycle.
+    void AddDependency(TaskId before, TaskId after);
+    uint32_t GetTaskCount() const { return static_cast<uint32_t>(m_tasks.size()); }
+    void Clear();
+
+  private:
+    friend class JobSystem;
+    struct Task {
+        std::function<void()> fn;
+        std::vector<TaskId> successors;
+        uint32_t dependencyCount = 0;
+    };
+    std::vector<Task> m_tasks;
+    // Dependencies each task still waits on during a run.
+    std::unique_ptr<std::atomic<uint32_t>[]> m_pendingDependencies;
+};
+
+// Work-stealing scheduler shared by everything in the engine that runs in parallel. Every
+// worker owns a deque: it pushes and pops its own jobs at the back, so nested jobs run depth
+// first on a warm cache, and idle workers steal the oldest jobs from the front of the others.
+// Threads that are not workers, such as the main thread, share one more deque.
+//
+// Waiting never blocks: Wait runs queued jobs on the calling thread until its counter drops to
+// zero, so the main thread takes part in its own loops, jobs may wait on nested jobs, and a
+// system without workers runs everything on the waiting thread.
+class JobSystem {
+  public:
+    explicit JobSystem(uint32_t workerCount);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    uint32_t GetWorkerCount() const { return static_cast<uint32_t>(m_workers.size()); }
+
+    void Submit(std::function<void()> fn, JobCounter* counter = nullptr);
+    // For long jobs that nothing in the frame waits on, such as asset imports. Only idle workers
+    // and RunPendingJob pick them up, never Wait, so a frame waiting on its own jobs is not held
+    // up by one. A system without workers runs them right away on the calling thread.
+    void SubmitBackground(std::function<void()> fn, JobCounter* counter = nullptr);
+    // Runs queued jobs on the calling thread until counter reaches zero.
+    void Wait(const JobCounter& counter);
+    // Runs one queued job on the calling thread, if there is any. Lets the main thread help out
+    // while it has nothing else to do, without waiting on anything in particular.
+    bool RunPendingJob();
+
+    // Runs fn(i) for every i in [0, count), in batches of at least grainSize indices, and
+    // returns once all of them finished. The calling thread takes part.
+    void ParallelFor(uint32_t count,
+                     const std::function<void(uint32_t)>& fn,
+                     uint32_t grainSize = 1);
+
+    // Starts the tasks of graph and returns; counter reaches zero once all of them finished.
+    // graph must outlive the run.
+    void RunAsync(TaskGraph& graph, JobCounter& counter);
+    void Run(TaskGraph& graph);
+
+  private:
+    struct Job {
+        std::function<void()> fn;
+        JobCounter* counter;
+    };
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    // Batches per thread a ParallelFor is split into, so threads that finish early can steal.
+    static constexpr uint32_t kBatchesPerThread = 4;
+
+    void WorkerLoop(uint32_t queueIndex);
+    // Index of the calling thread's deque.
+    uint32_t GetQueueIndex() const;
+    void Push(Job job);
+    void WakeWorkers(uint32_t jobCount);
+    bool TryRunJob(uint32_t queueIndex);
+    bool TryRunBackgroundJob();
+    static void RunJob(Job& job);
+    void RunTask(TaskGraph& graph, TaskGraph::TaskId task, JobCounter* counter);
+
+    // Entry 0 is shared by non-worker threads, entry i + 1 belongs to worker i.
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    std::vector<std::jthread> m_workers;
+    // First in, first out; shared by all threads.
+    WorkerQueue m_backgroundQueue;
+
+    // Jobs in all deques and in m_backgroundQueue; sleeping workers wake up when either becomes
+    // non-zero.
+    std::atomic<uint32_t> m_queuedJobs = 0;
+    std::atomic<uint32_t> m_queuedBackgroundJobs = 0;
+    std::atomic<uint32_t> m_sleepingWorkers = 0;
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wakeWorkers;
+    bool m_stopping = false;
+};
+}  // namespace core::util
@@ -0,0 +1,96 @@
+#include "MappedFile.h"
+#include <format>
+#include <utility>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+std::expected<core::util::MappedFile, core::Error> core::util::MappedFile::Open(
+    const std::filesystem::path& filepath) {
+    const std::string filename = filepath.string();
+#if defined(_WIN32)
+    HANDLE file = CreateFileW(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return std::unexpected(Error::IO(std::format("Failed to open: {}.", filename)));
+    }
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return std::unexpected(Error::IO(std::format("Failed to read: {}.", filename)));
+    }
+    const auto size = static_cast<size_t>(fileSize.QuadPart);
+    if (size == 0) {
+        CloseHandle(file);
+        return MappedFile();
+    }
+    // The view keeps the mapping alive, so both handles can be closed right away.
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) {
+        return std::unexpected(Error::IO(std::format("Failed to map: {}.", filename)));
+    }
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (data == nullptr) {
+        return std::unexpected(Error::IO(std::format("Failed to map: {}.", filename)));
+    }
+#else
+    const int file = open(filename.c_str(), O_RDONLY);
+    if (file < 0) {
+        return std::unexpected(Error::IO(std::format("Failed to open: {}.", filename)));
+    }
+    struct stat fileStat {};
+    if (fstat(file, &fileStat) != 0) {
+        close(file);
+        return std::unexpected(Error::IO(std::format("Failed to read: {}.", filename)));
+    }
+    const auto size = static_cast<size_t>(fileStat.st_size);
+    if (size == 0) {
+        close(file);
+        return MappedFile();
+    }
+    // The mapping keeps its own reference to the file.
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (data == MAP_FAILED) {
+        return std::unexpected(Error::IO(std::format("Failed to map: {}.", filename)));
+    }
+#endif
+    return MappedFile(static_cast<const uint8_t*>(data), size);
+}
+
+core::util::MappedFile::~MappedFile() {
+    Unmap();
+}
+
+core::util::MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)) {}
+
+core::util::MappedFile& core::util::MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Unmap();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+    }
+    return *this;
+}
+
+void core::util::MappedFile::Unmap() {
+    if (m_data == nullptr) {
+        return;
+    }
+#if defined(_WIN32)
+    UnmapViewOfFile(m_data);
+#else
+    munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <span>
+
+#include "Common.h"
+
+namespace core::util {
+
+// A file mapped read-only into memory. The pages are read in on first access and shared with
+// the OS file cache, so nothing is copied up front. Moving keeps the mapped address.
+class MappedFile {
+  public:
+    static std::expected<MappedFile, Error> Open(const std::filesystem::path& filepath);
+
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::span<const uint8_t> GetBytes() const { return {m_data, m_size}; }
+
+  private:
+    MappedFile(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+    void Unmap();
+
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+};
+}  // namespace core::util
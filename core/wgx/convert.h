@@ -7,6 +7,8 @@ inline size_t GetUnitSize(wgpu::TextureFormat format) {
     constexpr size_t kOneBytes = sizeof(char);
     constexpr size_t kTwoBytes = 2 * kOneBytes;
     constexpr size_t kFourBytes = 4 * kOneBytes;
+    constexpr size_t kEightBytes = 8 * kOneBytes;
+    constexpr size_t kSixteenBytes = 16 * kOneBytes;
 
     switch (format) {
         case wgpu::TextureFormat::Undefined:
@@ -47,39 +49,28 @@ inline size_t GetUnitSize(wgpu::TextureFormat format) {
         case wgpu::TextureFormat::RGB9E5Ufloat:
             return kFourBytes;
         case wgpu::TextureFormat::RG32Float:
-            break;
         case wgpu::TextureFormat::RG32Uint:
-            break;
         case wgpu::TextureFormat::RG32Sint:
-            break;
         case wgpu::TextureFormat::RGBA16Unorm:
-            break;
         case wgpu::TextureFormat::RGBA16Snorm:
-            break;
         case wgpu::TextureFormat::RGBA16Uint:
-            break;
         case wgpu::TextureFormat::RGBA16Sint:
-            break;
         case wgpu::TextureFormat::RGBA16Float:
-            break;
+            return kEightBytes;
         case wgpu::TextureFormat::RGBA32Float:
-            break;
         case wgpu::TextureFormat::RGBA32Uint:
-            break;
         case wgpu::TextureFormat::RGBA32Sint:
-            break;
+            return kSixteenBytes;
         case wgpu::TextureFormat::Stencil8:
-            break;
+            return kOneBytes;
         case wgpu::TextureFormat::Depth16Unorm:
-            break;
+            return kTwoBytes;
         case wgpu::TextureFormat::Depth24Plus:
-            break;
         case wgpu::TextureFormat::Depth24PlusStencil8:
-            break;
         case wgpu::TextureFormat::Depth32Float:
-            break;
+            return kFourBytes;
         case wgpu::TextureFormat::Depth32FloatStencil8:
-            break;
+            return kEightBytes;
         case wgpu::TextureFormat::BC1RGBAUnorm:
             break;
         case wgpu::TextureFormat::BC1RGBAUnormSrgb:
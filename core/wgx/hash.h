@@ -82,4 +82,27 @@ inline std::size_t Hash(const wgpu::DepthStencilState& s) {
     return seed;
 }
 
+// NOTE: label is not part of the identity of a view.
+inline bool Equals(const wgpu::TextureViewDescriptor& a, const wgpu::TextureViewDescriptor& b) {
+    return a.format == b.format && a.dimension == b.dimension &&
+           a.baseMipLevel == b.baseMipLevel && a.mipLevelCount == b.mipLevelCount &&
+           a.baseArrayLayer == b.baseArrayLayer && a.arrayLayerCount == b.arrayLayerCount &&
+           a.aspect == b.aspect && a.usage == b.usage;
+}
+
+inline std::size_t Hash(const wgpu::TextureViewDescriptor& s) {
+    std::size_t seed = 0;
+
+    hash_combine(seed, std::hash<int>{}(static_cast<int>(s.format)));
+    hash_combine(seed, std::hash<int>{}(static_cast<int>(s.dimension)));
+    hash_combine(seed, std::hash<uint32_t>{}(s.baseMipLevel));
+    hash_combine(seed, std::hash<uint32_t>{}(s.mipLevelCount));
+    hash_combine(seed, std::hash<uint32_t>{}(s.baseArrayLayer));
+    hash_combine(seed, std::hash<uint32_t>{}(s.arrayLayerCount));
+    hash_combine(seed, std::hash<int>{}(static_cast<int>(s.aspect)));
+    hash_combine(seed, std::hash<uint64_t>{}(static_cast<uint64_t>(s.usage)));
+
+    return seed;
+}
+
 }  // namespace wgx
\ No newline at end of file